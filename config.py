@@ -72,6 +72,20 @@ def can_build(env, platform):
     return True
 
 
+def get_opts(platform):
+    from SCons.Variables import BoolVariable
+
+    return [
+        # GDScript VM instrumentation (modules/goblin/modules/gdscript/gdscript_vm_stats.h).
+        # Defines GDSCRIPT_VM_STATS; off = hooks compile to nothing.
+        BoolVariable(
+            "gdscript_vm_stats",
+            "Count executed GDScript opcodes, opcode pairs and call-site receiver types (profiling builds only)",
+            False,
+        ),
+    ]
+
+
 def configure(env):
     """
     SURGICAL ENVIRONMENT INTERCEPTION
@@ -269,6 +283,10 @@ def configure(env):
 
     env.Append(CPPDEFINES=["GOBLIN_ENGINE"])
 
+    if env["gdscript_vm_stats"]:
+        env.Append(CPPDEFINES=["GDSCRIPT_VM_STATS"])
+        print("Goblin: GDScript VM stats instrumentation enabled (gdscript_vm_stats=yes)")
+
     # ===================================================================
     # EDITOR SPLASH — upstream 4.7 removed it (commit c283fce698:
     # "Remove editor splash screen with sponsors logo"). SConstruct:283
@@ -301,7 +319,13 @@ def configure(env):
 
 
 def get_doc_classes():
-    return []
+    return [
+        "TweenBatch",
+        "ProcessCadence",
+        "ProcessGroupScheduler",
+        "SceneTreeGroupIterator",
+        "SpatialGroupIndex",
+    ]
 
 
 def get_doc_path():
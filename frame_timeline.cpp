@@ -0,0 +1,207 @@
+/**************************************************************************/
+/*  frame_timeline.cpp                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                            GOBLIN ENGINE                               */
+/**************************************************************************/
+
+#include "frame_timeline.h"
+
+#include "core/config/project_settings.h"
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+
+void FrameTimeline::configure() {
+	bool enabled = GLOBAL_DEF_RST("debug/settings/timeline/enabled", false);
+	output_path = GLOBAL_DEF_RST("debug/settings/timeline/output_path", "user://timeline.json");
+	first_frame = (int)GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "debug/settings/timeline/first_frame", PROPERTY_HINT_RANGE, "0,1000000,1,or_greater"), 0);
+	frame_count = (int)GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "debug/settings/timeline/frame_count", PROPERTY_HINT_RANGE, "0,100000,1,or_greater"), 0);
+	const int events = GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "debug/settings/timeline/events_per_thread", PROPERTY_HINT_RANGE, "1024,16777216,1"), 1 << 16);
+	events_per_thread = next_power_of_2((uint32_t)MAX(1024, events));
+
+	// Server and play-test builds can be switched on without re-exporting:
+	// `game --headless ++ --timeline=<path> --timeline-frames=<first>[:<count>]`.
+	for (const String &arg : OS::get_singleton()->get_cmdline_user_args()) {
+		if (arg == "--timeline") {
+			enabled = true;
+		} else if (arg.begins_with("--timeline=")) {
+			enabled = true;
+			output_path = arg.substr(arg.find_char('=') + 1);
+		} else if (arg.begins_with("--timeline-frames=")) {
+			enabled = true;
+			const String range = arg.get_slicec('=', 1);
+			first_frame = MAX(0, range.get_slicec(':', 0).to_int());
+			frame_count = range.contains_char(':') ? MAX(0, range.get_slicec(':', 1).to_int()) : 1;
+		}
+	}
+
+	armed = enabled;
+	if (armed && first_frame == 0) {
+		_start();
+	}
+}
+
+FrameTimeline::ThreadBuffer *FrameTimeline::_register_thread() {
+	ThreadBuffer *buffer = memnew(ThreadBuffer);
+	buffer->events.resize(events_per_thread);
+	buffer->index = buffer_count.fetch_add(1);
+	buffer->thread_id = Thread::get_caller_id();
+	buffer->main_thread = Thread::is_main_thread();
+	buffer->generation = generation.load();
+
+	// Lock-free push; the list is only read once recording has stopped.
+	ThreadBuffer *top = buffers.load();
+	do {
+		buffer->next = top;
+	} while (!buffers.compare_exchange_weak(top, buffer));
+
+	thread_buffer = buffer;
+	return buffer;
+}
+
+void FrameTimeline::_record(char p_phase, const char *p_label, const StringName &p_name, const StringName &p_detail) {
+	ThreadBuffer *buffer = thread_buffer;
+	if (unlikely(buffer == nullptr || buffer->generation != generation.load(std::memory_order_relaxed))) {
+		if (!is_recording()) {
+			return;
+		}
+		buffer = _register_thread();
+	}
+
+	// Pairs with `_stop()` and `finish()`: either the stop (or the new generation) is seen
+	// here, or they wait for this write.
+	buffer->writing.store(true);
+	if (recording.load() && buffer->generation == generation.load()) {
+		Event &event = buffer->events[buffer->head & (buffer->events.size() - 1)];
+		event.usec = OS::get_singleton()->get_ticks_usec();
+		event.label = p_label;
+		event.name = p_name;
+		event.detail = p_detail;
+		event.phase = p_phase;
+		buffer->head++;
+	}
+	buffer->writing.store(false, std::memory_order_release);
+}
+
+void FrameTimeline::_start() {
+	start_usec = OS::get_singleton()->get_ticks_usec();
+	recording.store(true);
+	instant("Frame", StringName(vformat("Frame %d", frame)));
+}
+
+void FrameTimeline::_stop() {
+	recording.store(false);
+	for (ThreadBuffer *buffer = buffers.load(); buffer != nullptr; buffer = buffer->next) {
+		while (buffer->writing.load(std::memory_order_acquire)) {
+			Thread::yield();
+		}
+	}
+}
+
+void FrameTimeline::frame_boundary() {
+	if (!armed) {
+		return;
+	}
+	frame++;
+
+	if (!is_recording()) {
+		if (frame == first_frame) {
+			_start();
+		}
+		return;
+	}
+
+	if (frame_count > 0 && frame >= first_frame + frame_count) {
+		_stop();
+		armed = false;
+		if (save(output_path) == OK) {
+			print_line(vformat("Timeline: frames %d-%d written to \"%s\".", first_frame, frame - 1, output_path));
+		}
+		return;
+	}
+	instant("Frame", StringName(vformat("Frame %d", frame)));
+}
+
+Error FrameTimeline::save(const String &p_path) {
+	ERR_FAIL_COND_V_MSG(is_recording(), ERR_BUSY, "Timeline: Can't save while recording.");
+
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(f.is_null(), err, "Timeline: Can't write " + p_path);
+
+	const int pid = OS::get_singleton()->get_process_id();
+	f->store_string("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	f->store_string(vformat("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":0,\"args\":{\"name\":\"%s\"}}", pid, OS::get_singleton()->get_executable_path().get_file().json_escape()));
+
+	for (const ThreadBuffer *buffer = buffers.load(); buffer != nullptr; buffer = buffer->next) {
+		const String thread_name = buffer->main_thread ? String("Main Thread") : vformat("Thread %d", buffer->thread_id);
+		f->store_string(vformat(",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":\"%s\"}}", pid, buffer->index, thread_name));
+		if (buffer->main_thread) {
+			f->store_string(vformat(",\n{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"sort_index\":-1}}", pid, buffer->index));
+		}
+
+		const uint64_t size = buffer->events.size();
+		const uint64_t from = buffer->head > size ? buffer->head - size : 0;
+		// A wrapped ring or a range that starts mid-span leaves ends without a begin; drop them,
+		// and close spans still open at the end of the range at the last timestamp.
+		uint32_t depth = 0;
+		uint64_t last_usec = start_usec;
+		for (uint64_t i = from; i < buffer->head; i++) {
+			const Event &event = buffer->events[i & (size - 1)];
+			const uint64_t ts = event.usec > start_usec ? event.usec - start_usec : 0;
+			last_usec = MAX(last_usec, event.usec);
+
+			if (event.phase == 'E') {
+				if (depth == 0) {
+					continue;
+				}
+				depth--;
+				f->store_string(vformat(",\n{\"ph\":\"E\",\"pid\":%d,\"tid\":%d,\"ts\":%d}", pid, buffer->index, ts));
+				continue;
+			}
+
+			const String name = event.name == StringName() ? String(event.label) : String(event.name);
+			String line = vformat(",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%s\",\"pid\":%d,\"tid\":%d,\"ts\":%d", name.json_escape(), event.label, String::chr(event.phase), pid, buffer->index, ts);
+			if (event.phase == 'i') {
+				line += ",\"s\":\"p\"";
+			}
+			if (event.detail != StringName()) {
+				line += vformat(",\"args\":{\"detail\":\"%s\"}", String(event.detail).json_escape());
+			}
+			f->store_string(line + "}");
+			depth += event.phase == 'B';
+		}
+		for (; depth > 0; depth--) {
+			f->store_string(vformat(",\n{\"ph\":\"E\",\"pid\":%d,\"tid\":%d,\"ts\":%d}", pid, buffer->index, last_usec - start_usec));
+		}
+	}
+
+	f->store_string("\n]}\n");
+	return OK;
+}
+
+void FrameTimeline::finish() {
+	if (is_recording()) {
+		_stop();
+		if (save(output_path) == OK) {
+			print_line(vformat("Timeline: frames %d-%d written to \"%s\".", first_frame, frame, output_path));
+		}
+	}
+	armed = false;
+
+	// Buffers of this generation are now stale for every thread; wait out writes that
+	// started before, then free the events (and their names) of all the buffers.
+	generation.fetch_add(1);
+	_stop();
+	ThreadBuffer *buffer = buffers.exchange(nullptr);
+	while (buffer != nullptr) {
+		ThreadBuffer *next = buffer->next;
+		buffer->events.reset();
+		buffer->head = 0;
+		buffer->next = retired;
+		retired = buffer;
+		buffer = next;
+	}
+	thread_buffer = nullptr;
+}
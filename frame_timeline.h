@@ -0,0 +1,110 @@
+/**************************************************************************/
+/*  frame_timeline.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                            GOBLIN ENGINE                               */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/string/string_name.h"
+#include "core/string/ustring.h"
+#include "core/templates/local_vector.h"
+
+#include <atomic>
+
+// Frame timeline capture in Chrome trace-event JSON (chrome://tracing, ui.perfetto.dev).
+//
+// Instrumented spans (`FrameTimelineScope`) record begin/end events into a ring buffer
+// owned by the calling thread: no locks and no allocation on the hot path, the oldest
+// events are overwritten when a thread's buffer is full. Recording covers a range of
+// frames (counted at the start of each `SceneTree::process`) and the trace is written when
+// the range ends, or at shutdown.
+//
+// Enabled via `debug/settings/timeline/enabled` or the `--timeline[=<path>]` user argument
+// (after `++`), range via `--timeline-frames=<first>[:<count>]`. Nothing here depends on a
+// display or the editor, so it works in `--headless` runs and exported builds.
+class FrameTimeline {
+	struct Event {
+		uint64_t usec = 0;
+		const char *label = nullptr; // Span kind, a string literal. Also the name if `name` is empty.
+		StringName name;
+		StringName detail;
+		char phase = 'B'; // Trace-event phase: 'B'egin, 'E'nd, 'i'nstant.
+	};
+
+	struct ThreadBuffer {
+		LocalVector<Event> events; // Power-of-two ring, written by the owning thread only.
+		uint64_t head = 0;
+		uint32_t index = 0; // Small sequential id used as the trace `tid`.
+		uint64_t thread_id = 0;
+		bool main_thread = false;
+		uint32_t generation = 0; // Capture session the buffer belongs to.
+		std::atomic<bool> writing = false;
+		ThreadBuffer *next = nullptr;
+	};
+
+	static inline std::atomic<bool> recording = false;
+	static inline std::atomic<ThreadBuffer *> buffers = nullptr;
+	static inline std::atomic<uint32_t> buffer_count = 0;
+	// Bumped by `finish()`. A thread's buffer from an older generation is left alone, and the
+	// thread registers a new one.
+	static inline std::atomic<uint32_t> generation = 0;
+	static inline thread_local ThreadBuffer *thread_buffer = nullptr;
+	// Buffers released by `finish()`. Their events are freed, but other threads can still
+	// point to them from `thread_buffer`, so the headers are kept until exit.
+	static inline ThreadBuffer *retired = nullptr;
+
+	// Configuration and frame bookkeeping, main thread only.
+	static inline bool armed = false;
+	static inline String output_path;
+	static inline uint64_t first_frame = 0;
+	static inline uint64_t frame_count = 0; // 0 = until shutdown.
+	static inline uint32_t events_per_thread = 1 << 16;
+	static inline uint64_t frame = 0;
+	static inline uint64_t start_usec = 0;
+
+	static ThreadBuffer *_register_thread();
+	static void _record(char p_phase, const char *p_label, const StringName &p_name, const StringName &p_detail);
+	static void _start();
+	static void _stop();
+
+public:
+	// Reads the settings and command line, and starts recording right away if the range
+	// begins at frame 0.
+	static void configure();
+	// Called by `SceneTree::process()` before each idle frame. Starts and ends the capture range.
+	static void frame_boundary();
+	// Stops and writes the trace if a capture is still running, then releases the events.
+	// Spans still open on other threads are safe to end afterwards; they aren't recorded.
+	static void finish();
+
+	static Error save(const String &p_path);
+
+	_FORCE_INLINE_ static bool is_recording() { return recording.load(std::memory_order_relaxed); }
+
+	static void begin(const char *p_label, const StringName &p_name = StringName(), const StringName &p_detail = StringName()) { _record('B', p_label, p_name, p_detail); }
+	static void end() { _record('E', nullptr, StringName(), StringName()); }
+	static void instant(const char *p_label, const StringName &p_name = StringName()) { _record('i', p_label, p_name, StringName()); }
+};
+
+// Records a span for the current scope while a capture is running. Costs one relaxed load
+// when the timeline is off.
+class FrameTimelineScope {
+	bool recorded = false;
+
+public:
+	_FORCE_INLINE_ explicit FrameTimelineScope(const char *p_label, const StringName &p_name = StringName(), const StringName &p_detail = StringName()) {
+		if (unlikely(FrameTimeline::is_recording())) {
+			recorded = true;
+			FrameTimeline::begin(p_label, p_name, p_detail);
+		}
+	}
+	_FORCE_INLINE_ ~FrameTimelineScope() {
+		if (unlikely(recorded)) {
+			FrameTimeline::end();
+		}
+	}
+};
+
+#define FRAME_TIMELINE_SCOPE(m_label) FrameTimelineScope _frame_timeline_scope(m_label)
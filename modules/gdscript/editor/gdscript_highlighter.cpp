@@ -35,11 +35,12 @@
 
 #include "core/config/project_settings.h"
 #include "core/core_constants.h"
+#include "core/object/callable_mp.h"
 #include "core/object/class_db.h"
 #include "editor/settings/editor_settings.h"
 #include "scene/gui/text_edit.h"
 
-Dictionary GDScriptSyntaxHighlighter::_get_line_syntax_highlighting_impl(int p_line) {
+Dictionary GDScriptSyntaxHighlighter::_highlight_line(const String &p_str, int p_region_in, int &r_region_out) {
 	Dictionary color_map;
 
 	Type next_type = NONE;
@@ -79,28 +80,15 @@ Dictionary GDScriptSyntaxHighlighter::_get_line_syntax_highlighting_impl(int p_l
 	Color keyword_color;
 	Color color;
 
-	color_region_cache[p_line] = -1;
-	int in_region = -1;
-	if (p_line != 0) {
-		int prev_region_line = p_line - 1;
-		while (prev_region_line > 0 && !color_region_cache.has(prev_region_line)) {
-			prev_region_line--;
-		}
-		for (int i = prev_region_line; i < p_line - 1; i++) {
-			get_line_syntax_highlighting(i);
-		}
-		if (!color_region_cache.has(p_line - 1)) {
-			get_line_syntax_highlighting(p_line - 1);
-		}
-		in_region = color_region_cache[p_line - 1];
-	}
+	r_region_out = -1;
+	int in_region = p_region_in;
 
-	const String &str = text_edit->get_line_with_ime(p_line);
+	const String &str = p_str;
 	const int line_length = str.length();
 	Color prev_color;
 
 	if (in_region != -1 && line_length == 0) {
-		color_region_cache[p_line] = in_region;
+		r_region_out = in_region;
 	}
 	for (int j = 0; j < line_length; j++) {
 		Dictionary highlighter_info;
@@ -184,7 +172,7 @@ Dictionary GDScriptSyntaxHighlighter::_get_line_syntax_highlighting_impl(int p_l
 
 							j = line_length;
 							if (!color_regions[c].line_only) {
-								color_region_cache[p_line] = c;
+								r_region_out = c;
 							}
 						}
 						break;
@@ -349,7 +337,7 @@ Dictionary GDScriptSyntaxHighlighter::_get_line_syntax_highlighting_impl(int p_l
 						}
 						j = from + (end_key_length - 1);
 						if (region_end_index == -1) {
-							color_region_cache[p_line] = in_region;
+							r_region_out = in_region;
 						}
 					}
 
@@ -740,6 +728,83 @@ Dictionary GDScriptSyntaxHighlighter::_get_line_syntax_highlighting_impl(int p_l
 	return color_map;
 }
 
+void GDScriptSyntaxHighlighter::_update_line_state(int p_line, int p_region_in) {
+	LineState &state = line_states[p_line];
+	const String &str = text_edit->get_line_with_ime(p_line);
+	if (state.valid && state.region_in == p_region_in && state.text == str) {
+		return;
+	}
+	state.text = str;
+	state.region_in = p_region_in;
+	state.color_map = _highlight_line(str, p_region_in, state.region_out);
+	state.valid = true;
+}
+
+void GDScriptSyntaxHighlighter::_on_lines_edited_from(int p_from_line, int p_to_line) {
+	// Keep the states aligned with their lines, so lines moved by an edit are not highlighted again.
+	const int from = MIN(p_from_line, p_to_line);
+	const int old_size = line_states.size();
+	if (from >= old_size) {
+		return;
+	}
+	if (p_to_line > p_from_line) {
+		const int count = p_to_line - p_from_line;
+		line_states.resize(old_size + count);
+		for (int i = old_size - 1; i > from; i--) {
+			line_states[i + count] = std::move(line_states[i]);
+		}
+		for (int i = from + 1; i <= from + count; i++) {
+			line_states[i] = LineState();
+		}
+	} else if (p_from_line > p_to_line) {
+		const int count = MIN(p_from_line - p_to_line, old_size - from - 1);
+		for (int i = from + 1; i + count < old_size; i++) {
+			line_states[i] = std::move(line_states[i + count]);
+		}
+		line_states.resize(old_size - count);
+	}
+	line_states[from].valid = false;
+	regions_valid_to = MIN(regions_valid_to, from);
+}
+
+Dictionary GDScriptSyntaxHighlighter::_get_line_syntax_highlighting_impl(int p_line) {
+	if (text_edit->get_instance_id() != tracked_text_edit) {
+		if (Object *previous = ObjectDB::get_instance(tracked_text_edit)) {
+			previous->disconnect(SNAME("lines_edited_from"), callable_mp(this, &GDScriptSyntaxHighlighter::_on_lines_edited_from));
+		}
+		tracked_text_edit = text_edit->get_instance_id();
+		text_edit->connect(SNAME("lines_edited_from"), callable_mp(this, &GDScriptSyntaxHighlighter::_on_lines_edited_from));
+		line_states.clear();
+		regions_valid_to = 0;
+	}
+	const int line_count = text_edit->get_line_count();
+	ERR_FAIL_INDEX_V(p_line, line_count, Dictionary());
+	if ((int)line_states.size() != line_count) {
+		line_states.resize(line_count);
+		regions_valid_to = MIN(regions_valid_to, line_count);
+	}
+
+	// Bring the region state at the end of the previous line up to date. After an edit, lines
+	// are highlighted again only while their start region differs from the cached one; once
+	// the region state converges, the remaining lines just compare their text.
+	for (int i = regions_valid_to; i < p_line; i++) {
+		_update_line_state(i, i > 0 ? line_states[i - 1].region_out : -1);
+	}
+	regions_valid_to = MAX(regions_valid_to, p_line);
+
+	LineState &state = line_states[p_line];
+	const bool was_valid = state.valid;
+	const int previous_region_out = state.region_out;
+	_update_line_state(p_line, p_line > 0 ? line_states[p_line - 1].region_out : -1);
+	if (regions_valid_to > p_line + 1 && (!was_valid || state.region_out != previous_region_out)) {
+		// The line changed without an edit signal (IME preview) and opens or closes a region.
+		regions_valid_to = p_line + 1;
+	} else {
+		regions_valid_to = MAX(regions_valid_to, p_line + 1);
+	}
+	return state.color_map;
+}
+
 String GDScriptSyntaxHighlighter::_get_name() const {
 	return "GDScript";
 }
@@ -756,7 +821,8 @@ void GDScriptSyntaxHighlighter::_update_cache() {
 	member_keywords.clear();
 	global_functions.clear();
 	color_regions.clear();
-	color_region_cache.clear();
+	line_states.clear();
+	regions_valid_to = 0;
 
 	font_color = text_edit->get_theme_color(SceneStringName(font_color));
 	symbol_color = EDITOR_GET("text_editor/theme/highlighting/symbol_color");
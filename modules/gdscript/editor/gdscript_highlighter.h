@@ -32,6 +32,8 @@
 
 #include "editor/script/syntax_highlighters.h"
 
+#include "core/templates/local_vector.h"
+
 class GDScriptSyntaxHighlighter : public EditorSyntaxHighlighter {
 	GDCLASS(GDScriptSyntaxHighlighter, EditorSyntaxHighlighter)
 
@@ -55,7 +57,20 @@ private:
 		bool is_comment = false; // `TYPE_COMMENT` or `TYPE_CODE_REGION`.
 	};
 	Vector<ColorRegion> color_regions;
-	HashMap<int, int> color_region_cache;
+
+	// Goblin: highlighting result per line with the color region open at its start and end
+	// (-1 for none). A line's colors only depend on its text and start region, so states are
+	// reused until one of those changes; see `_get_line_syntax_highlighting_impl()`.
+	struct LineState {
+		String text;
+		Dictionary color_map;
+		int region_in = -1;
+		int region_out = -1;
+		bool valid = false;
+	};
+	LocalVector<LineState> line_states;
+	int regions_valid_to = 0; // States of the lines before this one are known to be current.
+	ObjectID tracked_text_edit;
 
 	HashMap<StringName, Color> class_names;
 	HashMap<StringName, Color> reserved_keywords;
@@ -107,6 +122,10 @@ private:
 
 	void add_color_region(ColorRegion::Type p_type, const String &p_start_key, const String &p_end_key, const Color &p_color, bool p_line_only = false, bool p_r_prefix = false);
 
+	Dictionary _highlight_line(const String &p_str, int p_region_in, int &r_region_out);
+	void _update_line_state(int p_line, int p_region_in);
+	void _on_lines_edited_from(int p_from_line, int p_to_line);
+
 public:
 	virtual void _update_cache() override;
 	virtual Dictionary _get_line_syntax_highlighting_impl(int p_line) override;
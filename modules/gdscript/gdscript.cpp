@@ -35,7 +35,10 @@
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
 #include "gdscript_rpc_callable.h"
+#include "gdscript_sampling_profiler.h"
+#include "gdscript_schema_index.h"
 #include "gdscript_tokenizer_buffer.h"
+#include "gdscript_vm_stats.h"
 #include "gdscript_warning.h"
 
 #include "core/io/resource_loader.h"
@@ -53,7 +56,6 @@
 #include "core/config/engine.h"
 #include "core/config/project_settings.h"
 #include "core/core_constants.h"
-#include "core/io/config_file.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
 #include "scene/resources/packed_scene.h"
@@ -85,6 +87,53 @@ static bool _register_script_schemas(const GDScriptParser::ClassNode *p_class, c
 	return changed;
 }
 
+// Goblin: names of the top-level `@schema const`s of a parsed class.
+static HashSet<StringName> _get_script_schema_names(const GDScriptParser::ClassNode *p_class) {
+	HashSet<StringName> names;
+	if (p_class == nullptr) {
+		return names;
+	}
+	for (int i = 0; i < p_class->members.size(); i++) {
+		const GDScriptParser::ClassNode::Member &member = p_class->members[i];
+		if (member.type == GDScriptParser::ClassNode::Member::CONSTANT && member.constant->identifier != nullptr && GDScriptParser::is_schema_constant(member.constant)) {
+			names.insert(member.constant->identifier->name);
+		}
+	}
+	return names;
+}
+
+// Goblin: store the analyzed datatype of every top-level `@schema const` in the
+// schema index, after the class has been analyzed. `p_source` is the source that was
+// parsed, empty for binary tokens.
+static void _publish_script_schemas(GDScriptParser &p_parser, const String &p_path, const String &p_source) {
+	const GDScriptParser::ClassNode *head = p_parser.get_tree();
+	if (head == nullptr) {
+		return;
+	}
+	GDScriptSchemaIndex *schema_index = GDScriptLanguage::get_singleton()->get_schema_index();
+	bool source_checked = false;
+	bool saved = true;
+	for (int i = 0; i < head->members.size(); i++) {
+		const GDScriptParser::ClassNode::Member &member = head->members[i];
+		if (member.type == GDScriptParser::ClassNode::Member::CONSTANT && member.constant->identifier != nullptr && member.constant->get_datatype().is_schema) {
+#ifdef TOOLS_ENABLED
+			// Unsaved editor changes: the file's modification time doesn't describe this source,
+			// so only the name is registered, and other scripts keep parsing the declaring one.
+			if (!source_checked) {
+				source_checked = true;
+				saved = p_source.is_empty() || FileAccess::get_file_as_string(p_path) == p_source;
+			}
+#endif
+			if (saved) {
+				schema_index->set_datatype(member.constant->identifier->name, p_path, member.constant->get_datatype(), GDScriptSchemaIndex::get_dependencies(&p_parser));
+			} else {
+				schema_index->set_datatype(member.constant->identifier->name, p_path, GDScriptParser::DataType(), Vector<String>());
+			}
+			GDScriptLanguage::get_singleton()->queue_schema_flush();
+		}
+	}
+}
+
 GDScriptNativeClass::GDScriptNativeClass(const StringName &p_name) {
 	name = p_name;
 }
@@ -611,6 +660,7 @@ bool GDScript::_update_exports(bool *r_err, bool p_recursive_call, PlaceHolderSc
 				}
 				valid = false; // to show error in the editor
 				base_cache->valid = false;
+				_invalidate_resolved_methods();
 				base_cache->inheriters_cache.clear(); // to prevent future stackoverflows
 				base_cache.unref();
 				base.unref();
@@ -830,6 +880,7 @@ Error GDScript::reload(bool p_keep_state) {
 #endif
 
 	valid = false;
+	_invalidate_resolved_methods();
 	GDScriptParser parser;
 	Error err;
 	if (!binary_tokens.is_empty()) {
@@ -861,10 +912,10 @@ Error GDScript::reload(bool p_keep_state) {
 		String reload_path = path.is_empty() ? get_path() : path;
 		if (!reload_path.is_empty()) {
 			GDScriptLanguage *gd_lang = GDScriptLanguage::get_singleton();
-			gd_lang->remove_schemas_by_path(reload_path);
-			if (_register_script_schemas(parser.get_tree(), reload_path)) {
-				gd_lang->save_schemas();
-			}
+			// Schemas still declared keep their entry (and compiled datatype, checked against
+			// the files), so reloading an unchanged script doesn't rewrite the index.
+			gd_lang->remove_schemas_by_path(reload_path, _get_script_schema_names(parser.get_tree()));
+			_register_script_schemas(parser.get_tree(), reload_path);
 		}
 	}
 
@@ -885,6 +936,15 @@ Error GDScript::reload(bool p_keep_state) {
 		return ERR_PARSE_ERROR;
 	}
 
+	// Goblin: record the analyzed schema datatypes so other scripts can resolve
+	// `Dictionary[Name]` from the index instead of parsing this one.
+	{
+		String reload_path = path.is_empty() ? get_path() : path;
+		if (reload_path.is_resource_file()) {
+			_publish_script_schemas(parser, reload_path, binary_tokens.is_empty() ? source : String());
+		}
+	}
+
 	can_run = ScriptServer::is_scripting_enabled() || parser.is_tool();
 
 	GDScriptCompiler compiler;
@@ -1472,6 +1532,7 @@ void GDScript::clear() {
 		return;
 	}
 	clearing = true;
+	_invalidate_resolved_methods();
 
 	RBSet<GDScriptFunction *> functions_to_clear;
 
@@ -1987,20 +2048,46 @@ void GDScriptInstance::_call_implicit_ready_recursively(GDScript *p_script) {
 	}
 }
 
+// Goblin: per-thread cache of resolved script methods for `callp()`, the path of every signal
+// emission to a script method (and of `call()`, deferred calls and engine callbacks). A hit
+// replaces the `member_functions` lookup in each script of the inheritance chain with one
+// probe. Entries are stamped with `GDScript::method_generation`, so they die with any compile,
+// reload or clear. Only found methods are cached: their name is a key of `member_functions`,
+// which keeps the `StringName` alive (and its address unique) while the stamp is current.
+struct GDScriptResolvedMethod {
+	const GDScript *script = nullptr;
+	const void *method = nullptr;
+	GDScriptFunction *function = nullptr;
+	uint32_t generation = 0;
+};
+
+static constexpr uint32_t RESOLVED_METHOD_CACHE_SIZE = 256;
+static thread_local GDScriptResolvedMethod resolved_method_cache[RESOLVED_METHOD_CACHE_SIZE];
+
 Variant GDScriptInstance::callp(const StringName &p_method, const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
 	GDScript *sptr = script.ptr();
 	if (unlikely(p_method == SceneStringName(_ready))) {
 		// Call implicit ready first, including for the super classes recursively.
 		_call_implicit_ready_recursively(sptr);
 	}
-	while (sptr) {
-		if (likely(sptr->valid)) {
-			HashMap<StringName, GDScriptFunction *>::Iterator E = sptr->member_functions.find(p_method);
+
+	const uint32_t generation = GDScript::method_generation.get();
+	GDScriptResolvedMethod &cached = resolved_method_cache[(p_method.hash() ^ (uint32_t)((uintptr_t)sptr >> 4)) & (RESOLVED_METHOD_CACHE_SIZE - 1)];
+	if (cached.script == sptr && cached.method == p_method.data_unique_pointer() && cached.generation == generation) {
+		return cached.function->call(this, p_args, p_argcount, r_error);
+	}
+
+	for (GDScript *current = sptr; current; current = current->base.ptr()) {
+		if (likely(current->valid)) {
+			HashMap<StringName, GDScriptFunction *>::Iterator E = current->member_functions.find(p_method);
 			if (E) {
+				cached.script = sptr;
+				cached.method = E->key.data_unique_pointer();
+				cached.function = E->value;
+				cached.generation = generation;
 				return E->value->call(this, p_args, p_argcount, r_error);
 			}
 		}
-		sptr = sptr->base.ptr();
 	}
 
 	r_error.error = Callable::CallError::CALL_ERROR_INVALID_METHOD;
@@ -2182,46 +2269,33 @@ Variant GDScriptLanguage::get_any_global_constant(const StringName &p_name) {
 }
 
 bool GDScriptLanguage::has_schema(const StringName &p_name) {
-	MutexLock lock(mutex);
-	load_schemas();
-	return schemas.has(p_name);
+	return get_schema_index()->has(p_name);
 }
 
 String GDScriptLanguage::get_schema_path(const StringName &p_name) {
-	MutexLock lock(mutex);
-	load_schemas();
-	return schemas.getptr(p_name) ? *schemas.getptr(p_name) : String();
+	return get_schema_index()->get_path(p_name);
 }
 
 void GDScriptLanguage::add_schema(const StringName &p_name, const String &p_path) {
-	MutexLock lock(mutex);
-	load_schemas();
-	const String *existing = schemas.getptr(p_name);
-	if (existing != nullptr && *existing == p_path) {
-		return; // Unchanged.
+	if (get_schema_index()->add(p_name, p_path)) {
+		queue_schema_flush();
 	}
-	schemas[p_name] = p_path;
 }
 
-void GDScriptLanguage::remove_schemas_by_path(const String &p_path) {
+void GDScriptLanguage::remove_schemas_by_path(const String &p_path, const HashSet<StringName> &p_keep) {
+	if (get_schema_index()->remove_by_path(p_path, p_keep)) {
+		queue_schema_flush();
+	}
+}
+
+GDScriptSchemaIndex *GDScriptLanguage::get_schema_index() {
 	MutexLock lock(mutex);
 	load_schemas();
-	Vector<StringName> to_erase;
-	for (const KeyValue<StringName, String> &E : schemas) {
-		if (E.value == p_path) {
-			to_erase.push_back(E.key);
-		}
-	}
-	for (const StringName &key : to_erase) {
-		schemas.erase(key);
-	}
-	if (!to_erase.is_empty()) {
-		save_schemas();
-	}
+	return schema_index;
 }
 
 String GDScriptLanguage::get_schema_cache_path() const {
-	return ProjectSettings::get_singleton()->get_project_data_path().path_join("goblin_schema_cache.cfg");
+	return GDScriptSchemaIndex::get_cache_path();
 }
 
 void GDScriptLanguage::load_schemas() {
@@ -2232,30 +2306,36 @@ void GDScriptLanguage::load_schemas() {
 	if (ProjectSettings::get_singleton() == nullptr) {
 		return;
 	}
-	ConfigFile cache;
-	if (cache.load(get_schema_cache_path()) != OK) {
-		return; // No cache yet.
-	}
-	if (!cache.has_section("schemas")) {
-		return;
-	}
-	Vector<String> keys = cache.get_section_keys("schemas");
-	for (const String &key : keys) {
-		schemas[StringName(key)] = cache.get_value("schemas", key, String());
+	Error err = schema_index->load(get_schema_cache_path());
+	if (err != OK && err != ERR_FILE_NOT_FOUND && err != ERR_FILE_CANT_OPEN) {
+		// An index from another version; the editor scan registers the schemas again.
+		print_verbose("GDScript: Ignoring schema index: " + get_schema_cache_path());
 	}
 }
 
-void GDScriptLanguage::save_schemas() {
+void GDScriptLanguage::queue_schema_flush() {
 	if (!Engine::get_singleton()->is_editor_hint()) {
 		return; // Exported games don't carry `.godot/`; registration is load-order based there.
 	}
-	ConfigFile cache;
-	for (const KeyValue<StringName, String> &E : schemas) {
-		cache.set_value("schemas", String(E.key), E.value);
+	MutexLock lock(mutex);
+	if (schema_flush_queued) {
+		return;
+	}
+	schema_flush_queued = true;
+	callable_mp(this, &GDScriptLanguage::flush_schemas).call_deferred();
+}
+
+void GDScriptLanguage::flush_schemas() {
+	{
+		MutexLock lock(mutex);
+		schema_flush_queued = false;
+	}
+	if (!Engine::get_singleton()->is_editor_hint() || !get_schema_index()->is_dirty()) {
+		return;
 	}
 	const String path = get_schema_cache_path();
 	DirAccess::make_dir_recursive_absolute(path.get_base_dir());
-	cache.save(path);
+	schema_index->save(path);
 }
 
 void GDScriptLanguage::remove_named_global_constant(const StringName &p_name) {
@@ -2295,6 +2375,10 @@ void GDScriptLanguage::init() {
 		_add_global(E.name, E.ptr);
 	}
 
+#ifdef GDSCRIPT_VM_STATS
+	GDScriptVMStats::init();
+#endif
+
 #ifdef TOOLS_ENABLED
 	if (Engine::get_singleton()->is_editor_hint()) {
 		GDExtensionManager::get_singleton()->connect("extension_loaded", callable_mp(this, &GDScriptLanguage::_extension_loaded));
@@ -2355,6 +2439,12 @@ void GDScriptLanguage::finish() {
 	}
 	finishing = true;
 
+	GDScriptSamplingProfiler::finish();
+	flush_schemas();
+#ifdef GDSCRIPT_VM_STATS
+	GDScriptVMStats::finish();
+#endif
+
 	// Clear the cache before parsing the script_list
 	GDScriptCache::clear();
 
@@ -2870,12 +2960,9 @@ String GDScriptLanguage::_get_global_class_name(const String &p_path, String *r_
 	}
 
 	if (has_schema_marker) {
-		if (_register_script_schemas(c, p_path)) {
-			// Goblin: persist the registry after processing schema-declaring files
-			// (class_name-style: the editor writes `global_script_class_cache.cfg` at scan
-			// completion; the language module writes its schema cache at the same point).
-			GDScriptLanguage::get_singleton()->save_schemas();
-		}
+		// Goblin: registrations during a scan are batched into one index write
+		// (`GDScriptLanguage::queue_schema_flush()`).
+		_register_script_schemas(c, p_path);
 	}
 
 	/* **WARNING**
@@ -2989,6 +3076,7 @@ GDScriptLanguage::CallLevel *GDScriptLanguage::_get_stack_level(uint32_t p_level
 GDScriptLanguage::GDScriptLanguage() {
 	ERR_FAIL_COND(singleton);
 	singleton = this;
+	schema_index = memnew(GDScriptSchemaIndex);
 	strings._init = StringName("_init");
 	strings._static_init = StringName("_static_init");
 	strings._notification = StringName("_notification");
@@ -3012,6 +3100,12 @@ GDScriptLanguage::GDScriptLanguage() {
 	track_call_stack = GLOBAL_DEF_RST("debug/settings/gdscript/always_track_call_stacks", false);
 	track_locals = GLOBAL_DEF_RST("debug/settings/gdscript/always_track_local_variables", false);
 
+	// Goblin: the sampling profiler reads the call stack and line opcodes, so it turns both on, also in release builds.
+	if (GDScriptSamplingProfiler::configure()) {
+		track_call_stack = true;
+		GDScriptSamplingProfiler::start();
+	}
+
 #ifdef DEBUG_ENABLED
 	track_call_stack = true;
 	track_locals = track_locals || EngineDebugger::is_active();
@@ -3044,6 +3138,7 @@ GDScriptLanguage::GDScriptLanguage() {
 }
 
 GDScriptLanguage::~GDScriptLanguage() {
+	memdelete(schema_index);
 	singleton = nullptr;
 }
 
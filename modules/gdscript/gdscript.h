@@ -37,6 +37,9 @@
 #include "core/doc_data.h"
 #include "core/object/script_language.h"
 #include "core/templates/rb_set.h"
+#include "core/templates/safe_refcount.h"
+
+class GDScriptSchemaIndex;
 
 class GDScriptNativeClass : public RefCounted {
 	GDCLASS(GDScriptNativeClass, RefCounted);
@@ -139,6 +142,11 @@ private:
 
 	void _recurse_replace_function_ptrs(const HashMap<GDScriptFunction *, GDScriptFunction *> &p_replacements) const;
 
+	// Goblin: bumped whenever any script's methods, base or validity may change (compile, reload,
+	// clear). Stamps the resolved-method cache of `GDScriptInstance::callp()`.
+	static inline SafeNumeric<uint32_t> method_generation{ 1 };
+	static void _invalidate_resolved_methods() { method_generation.increment(); }
+
 #ifdef TOOLS_ENABLED
 	// For static data storage during hot-reloading.
 	HashMap<StringName, MemberInfo> old_static_variables_indices;
@@ -457,6 +465,7 @@ class GDScriptLanguage : public ScriptLanguage {
 	friend class GDScriptFunction;
 
 	SelfList<GDScriptFunction>::List function_list;
+	friend class GDScriptSamplingProfiler;
 #ifdef DEBUG_ENABLED
 	bool profiling;
 	bool profile_native_calls;
@@ -465,12 +474,13 @@ class GDScriptLanguage : public ScriptLanguage {
 
 	HashMap<String, ObjectID> orphan_subclasses;
 
-	// Goblin: `@schema` registry (schema name -> declaring script path). The in-memory
-	// map is the source of truth for a session, rebuilt when script files are processed
-	// (editor class-name scan + script reload) and loaded from a persisted cache at first
-	// use (class_name-style, mirroring `res://.godot/global_script_class_cache.cfg`).
-	HashMap<StringName, String> schemas;
+	// Goblin: `@schema` registry (schema name -> declaring script path + compiled shape).
+	// The in-memory index is the source of truth for a session, updated when script files
+	// are processed (editor class-name scan, script reload, analysis) and loaded from the
+	// persisted index at first use (class_name-style, like `global_script_class_cache.cfg`).
+	GDScriptSchemaIndex *schema_index = nullptr;
 	bool schemas_loaded = false;
+	bool schema_flush_queued = false;
 	void load_schemas();
 
 #ifdef TOOLS_ENABLED
@@ -588,15 +598,20 @@ public:
 	Variant get_any_global_constant(const StringName &p_name);
 
 	// Goblin: global schema registry — `@schema const` names mapped to the script path
-	// that declares them. Populated at script reload time, during the editor's class-name
-	// scan, and from a persisted cache (`res://.godot/goblin_schema_cache.cfg`) so
-	// cross-file `Dictionary[Name]` works in cached editor sessions. Consumed by the
+	// that declares them and, once analyzed, their compiled datatype. Populated at script
+	// reload time, during the editor's class-name scan, and from a persisted index
+	// (`res://.godot/goblin_schema_index.bin`) so cross-file `Dictionary[Name]` works in
+	// cached editor sessions without parsing the declaring script. Consumed by the
 	// analyzer for cross-file `Dictionary[Name]`.
 	bool has_schema(const StringName &p_name);
 	String get_schema_path(const StringName &p_name);
 	void add_schema(const StringName &p_name, const String &p_path);
-	void remove_schemas_by_path(const String &p_path);
-	void save_schemas();
+	void remove_schemas_by_path(const String &p_path, const HashSet<StringName> &p_keep = HashSet<StringName>());
+	GDScriptSchemaIndex *get_schema_index();
+	// Registrations only touch memory; this schedules one write of the index for the
+	// next idle frame, so a scan or a batch of reloads results in a single flush.
+	void queue_schema_flush();
+	void flush_schemas();
 	String get_schema_cache_path() const;
 
 	_FORCE_INLINE_ static GDScriptLanguage *get_singleton() { return singleton; }
@@ -31,6 +31,7 @@
 #include "gdscript_analyzer.h"
 
 #include "gdscript.h"
+#include "gdscript_schema_index.h"
 #include "gdscript_utility_callable.h"
 #include "gdscript_utility_functions.h"
 
@@ -231,6 +232,31 @@ static GDScriptParser::DataType make_builtin_meta_type(Variant::Type p_type) {
 	return type;
 }
 
+// Goblin: element type -> native storage for `Packed[T]`. `NIL` if `T` has no packed array.
+static Variant::Type packed_array_type_for(const GDScriptParser::DataType &p_element_type) {
+	if (p_element_type.kind != GDScriptParser::DataType::BUILTIN) {
+		return Variant::NIL;
+	}
+	switch (p_element_type.builtin_type) {
+		case Variant::INT:
+			return Variant::PACKED_INT64_ARRAY;
+		case Variant::FLOAT:
+			return Variant::PACKED_FLOAT64_ARRAY;
+		case Variant::STRING:
+			return Variant::PACKED_STRING_ARRAY;
+		case Variant::VECTOR2:
+			return Variant::PACKED_VECTOR2_ARRAY;
+		case Variant::VECTOR3:
+			return Variant::PACKED_VECTOR3_ARRAY;
+		case Variant::VECTOR4:
+			return Variant::PACKED_VECTOR4_ARRAY;
+		case Variant::COLOR:
+			return Variant::PACKED_COLOR_ARRAY;
+		default:
+			return Variant::NIL;
+	}
+}
+
 static bool _member_is_private(const GDScriptParser::ClassNode::Member &p_member) {
 	// Read the annotation directly instead of the `is_private` flags: annotations are
 	// attached to the member at parse time, while the flags are only set once the
@@ -791,6 +817,23 @@ GDScriptParser::DataType GDScriptAnalyzer::resolve_datatype(GDScriptParser::Type
 			}
 			result.kind = GDScriptParser::DataType::BUILTIN;
 			result.builtin_type = Variant::NIL;
+		} else if (first == SNAME("Packed") && !p_type->container_types.is_empty()) {
+			// Goblin: `Packed[T]` — an array of `T` in native packed storage (one value per
+			// element instead of one `Variant`), typed as the matching `Packed*Array`.
+			if (p_type->container_types.size() != 1) {
+				push_error(R"(Packed arrays require exactly one element type.)", p_type);
+				return bad_type;
+			}
+			const GDScriptParser::DataType element_type = type_from_metatype(resolve_datatype(p_type->get_container_type_or_null(0)));
+			const Variant::Type packed_type = packed_array_type_for(element_type);
+			if (packed_type == Variant::NIL) {
+				push_error(vformat(R"(No packed storage for "%s". Packed arrays support "int", "float", "String", "Vector2", "Vector3", "Vector4" and "Color"; use "Array[%s]" instead.)", element_type.to_string(), element_type.to_string()), p_type->get_container_type_or_null(0));
+				return bad_type;
+			}
+			result.kind = GDScriptParser::DataType::BUILTIN;
+			result.builtin_type = packed_type;
+			p_type->set_datatype(result);
+			return result;
 		} else if (GDScriptParser::get_builtin_type(first) < Variant::VARIANT_MAX) {
 			// Built-in types.
 			const Variant::Type builtin_type = GDScriptParser::get_builtin_type(first);
@@ -982,30 +1025,40 @@ GDScriptParser::DataType GDScriptAnalyzer::resolve_datatype(GDScriptParser::Type
 
 	if (!result.is_set() && GDScriptLanguage::get_singleton()->has_schema(first)) {
 		// Goblin: global schema registry — `@schema const` declared in another script.
-		// Resolve the declaring script on demand and reuse its schema datatype.
-		const String schema_path = GDScriptLanguage::get_singleton()->get_schema_path(first);
+		// Use the compiled datatype from the schema index when it is current, otherwise
+		// resolve the declaring script on demand and reuse its schema datatype.
+		GDScriptSchemaIndex *schema_index = GDScriptLanguage::get_singleton()->get_schema_index();
+		const String schema_path = schema_index->get_path(first);
 		if (GDScript::is_canonically_equal_paths(parser->script_path, schema_path)) {
 			push_error(vformat(R"(Could not find schema "%s" in the current script.)", first), p_type);
 			return bad_type;
 		}
+		// Registers the dependency (reloads follow the declaring script) without parsing it.
 		Ref<GDScriptParserRef> ref = parser->get_depended_parser_for(schema_path);
-		if (ref.is_null() || ref->raise_status(GDScriptParserRef::INHERITANCE_SOLVED) != OK) {
-			push_error(vformat(R"(Could not parse script from "%s" (while resolving schema "%s").)", schema_path, first), p_type);
-			return bad_type;
-		}
-		GDScriptParser::ClassNode *schema_class = ref->get_parser()->head;
-		if (schema_class == nullptr || !schema_class->has_member(first)) {
-			push_error(vformat(R"(Schema "%s" was not found in "%s".)", first, schema_path), p_type);
-			return bad_type;
-		}
-		ref->get_analyzer()->resolve_class_member(schema_class, first, p_type);
-		result = schema_class->get_member(first).get_datatype();
-		if (result.is_schema) {
+		if (schema_index->get_datatype(first, result)) {
 			result.is_constant = false;
 			type_found = true;
 		} else {
-			push_error(vformat(R"(Constant "%s" is not a schema (it needs the "@schema" annotation).)", first), p_type);
-			return bad_type;
+			if (ref.is_null() || ref->raise_status(GDScriptParserRef::INHERITANCE_SOLVED) != OK) {
+				push_error(vformat(R"(Could not parse script from "%s" (while resolving schema "%s").)", schema_path, first), p_type);
+				return bad_type;
+			}
+			GDScriptParser::ClassNode *schema_class = ref->get_parser()->head;
+			if (schema_class == nullptr || !schema_class->has_member(first)) {
+				push_error(vformat(R"(Schema "%s" was not found in "%s".)", first, schema_path), p_type);
+				return bad_type;
+			}
+			ref->get_analyzer()->resolve_class_member(schema_class, first, p_type);
+			result = schema_class->get_member(first).get_datatype();
+			if (result.is_schema) {
+				schema_index->set_datatype(first, schema_path, result, GDScriptSchemaIndex::get_dependencies(ref->get_parser()));
+				GDScriptLanguage::get_singleton()->queue_schema_flush();
+				result.is_constant = false;
+				type_found = true;
+			} else {
+				push_error(vformat(R"(Constant "%s" is not a schema (it needs the "@schema" annotation).)", first), p_type);
+				return bad_type;
+			}
 		}
 	}
 
@@ -2452,6 +2505,7 @@ void GDScriptAnalyzer::resolve_if(GDScriptParser::IfNode *p_if) {
 
 void GDScriptAnalyzer::resolve_for(GDScriptParser::ForNode *p_for) {
 	GDScriptParser::DataType variable_type;
+	GDScriptParser::DataType value_type; // Goblin: `for key, value in dict`.
 	GDScriptParser::DataType list_type;
 
 	if (p_for->list) {
@@ -2481,7 +2535,21 @@ void GDScriptAnalyzer::resolve_for(GDScriptParser::ForNode *p_for) {
 			mark_node_unsafe(p_for->list);
 		}
 
-		if (is_range) {
+		if (p_for->value_variable) {
+			// Goblin: `for key, value in dict` only iterates dictionaries.
+			variable_type.kind = GDScriptParser::DataType::VARIANT;
+			value_type.kind = GDScriptParser::DataType::VARIANT;
+			if (list_type.is_variant() || list_type.is_union() || !list_type.is_hard_type()) {
+				mark_node_unsafe(p_for->list);
+			} else if (list_type.kind != GDScriptParser::DataType::BUILTIN || list_type.builtin_type != Variant::DICTIONARY) {
+				push_error(vformat(R"(Unable to iterate on key and value of type "%s". A Dictionary is required.)", list_type.to_string()), p_for->list);
+			} else if (list_type.has_container_element_types()) {
+				variable_type = list_type.get_container_element_type_or_variant(0);
+				variable_type.type_source = list_type.type_source;
+				value_type = list_type.get_container_element_type_or_variant(1);
+				value_type.type_source = list_type.type_source;
+			}
+		} else if (is_range) {
 			// Already solved.
 		} else if (list_type.is_variant()) {
 			variable_type.kind = GDScriptParser::DataType::VARIANT;
@@ -2541,7 +2609,7 @@ void GDScriptAnalyzer::resolve_for(GDScriptParser::ForNode *p_for) {
 				} else if (!is_type_compatible(specified_type, variable_type)) {
 					p_for->use_conversion_assign = true;
 				}
-				if (p_for->list) {
+				if (p_for->list && p_for->value_variable == nullptr) {
 					if (p_for->list->type == GDScriptParser::Node::ARRAY) {
 						update_array_literal_element_type(static_cast<GDScriptParser::ArrayNode *>(p_for->list), specified_type);
 					} else if (p_for->list->type == GDScriptParser::Node::DICTIONARY) {
@@ -2562,12 +2630,46 @@ void GDScriptAnalyzer::resolve_for(GDScriptParser::ForNode *p_for) {
 		}
 	}
 
+	if (p_for->value_variable) {
+		if (p_for->value_datatype_specifier) {
+			GDScriptParser::DataType specified_type = type_from_metatype(resolve_datatype(p_for->value_datatype_specifier));
+			if (!specified_type.is_variant()) {
+				if (value_type.is_variant() || !value_type.is_hard_type()) {
+					mark_node_unsafe(p_for->value_variable);
+					p_for->use_value_conversion_assign = true;
+				} else if (!is_type_compatible(specified_type, value_type, true, p_for->value_variable)) {
+					if (is_type_compatible(value_type, specified_type)) {
+						mark_node_unsafe(p_for->value_variable);
+						p_for->use_value_conversion_assign = true;
+					} else {
+						push_error(vformat(R"(Unable to iterate on value of type "%s" with value variable of type "%s".)", list_type.to_string(), specified_type.to_string()), p_for->value_datatype_specifier);
+					}
+				} else if (!is_type_compatible(specified_type, value_type)) {
+					p_for->use_value_conversion_assign = true;
+				}
+			}
+			p_for->value_variable->set_datatype(specified_type);
+		} else {
+			p_for->value_variable->set_datatype(value_type);
+#ifdef DEBUG_ENABLED
+			if (value_type.is_hard_type()) {
+				parser->push_warning(p_for->value_variable, GDScriptWarning::INFERRED_DECLARATION, R"("for" value variable)", p_for->value_variable->name);
+			} else {
+				parser->push_warning(p_for->value_variable, GDScriptWarning::UNTYPED_DECLARATION, R"("for" value variable)", p_for->value_variable->name);
+			}
+#endif // DEBUG_ENABLED
+		}
+	}
+
 	resolve_suite(p_for->loop);
 	p_for->set_datatype(p_for->loop->get_datatype());
 #ifdef DEBUG_ENABLED
 	if (p_for->variable) {
 		is_shadowing(p_for->variable, R"("for" iterator variable)", true);
 	}
+	if (p_for->value_variable) {
+		is_shadowing(p_for->value_variable, R"("for" value variable)", true);
+	}
 #endif // DEBUG_ENABLED
 }
 
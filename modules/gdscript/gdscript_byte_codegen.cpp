@@ -29,6 +29,7 @@
 /**************************************************************************/
 
 #include "gdscript_byte_codegen.h"
+#include "gdscript_vm_stats.h"
 
 #include "core/object/class_db.h"
 
@@ -225,6 +226,13 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 		function->code = opcodes;
 		function->_code_ptr = &function->code.write[0];
 		function->_code_size = opcodes.size();
+#ifdef GDSCRIPT_VM_STATS
+		if (function->vm_stats_ip_counts) {
+			memdelete_arr(function->vm_stats_ip_counts);
+		}
+		function->vm_stats_ip_counts = memnew_arr(uint64_t, function->_code_size);
+		memset(function->vm_stats_ip_counts, 0, sizeof(uint64_t) * function->_code_size);
+#endif
 
 	} else {
 		function->_code_ptr = nullptr;
@@ -1690,6 +1698,50 @@ void GDScriptByteCodeGenerator::write_for(const Address &p_variable, bool p_use_
 				case Variant::ARRAY:
 					begin_opcode = GDScriptFunction::OPCODE_ITERATE_BEGIN_ARRAY;
 					iterate_opcode = GDScriptFunction::OPCODE_ITERATE_ARRAY;
+					// Goblin: `Array[T]` of a value builtin into an iterator of the same static type
+					// copies raw elements. The iterator keeps its type through the body, so the slot
+					// never needs a type check.
+					if (!p_use_conversion && container.type.has_container_element_type(0)) {
+						const GDScriptDataType element_type = container.type.get_container_element_type(0);
+						if (element_type.kind == GDScriptDataType::BUILTIN && p_variable.type.kind == GDScriptDataType::BUILTIN && p_variable.type.builtin_type == element_type.builtin_type) {
+							switch (element_type.builtin_type) {
+								case Variant::INT:
+									begin_opcode = GDScriptFunction::OPCODE_ITERATE_BEGIN_TYPED_ARRAY_INT;
+									iterate_opcode = GDScriptFunction::OPCODE_ITERATE_TYPED_ARRAY_INT;
+									break;
+								case Variant::FLOAT:
+									begin_opcode = GDScriptFunction::OPCODE_ITERATE_BEGIN_TYPED_ARRAY_FLOAT;
+									iterate_opcode = GDScriptFunction::OPCODE_ITERATE_TYPED_ARRAY_FLOAT;
+									break;
+								case Variant::VECTOR2:
+									begin_opcode = GDScriptFunction::OPCODE_ITERATE_BEGIN_TYPED_ARRAY_VECTOR2;
+									iterate_opcode = GDScriptFunction::OPCODE_ITERATE_TYPED_ARRAY_VECTOR2;
+									break;
+								case Variant::VECTOR2I:
+									begin_opcode = GDScriptFunction::OPCODE_ITERATE_BEGIN_TYPED_ARRAY_VECTOR2I;
+									iterate_opcode = GDScriptFunction::OPCODE_ITERATE_TYPED_ARRAY_VECTOR2I;
+									break;
+								case Variant::VECTOR3:
+									begin_opcode = GDScriptFunction::OPCODE_ITERATE_BEGIN_TYPED_ARRAY_VECTOR3;
+									iterate_opcode = GDScriptFunction::OPCODE_ITERATE_TYPED_ARRAY_VECTOR3;
+									break;
+								case Variant::VECTOR3I:
+									begin_opcode = GDScriptFunction::OPCODE_ITERATE_BEGIN_TYPED_ARRAY_VECTOR3I;
+									iterate_opcode = GDScriptFunction::OPCODE_ITERATE_TYPED_ARRAY_VECTOR3I;
+									break;
+								case Variant::VECTOR4:
+									begin_opcode = GDScriptFunction::OPCODE_ITERATE_BEGIN_TYPED_ARRAY_VECTOR4;
+									iterate_opcode = GDScriptFunction::OPCODE_ITERATE_TYPED_ARRAY_VECTOR4;
+									break;
+								case Variant::COLOR:
+									begin_opcode = GDScriptFunction::OPCODE_ITERATE_BEGIN_TYPED_ARRAY_COLOR;
+									iterate_opcode = GDScriptFunction::OPCODE_ITERATE_TYPED_ARRAY_COLOR;
+									break;
+								default:
+									break;
+							}
+						}
+					}
 					break;
 				case Variant::PACKED_BYTE_ARRAY:
 					begin_opcode = GDScriptFunction::OPCODE_ITERATE_BEGIN_PACKED_BYTE_ARRAY;
@@ -1784,6 +1836,57 @@ void GDScriptByteCodeGenerator::write_for(const Address &p_variable, bool p_use_
 	}
 }
 
+void GDScriptByteCodeGenerator::write_for_key_value(const Address &p_key, const Address &p_value, bool p_key_conversion, bool p_value_conversion) {
+	const Address &counter = for_counter_variables.back()->get();
+	const Address &container = for_container_variables.back()->get();
+
+	current_breaks_to_patch.push_back(List<int>());
+
+	Address key_temp;
+	if (p_key_conversion) {
+		key_temp = Address(Address::LOCAL_VARIABLE, add_local("@iterator_key_temp", GDScriptDataType()));
+	}
+	Address value_temp;
+	if (p_value_conversion) {
+		value_temp = Address(Address::LOCAL_VARIABLE, add_local("@iterator_value_temp", GDScriptDataType()));
+	}
+
+	// Begin loop.
+	append_opcode(GDScriptFunction::OPCODE_ITERATE_BEGIN_DICTIONARY_KEY_VALUE);
+	append(counter);
+	append(container);
+	append(p_key_conversion ? key_temp : p_key);
+	append(p_value_conversion ? value_temp : p_value);
+	for_jmp_addrs.push_back(opcodes.size());
+	append(0); // End of loop address, will be patched.
+	append_opcode(GDScriptFunction::OPCODE_JUMP);
+	append(opcodes.size() + 7); // Skip over 'continue' code.
+
+	// Next iteration.
+	int continue_addr = opcodes.size();
+	continue_addrs.push_back(continue_addr);
+	append_opcode(GDScriptFunction::OPCODE_ITERATE_DICTIONARY_KEY_VALUE);
+	append(counter);
+	append(container);
+	append(p_key_conversion ? key_temp : p_key);
+	append(p_value_conversion ? value_temp : p_value);
+	for_jmp_addrs.push_back(opcodes.size());
+	append(0); // Jump destination, will be patched.
+
+	if (p_key_conversion) {
+		write_assign_with_conversion(p_key, key_temp);
+		if (p_key.type.can_contain_object()) {
+			clear_address(key_temp); // Can contain `RefCounted`, so clear it.
+		}
+	}
+	if (p_value_conversion) {
+		write_assign_with_conversion(p_value, value_temp);
+		if (p_value.type.can_contain_object()) {
+			clear_address(value_temp); // Can contain `RefCounted`, so clear it.
+		}
+	}
+}
+
 void GDScriptByteCodeGenerator::write_endfor(bool p_is_range) {
 	// Jump back to loop check.
 	append_opcode(GDScriptFunction::OPCODE_JUMP);
@@ -550,6 +550,7 @@ public:
 	virtual void write_for_list_assignment(const Address &p_list) override;
 	virtual void write_for_range_assignment(const Address &p_from, const Address &p_to, const Address &p_step) override;
 	virtual void write_for(const Address &p_variable, bool p_use_conversion, bool p_is_range) override;
+	virtual void write_for_key_value(const Address &p_key, const Address &p_value, bool p_key_conversion, bool p_value_conversion) override;
 	virtual void write_endfor(bool p_is_range) override;
 	virtual void start_while_condition() override;
 	virtual void write_while(const Address &p_condition) override;
@@ -152,6 +152,7 @@ public:
 	virtual void write_for_list_assignment(const Address &p_list) = 0;
 	virtual void write_for_range_assignment(const Address &p_from, const Address &p_to, const Address &p_step) = 0;
 	virtual void write_for(const Address &p_variable, bool p_use_conversion, bool p_is_range) = 0;
+	virtual void write_for_key_value(const Address &p_key, const Address &p_value, bool p_key_conversion, bool p_value_conversion) = 0; // Goblin: `for key, value in dict`.
 	virtual void write_endfor(bool p_is_range) = 0;
 	virtual void start_while_condition() = 0; // Used to allow a jump to the expression evaluation.
 	virtual void write_while(const Address &p_condition) = 0;
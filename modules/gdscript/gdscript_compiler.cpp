@@ -2100,6 +2100,10 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Sui
 				codegen.start_block();
 
 				GDScriptCodeGenerator::Address iterator = codegen.add_local(for_n->variable->name, _gdtype_from_datatype(for_n->variable->get_datatype(), codegen.script));
+				GDScriptCodeGenerator::Address value_iterator;
+				if (for_n->value_variable) {
+					value_iterator = codegen.add_local(for_n->value_variable->name, _gdtype_from_datatype(for_n->value_variable->get_datatype(), codegen.script));
+				}
 
 				// Optimize `range()` call to not allocate an array.
 				GDScriptParser::CallNode *range_call = nullptr;
@@ -2158,7 +2162,11 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Sui
 					}
 				}
 
-				gen->write_for(iterator, for_n->use_conversion_assign, range_call != nullptr);
+				if (for_n->value_variable) {
+					gen->write_for_key_value(iterator, value_iterator, for_n->use_conversion_assign, for_n->use_value_conversion_assign);
+				} else {
+					gen->write_for(iterator, for_n->use_conversion_assign, range_call != nullptr);
+				}
 
 				// Loop variables must be cleared even when `break`/`continue` is used.
 				List<GDScriptCodeGenerator::Address> loop_locals = _add_block_locals(codegen, for_n->loop);
@@ -3344,6 +3352,12 @@ void GDScriptCompiler::_get_function_ptr_replacements(HashMap<GDScriptFunction *
 }
 
 Error GDScriptCompiler::compile(const GDScriptParser *p_parser, GDScript *p_script, bool p_keep_state) {
+	// Goblin: methods resolved before the compile, or seen half-compiled, must not be reused after it.
+	struct ResolvedMethodsInvalidator {
+		ResolvedMethodsInvalidator() { GDScript::_invalidate_resolved_methods(); }
+		~ResolvedMethodsInvalidator() { GDScript::_invalidate_resolved_methods(); }
+	} resolved_methods_invalidator;
+
 	err_line = -1;
 	err_column = -1;
 	error = "";
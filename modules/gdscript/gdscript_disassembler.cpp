@@ -32,6 +32,7 @@
 
 #include "gdscript.h"
 #include "gdscript_function.h"
+#include "gdscript_vm_stats.h"
 
 #include "core/object/method_bind.h"
 #include "core/string/string_builder.h"
@@ -115,6 +116,10 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 		int incr = 0;
 
 		text += " ";
+#ifdef GDSCRIPT_VM_STATS
+		// Goblin: execution count of the instruction, to spot hot code when choosing what to fuse.
+		text += vformat("[%10d] ", vm_stats_ip_counts ? vm_stats_ip_counts[ip] : 0);
+#endif
 		text += itos(ip);
 		text += ": ";
 
@@ -1215,7 +1220,15 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 	m_macro(PACKED_VECTOR3_ARRAY); \
 	m_macro(PACKED_COLOR_ARRAY); \
 	m_macro(PACKED_VECTOR4_ARRAY); \
-	m_macro(OBJECT)
+	m_macro(OBJECT); \
+	m_macro(TYPED_ARRAY_INT); \
+	m_macro(TYPED_ARRAY_FLOAT); \
+	m_macro(TYPED_ARRAY_VECTOR2); \
+	m_macro(TYPED_ARRAY_VECTOR2I); \
+	m_macro(TYPED_ARRAY_VECTOR3); \
+	m_macro(TYPED_ARRAY_VECTOR3I); \
+	m_macro(TYPED_ARRAY_VECTOR4); \
+	m_macro(TYPED_ARRAY_COLOR)
 
 			case OPCODE_ITERATE_BEGIN: {
 				text += "for-init ";
@@ -1273,6 +1286,21 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 6;
 			} break;
+			case OPCODE_ITERATE_BEGIN_DICTIONARY_KEY_VALUE:
+			case OPCODE_ITERATE_DICTIONARY_KEY_VALUE: {
+				text += _code_ptr[ip] == OPCODE_ITERATE_BEGIN_DICTIONARY_KEY_VALUE ? "for-init " : "for-loop ";
+				text += DADDR(3);
+				text += ", ";
+				text += DADDR(4);
+				text += " in ";
+				text += DADDR(2);
+				text += " counter ";
+				text += DADDR(1);
+				text += " end ";
+				text += itos(_code_ptr[ip + 5]);
+
+				incr += 6;
+			} break;
 			case OPCODE_STORE_GLOBAL: {
 				text += "store global ";
 				text += DADDR(1);
@@ -31,6 +31,7 @@
 #include "gdscript_function.h"
 
 #include "gdscript.h"
+#include "gdscript_vm_stats.h"
 
 #include "core/object/class_db.h"
 
@@ -330,6 +331,7 @@ GDScriptFunction::GDScriptFunction() {
 
 GDScriptFunction::~GDScriptFunction() {
 	get_script()->member_functions.erase(name);
+	GDScript::_invalidate_resolved_methods();
 
 	for (int i = 0; i < lambdas.size(); i++) {
 		memdelete(lambdas[i]);
@@ -340,6 +342,13 @@ GDScriptFunction::~GDScriptFunction() {
 	}
 	return_type.script_type_ref = Ref<Script>();
 
+#ifdef GDSCRIPT_VM_STATS
+	GDScriptVMStats::forget_function(this);
+	if (vm_stats_ip_counts) {
+		memdelete_arr(vm_stats_ip_counts);
+	}
+#endif
+
 #ifdef DEBUG_ENABLED
 	MutexLock lock(GDScriptLanguage::get_singleton()->mutex);
 	GDScriptLanguage::get_singleton()->function_list.remove(&function_list);
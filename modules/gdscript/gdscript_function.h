@@ -304,6 +304,26 @@ public:
 		OPCODE_ITERATE_PACKED_VECTOR4_ARRAY,
 		OPCODE_ITERATE_OBJECT,
 		OPCODE_ITERATE_RANGE,
+		// Goblin: typed `Array[T]` of a value builtin, element written straight into the typed iterator slot.
+		OPCODE_ITERATE_BEGIN_TYPED_ARRAY_INT,
+		OPCODE_ITERATE_BEGIN_TYPED_ARRAY_FLOAT,
+		OPCODE_ITERATE_BEGIN_TYPED_ARRAY_VECTOR2,
+		OPCODE_ITERATE_BEGIN_TYPED_ARRAY_VECTOR2I,
+		OPCODE_ITERATE_BEGIN_TYPED_ARRAY_VECTOR3,
+		OPCODE_ITERATE_BEGIN_TYPED_ARRAY_VECTOR3I,
+		OPCODE_ITERATE_BEGIN_TYPED_ARRAY_VECTOR4,
+		OPCODE_ITERATE_BEGIN_TYPED_ARRAY_COLOR,
+		OPCODE_ITERATE_TYPED_ARRAY_INT,
+		OPCODE_ITERATE_TYPED_ARRAY_FLOAT,
+		OPCODE_ITERATE_TYPED_ARRAY_VECTOR2,
+		OPCODE_ITERATE_TYPED_ARRAY_VECTOR2I,
+		OPCODE_ITERATE_TYPED_ARRAY_VECTOR3,
+		OPCODE_ITERATE_TYPED_ARRAY_VECTOR3I,
+		OPCODE_ITERATE_TYPED_ARRAY_VECTOR4,
+		OPCODE_ITERATE_TYPED_ARRAY_COLOR,
+		// Goblin: `for key, value in dict`.
+		OPCODE_ITERATE_BEGIN_DICTIONARY_KEY_VALUE,
+		OPCODE_ITERATE_DICTIONARY_KEY_VALUE,
 		OPCODE_STORE_GLOBAL,
 		OPCODE_STORE_NAMED_GLOBAL,
 		OPCODE_TYPE_ADJUST_BOOL,
@@ -382,6 +402,7 @@ private:
 	friend class GDScriptCompiler;
 	friend class GDScriptByteCodeGenerator;
 	friend class GDScriptLanguage;
+	friend class GDScriptVMStats;
 
 	StringName name;
 	StringName source;
@@ -458,6 +479,11 @@ private:
 	MethodBind **_methods_ptr = nullptr;
 	GDScriptFunction **_lambdas_ptr = nullptr;
 
+#ifdef GDSCRIPT_VM_STATS
+	// Goblin: per-instruction execution counts, indexed by `ip` (see `GDScriptVMStats`).
+	mutable uint64_t *vm_stats_ip_counts = nullptr;
+#endif
+
 #ifdef DEBUG_ENABLED
 	CharString func_cname;
 	const char *_func_cname = nullptr;
@@ -218,12 +218,44 @@ GDScriptParser::GDScriptParser() {
 #endif // TOOLS_ENABLED
 }
 
+void *GDScriptParser::NodeArena::allocate(size_t p_size, size_t p_align) {
+	if (page != nullptr) {
+		size_t offset = (sizeof(Page) + page->used + p_align - 1) & ~(p_align - 1);
+		if (offset + p_size <= sizeof(Page) + page->capacity) {
+			page->used = offset + p_size - sizeof(Page);
+			return reinterpret_cast<uint8_t *>(page) + offset;
+		}
+	}
+
+	// Nodes larger than a page (none today, but keep it safe) get a dedicated page.
+	size_t capacity = MAX(PAGE_SIZE, p_size + p_align);
+	Page *new_page = static_cast<Page *>(memalloc(sizeof(Page) + capacity));
+	new_page->prev = page;
+	new_page->capacity = capacity;
+	new_page->used = 0;
+	page = new_page;
+
+	size_t offset = (sizeof(Page) + p_align - 1) & ~(p_align - 1);
+	page->used = offset + p_size - sizeof(Page);
+	return reinterpret_cast<uint8_t *>(page) + offset;
+}
+
+void GDScriptParser::NodeArena::release() {
+	while (page != nullptr) {
+		Page *prev = page->prev;
+		memfree(page);
+		page = prev;
+	}
+}
+
 GDScriptParser::~GDScriptParser() {
+	// Nodes live in the arena: run destructors only, the pages go in one sweep.
 	while (list != nullptr) {
 		Node *element = list;
 		list = list->next;
-		memdelete(element);
+		element->~Node();
 	}
+	node_arena.release();
 }
 
 void GDScriptParser::clear() {
@@ -2359,10 +2391,26 @@ GDScriptParser::ForNode *GDScriptParser::parse_for() {
 		}
 	}
 
-	if (n_for->datatype_specifier == nullptr) {
-		consume(GDScriptTokenizer::Token::TK_IN, R"(Expected "in" or ":" after "for" variable name.)");
+	// Goblin: `for key, value in dict`.
+	if (match(GDScriptTokenizer::Token::COMMA)) {
+		if (consume(GDScriptTokenizer::Token::IDENTIFIER, R"(Expected value variable name after "," in "for".)")) {
+			n_for->value_variable = parse_identifier();
+		}
+		if (match(GDScriptTokenizer::Token::COLON)) {
+			n_for->value_datatype_specifier = parse_type();
+			if (n_for->value_datatype_specifier == nullptr) {
+				push_error(R"(Expected type specifier after ":".)");
+			}
+		}
+		if (n_for->value_datatype_specifier == nullptr) {
+			consume(GDScriptTokenizer::Token::TK_IN, R"(Expected "in" or ":" after "for" value variable name.)");
+		} else {
+			consume(GDScriptTokenizer::Token::TK_IN, R"(Expected "in" after "for" value variable type specifier.)");
+		}
+	} else if (n_for->datatype_specifier == nullptr) {
+		consume(GDScriptTokenizer::Token::TK_IN, R"(Expected "in", "," or ":" after "for" variable name.)");
 	} else {
-		consume(GDScriptTokenizer::Token::TK_IN, R"(Expected "in" after "for" variable type specifier.)");
+		consume(GDScriptTokenizer::Token::TK_IN, R"(Expected "in" or "," after "for" variable type specifier.)");
 	}
 
 	n_for->list = parse_expression(false);
@@ -2389,6 +2437,15 @@ GDScriptParser::ForNode *GDScriptParser::parse_for() {
 		}
 		suite->add_local(SuiteNode::Local(n_for->variable, current_function));
 	}
+	if (n_for->value_variable) {
+		const SuiteNode::Local &local = current_suite->get_local(n_for->value_variable->name);
+		if (local.type != SuiteNode::Local::UNDEFINED) {
+			push_error(vformat(R"(There is already a %s named "%s" declared in this scope.)", local.get_name(), n_for->value_variable->name), n_for->value_variable);
+		} else if (n_for->variable && n_for->variable->name == n_for->value_variable->name) {
+			push_error(vformat(R"(The "for" key and value variables can't both be named "%s".)", n_for->value_variable->name), n_for->value_variable);
+		}
+		suite->add_local(SuiteNode::Local(n_for->value_variable, current_function));
+	}
 	suite->is_in_loop = true;
 	n_for->loop = parse_suite(R"("for" block)", suite);
 	complete_extents(n_for);
@@ -6317,6 +6374,10 @@ void GDScriptParser::TreePrinter::print_enum(EnumNode *p_enum) {
 void GDScriptParser::TreePrinter::print_for(ForNode *p_for) {
 	push_text("For ");
 	print_identifier(p_for->variable);
+	if (p_for->value_variable) {
+		push_text(", ");
+		print_identifier(p_for->value_variable);
+	}
 	push_text(" IN ");
 	print_expression(p_for->list);
 	push_line(" :");
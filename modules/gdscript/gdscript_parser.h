@@ -979,6 +979,10 @@ public:
 		IdentifierNode *variable = nullptr;
 		TypeNode *datatype_specifier = nullptr;
 		bool use_conversion_assign = false;
+		// Goblin: `for key, value in dict`. `variable` is the key.
+		IdentifierNode *value_variable = nullptr;
+		TypeNode *value_datatype_specifier = nullptr;
+		bool use_value_conversion_assign = false;
 		ExpressionNode *list = nullptr;
 		SuiteNode *loop = nullptr;
 
@@ -1496,8 +1500,29 @@ private:
 	List<bool> multiline_stack;
 	HashMap<String, Ref<GDScriptParserRef>> depended_parsers;
 
+	// Goblin: bump arena for AST nodes. Nodes are placement-constructed into
+	// fixed-size pages instead of one heap block each; teardown runs the
+	// destructors through the intrusive `list` and then frees whole pages.
+	// Plain-old-data on purpose: `clear()` moves ownership through the implicit
+	// copy assignment exactly like it does for `list`.
+	struct NodeArena {
+		struct Page {
+			Page *prev = nullptr;
+			size_t capacity = 0;
+			size_t used = 0;
+		};
+
+		static constexpr size_t PAGE_SIZE = 32 * 1024;
+
+		Page *page = nullptr;
+
+		void *allocate(size_t p_size, size_t p_align);
+		void release();
+	};
+
 	ClassNode *head = nullptr;
 	Node *list = nullptr;
+	NodeArena node_arena;
 	List<ParserError> errors;
 
 #ifdef DEBUG_ENABLED
@@ -1627,7 +1652,7 @@ private:
 
 	template <typename T>
 	T *alloc_node() {
-		T *node = memnew(T);
+		T *node = memnew_placement(node_arena.allocate(sizeof(T), alignof(T)), T);
 
 		node->next = list;
 		list = node;
@@ -1642,7 +1667,7 @@ private:
 	// Such nodes don't track their extents as they don't relate to actual tokens.
 	template <typename T>
 	T *alloc_recovery_node() {
-		T *node = memnew(T);
+		T *node = memnew_placement(node_arena.allocate(sizeof(T), alignof(T)), T);
 		node->next = list;
 		list = node;
 
@@ -0,0 +1,144 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                            GOBLIN ENGINE                               */
+/**************************************************************************/
+
+#include "gdscript_sampling_profiler.h"
+
+#include "gdscript.h"
+#include "gdscript_function.h"
+
+#include "core/config/project_settings.h"
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+#include "core/templates/local_vector.h"
+
+bool GDScriptSamplingProfiler::configure() {
+	bool enabled = GLOBAL_DEF_RST("debug/settings/gdscript/sampling_profiler/enabled", false);
+	interval_usec = MAX(100, (int)GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "debug/settings/gdscript/sampling_profiler/interval_usec", PROPERTY_HINT_RANGE, "100,100000,1,suffix:µs"), 1000));
+	output_path = GLOBAL_DEF_RST("debug/settings/gdscript/sampling_profiler/output_path", "user://gdscript_samples.folded");
+
+	// Play-test builds can be switched on without re-exporting: `game ++ --gdscript-sample[=<path>]`.
+	for (const String &arg : OS::get_singleton()->get_cmdline_user_args()) {
+		if (arg == "--gdscript-sample") {
+			enabled = true;
+		} else if (arg.begins_with("--gdscript-sample=")) {
+			enabled = true;
+			output_path = arg.substr(arg.find_char('=') + 1);
+		}
+	}
+	return enabled;
+}
+
+void GDScriptSamplingProfiler::_ticker_loop(void *p_userdata) {
+	while (running.is_set()) {
+		OS::get_singleton()->delay_usec(interval_usec);
+		epoch.increment();
+	}
+}
+
+void GDScriptSamplingProfiler::start() {
+	ERR_FAIL_COND(running.is_set());
+	running.set();
+	active = true;
+	ticker.start(&GDScriptSamplingProfiler::_ticker_loop, nullptr);
+}
+
+void GDScriptSamplingProfiler::stop() {
+	if (!running.is_set()) {
+		return;
+	}
+	active = false;
+	running.clear();
+	ticker.wait_to_finish();
+}
+
+void GDScriptSamplingProfiler::clear() {
+	MutexLock lock(mutex);
+	stacks.clear();
+	lines.clear();
+	total_samples = 0;
+}
+
+void GDScriptSamplingProfiler::take_sample() {
+	const uint32_t current = epoch.get();
+	const uint32_t weight = current - seen_epoch;
+	seen_epoch = current;
+
+	const GDScriptLanguage::CallLevel *top = GDScriptLanguage::_call_stack;
+	if (top == nullptr || top->function == nullptr) {
+		return;
+	}
+
+	LocalVector<String> frames;
+	for (const GDScriptLanguage::CallLevel *cl = top; cl != nullptr; cl = cl->prev) {
+		if (cl->function == nullptr) {
+			continue;
+		}
+		frames.push_back(vformat("%s:%s:%d", cl->function->get_script()->get_script_path(), cl->function->get_name(), *cl->line));
+	}
+
+	String folded = Thread::is_main_thread() ? String("main") : vformat("thread %d", (uint64_t)Thread::get_caller_id());
+	for (int i = (int)frames.size() - 1; i >= 0; i--) {
+		folded += ";" + frames[i];
+	}
+	const String line = vformat("%s:%d (%s)", top->function->get_script()->get_script_path(), *top->line, top->function->get_name());
+
+	MutexLock lock(mutex);
+	stacks[folded] += weight;
+	lines[line] += weight;
+	total_samples += weight;
+}
+
+Error GDScriptSamplingProfiler::save_stacks(const String &p_path) {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(f.is_null(), err, "GDScript sampling profiler: Can't write " + p_path);
+
+	MutexLock lock(mutex);
+	for (const KeyValue<String, uint64_t> &E : stacks) {
+		f->store_line(vformat("%s %d", E.key, E.value));
+	}
+	return OK;
+}
+
+Error GDScriptSamplingProfiler::save_lines(const String &p_path) {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(f.is_null(), err, "GDScript sampling profiler: Can't write " + p_path);
+
+	struct LineSamples {
+		String line;
+		uint64_t samples = 0;
+		bool operator<(const LineSamples &p_other) const { return samples > p_other.samples; }
+	};
+
+	MutexLock lock(mutex);
+	LocalVector<LineSamples> sorted;
+	sorted.reserve(lines.size());
+	for (const KeyValue<String, uint64_t> &E : lines) {
+		sorted.push_back({ E.key, E.value });
+	}
+	sorted.sort();
+
+	f->store_line(vformat("# %d samples, %d usec interval", total_samples, interval_usec));
+	for (const LineSamples &E : sorted) {
+		f->store_line(vformat("%6.2f%% %8d  %s", 100.0 * E.samples / MAX(total_samples, (uint64_t)1), E.samples, E.line));
+	}
+	return OK;
+}
+
+void GDScriptSamplingProfiler::finish() {
+	if (!running.is_set()) {
+		return;
+	}
+	stop();
+	if (output_path.is_empty()) {
+		return;
+	}
+	if (save_stacks(output_path) == OK && save_lines(output_path + ".lines.txt") == OK) {
+		print_line(vformat("GDScript sampling profiler: %d samples written to \"%s\".", total_samples, output_path));
+	}
+}
@@ -0,0 +1,65 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                            GOBLIN ENGINE                               */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/string/ustring.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/safe_refcount.h"
+
+// Statistical profiler for running GDScript code, available in every build type.
+//
+// A ticker thread bumps `epoch` every interval. VM threads notice the change at their next
+// `OPCODE_LINE` and record their own `GDScriptLanguage` call stack (the `CallLevel` shadow
+// stack maintained by `GDScriptFunction::call`), weighted by the number of ticks since their
+// last sample. Sampling is cooperative, so no thread ever reads another thread's stack, and
+// time spent in a native call is charged to the script line that made it.
+//
+// Enabled via `debug/settings/gdscript/sampling_profiler/enabled` or the `--gdscript-sample[=<path>]`
+// user argument (after `++`). On shutdown it writes `<path>` as folded stacks (flame graph input)
+// and `<path>.lines.txt` with per-line self samples.
+class GDScriptSamplingProfiler {
+	static inline bool active = false;
+	static inline SafeNumeric<uint32_t> epoch;
+	static inline SafeFlag running;
+	static inline uint32_t interval_usec = 1000;
+	static inline String output_path;
+	static inline Thread ticker;
+
+	static inline thread_local uint32_t seen_epoch = 0;
+
+	static inline Mutex mutex;
+	static inline HashMap<String, uint64_t> stacks; // "thread;script:func:line;..." -> samples.
+	static inline HashMap<String, uint64_t> lines; // "script:line (func)" -> self samples.
+	static inline uint64_t total_samples = 0;
+
+	static void _ticker_loop(void *p_userdata);
+
+public:
+	// Reads the settings and command line. Returns `true` if the profiler should run, in
+	// which case call stacks and line opcodes must be tracked from the start.
+	static bool configure();
+
+	static void start();
+	static void stop();
+	static void clear();
+
+	static Error save_stacks(const String &p_path);
+	static Error save_lines(const String &p_path);
+	// Stops and writes both outputs to the configured path, if the profiler ran.
+	static void finish();
+
+	_FORCE_INLINE_ static bool is_active() { return active; }
+	_FORCE_INLINE_ static bool is_sample_pending() { return unlikely(active) && seen_epoch != epoch.get(); }
+	// Called by the VM thread that owns the stack.
+	static void take_sample();
+	// Marks the current tick as seen without recording, used when a thread enters script code
+	// from the engine so idle time is not charged to the first line.
+	_FORCE_INLINE_ static void sync_thread() { seen_epoch = epoch.get(); }
+};
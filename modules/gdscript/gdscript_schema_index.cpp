@@ -0,0 +1,401 @@
+/**************************************************************************/
+/*  gdscript_schema_index.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                            GOBLIN ENGINE                               */
+/**************************************************************************/
+
+#include "gdscript_schema_index.h"
+
+#include "core/config/project_settings.h"
+#include "core/os/os.h"
+#include "core/templates/local_vector.h"
+
+/*
+ * Index file layout (little endian, `FileAccess` encoding):
+ *   u32 magic ("GDSI"), u32 version, u32 schema count
+ *   per schema: pascal string name, pascal string path, u64 modified time, u8 compiled,
+ *               [u32 count + (pascal string path, u64 modified time) dependencies, datatype]
+ *   datatype:   u8 kind, u8 type source, u32 builtin type, pascal string native type,
+ *               u32 count + datatypes for container element types, then union types,
+ *               u32 count + (pascal string key, datatype) shape entries,
+ *               u32 count + `store_var` defaults, u8 is schema, pascal string schema name
+ */
+
+static constexpr int MAX_DATATYPE_DEPTH = 64;
+
+static bool _is_storable_value(const Variant &p_value) {
+	switch (p_value.get_type()) {
+		case Variant::OBJECT:
+			return p_value.get_validated_object() == nullptr;
+		case Variant::ARRAY: {
+			const Array array = p_value;
+			for (int i = 0; i < array.size(); i++) {
+				if (!_is_storable_value(array[i])) {
+					return false;
+				}
+			}
+			return array.get_typed_builtin() != Variant::OBJECT;
+		}
+		case Variant::DICTIONARY: {
+			const Dictionary dictionary = p_value;
+			for (const KeyValue<Variant, Variant> &E : dictionary) {
+				if (!_is_storable_value(E.key) || !_is_storable_value(E.value)) {
+					return false;
+				}
+			}
+			return dictionary.get_typed_key_builtin() != Variant::OBJECT && dictionary.get_typed_value_builtin() != Variant::OBJECT;
+		}
+		default:
+			return true;
+	}
+}
+
+String GDScriptSchemaIndex::get_cache_path() {
+	return ProjectSettings::get_singleton()->get_project_data_path().path_join("goblin_schema_index.bin");
+}
+
+Vector<String> GDScriptSchemaIndex::get_dependencies(GDScriptParser *p_parser) {
+	Vector<String> dependencies;
+	for (const KeyValue<String, Ref<GDScriptParserRef>> &E : p_parser->get_depended_parsers()) {
+		dependencies.push_back(E.key);
+	}
+	return dependencies;
+}
+
+bool GDScriptSchemaIndex::has(const StringName &p_name) const {
+	MutexLock lock(mutex);
+	return schemas.has(p_name);
+}
+
+bool GDScriptSchemaIndex::is_dirty() const {
+	MutexLock lock(mutex);
+	return dirty;
+}
+
+String GDScriptSchemaIndex::get_path(const StringName &p_name) const {
+	MutexLock lock(mutex);
+	const Entry *entry = schemas.getptr(p_name);
+	return entry != nullptr ? entry->path : String();
+}
+
+bool GDScriptSchemaIndex::_is_current(const String &p_path, uint64_t p_modified_time) {
+	// Exported scripts can't change under the index (and have no modification time in a pack).
+	return OS::get_singleton()->has_feature("template") || FileAccess::get_modified_time(p_path) == p_modified_time;
+}
+
+bool GDScriptSchemaIndex::get_datatype(const StringName &p_name, GDScriptParser::DataType &r_type) const {
+	MutexLock lock(mutex);
+	const Entry *entry = schemas.getptr(p_name);
+	if (entry == nullptr || !entry->compiled || !_is_current(entry->path, entry->modified_time)) {
+		return false;
+	}
+	for (const Dependency &dependency : entry->dependencies) {
+		if (!_is_current(dependency.path, dependency.modified_time)) {
+			return false;
+		}
+	}
+	r_type = entry->datatype;
+	return true;
+}
+
+bool GDScriptSchemaIndex::add(const StringName &p_name, const String &p_path) {
+	MutexLock lock(mutex);
+	Entry *entry = schemas.getptr(p_name);
+	if (entry != nullptr && entry->path == p_path) {
+		return false; // Unchanged; a compiled datatype is still checked against the file.
+	}
+	Entry new_entry;
+	new_entry.path = p_path;
+	schemas[p_name] = new_entry;
+	dirty = true;
+	return true;
+}
+
+bool GDScriptSchemaIndex::remove_by_path(const String &p_path, const HashSet<StringName> &p_keep) {
+	MutexLock lock(mutex);
+	LocalVector<StringName> removed;
+	for (const KeyValue<StringName, Entry> &E : schemas) {
+		if (E.value.path == p_path && !p_keep.has(E.key)) {
+			removed.push_back(E.key);
+		}
+	}
+	for (const StringName &name : removed) {
+		schemas.erase(name);
+	}
+	dirty = dirty || !removed.is_empty();
+	return !removed.is_empty();
+}
+
+void GDScriptSchemaIndex::_add_nested_dependencies(const StringName &p_name, const GDScriptParser::DataType &p_type, Vector<Dependency> &r_dependencies) const {
+	// A nested schema was compiled from its own dependencies, which this schema now embeds.
+	if (p_type.is_schema && p_type.schema_name != p_name) {
+		const Entry *entry = schemas.getptr(p_type.schema_name);
+		if (entry != nullptr) {
+			for (const Dependency &dependency : entry->dependencies) {
+				if (!r_dependencies.has(dependency)) {
+					r_dependencies.push_back(dependency);
+				}
+			}
+		}
+	}
+	for (const GDScriptParser::DataType &type : p_type.container_element_types) {
+		_add_nested_dependencies(p_name, type, r_dependencies);
+	}
+	for (const GDScriptParser::DataType &type : p_type.union_types) {
+		_add_nested_dependencies(p_name, type, r_dependencies);
+	}
+	for (const GDScriptParser::DataType &type : p_type.dictionary_shape_value_types) {
+		_add_nested_dependencies(p_name, type, r_dependencies);
+	}
+}
+
+void GDScriptSchemaIndex::set_datatype(const StringName &p_name, const String &p_path, const GDScriptParser::DataType &p_type, const Vector<String> &p_dependencies) {
+	const bool compiled = p_type.is_schema && _can_store(p_type);
+	const uint64_t modified_time = compiled ? FileAccess::get_modified_time(p_path) : 0;
+	Vector<Dependency> dependencies;
+	if (compiled) {
+		for (const String &path : p_dependencies) {
+			if (path != p_path) {
+				dependencies.push_back({ path, FileAccess::get_modified_time(path) });
+			}
+		}
+	}
+
+	MutexLock lock(mutex);
+	if (compiled) {
+		_add_nested_dependencies(p_name, p_type, dependencies);
+	}
+	Entry &entry = schemas[p_name];
+	const bool changed = entry.path != p_path || entry.compiled != compiled || entry.modified_time != modified_time || !_is_same_dependencies(entry.dependencies, dependencies) || (compiled && !_is_same_datatype(entry.datatype, p_type));
+	if (!changed) {
+		return;
+	}
+	entry.path = p_path;
+	entry.compiled = compiled;
+	entry.modified_time = modified_time;
+	entry.datatype = compiled ? p_type : GDScriptParser::DataType();
+	entry.dependencies = dependencies;
+	dirty = true;
+}
+
+bool GDScriptSchemaIndex::_is_same_dependencies(const Vector<Dependency> &p_a, const Vector<Dependency> &p_b) {
+	if (p_a.size() != p_b.size()) {
+		return false;
+	}
+	for (int i = 0; i < p_a.size(); i++) {
+		if (!(p_a[i] == p_b[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Compares what `_store_datatype()` writes.
+bool GDScriptSchemaIndex::_is_same_datatype(const GDScriptParser::DataType &p_a, const GDScriptParser::DataType &p_b) {
+	if (p_a.kind != p_b.kind || p_a.type_source != p_b.type_source || p_a.builtin_type != p_b.builtin_type || p_a.native_type != p_b.native_type || p_a.is_schema != p_b.is_schema || p_a.schema_name != p_b.schema_name) {
+		return false;
+	}
+	if (p_a.container_element_types.size() != p_b.container_element_types.size() || p_a.union_types.size() != p_b.union_types.size() || p_a.dictionary_shape_keys.size() != p_b.dictionary_shape_keys.size() || p_a.dictionary_shape_defaults.size() != p_b.dictionary_shape_defaults.size()) {
+		return false;
+	}
+	for (int i = 0; i < p_a.container_element_types.size(); i++) {
+		if (!_is_same_datatype(p_a.container_element_types[i], p_b.container_element_types[i])) {
+			return false;
+		}
+	}
+	for (int i = 0; i < p_a.union_types.size(); i++) {
+		if (!_is_same_datatype(p_a.union_types[i], p_b.union_types[i])) {
+			return false;
+		}
+	}
+	for (int i = 0; i < p_a.dictionary_shape_keys.size(); i++) {
+		if (p_a.dictionary_shape_keys[i] != p_b.dictionary_shape_keys[i] || !_is_same_datatype(p_a.dictionary_shape_value_types[i], p_b.dictionary_shape_value_types[i])) {
+			return false;
+		}
+	}
+	for (int i = 0; i < p_a.dictionary_shape_defaults.size(); i++) {
+		if (!p_a.dictionary_shape_defaults[i].hash_compare(p_b.dictionary_shape_defaults[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool GDScriptSchemaIndex::_can_store(const GDScriptParser::DataType &p_type) {
+	switch (p_type.kind) {
+		case GDScriptParser::DataType::BUILTIN:
+		case GDScriptParser::DataType::NATIVE:
+		case GDScriptParser::DataType::UNION:
+		case GDScriptParser::DataType::VARIANT:
+			break;
+		default:
+			return false; // Script classes and enums point into other scripts.
+	}
+	for (const GDScriptParser::DataType &type : p_type.container_element_types) {
+		if (!_can_store(type)) {
+			return false;
+		}
+	}
+	for (const GDScriptParser::DataType &type : p_type.union_types) {
+		if (!_can_store(type)) {
+			return false;
+		}
+	}
+	for (const GDScriptParser::DataType &type : p_type.dictionary_shape_value_types) {
+		if (!_can_store(type)) {
+			return false;
+		}
+	}
+	for (const Variant &value : p_type.dictionary_shape_defaults) {
+		if (!_is_storable_value(value)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void GDScriptSchemaIndex::_store_datatype(const Ref<FileAccess> &p_file, const GDScriptParser::DataType &p_type) {
+	p_file->store_8(p_type.kind);
+	p_file->store_8(p_type.type_source);
+	p_file->store_32(p_type.builtin_type);
+	p_file->store_pascal_string(p_type.native_type);
+
+	p_file->store_32(p_type.container_element_types.size());
+	for (const GDScriptParser::DataType &type : p_type.container_element_types) {
+		_store_datatype(p_file, type);
+	}
+	p_file->store_32(p_type.union_types.size());
+	for (const GDScriptParser::DataType &type : p_type.union_types) {
+		_store_datatype(p_file, type);
+	}
+	p_file->store_32(p_type.dictionary_shape_keys.size());
+	for (int i = 0; i < p_type.dictionary_shape_keys.size(); i++) {
+		p_file->store_pascal_string(p_type.dictionary_shape_keys[i]);
+		_store_datatype(p_file, p_type.dictionary_shape_value_types[i]);
+	}
+	p_file->store_32(p_type.dictionary_shape_defaults.size());
+	for (const Variant &value : p_type.dictionary_shape_defaults) {
+		p_file->store_var(value);
+	}
+	p_file->store_8(p_type.is_schema);
+	p_file->store_pascal_string(p_type.schema_name);
+}
+
+bool GDScriptSchemaIndex::_load_datatype(const Ref<FileAccess> &p_file, GDScriptParser::DataType &r_type, int p_depth) {
+	ERR_FAIL_COND_V(p_depth > MAX_DATATYPE_DEPTH, false);
+
+	const uint8_t kind = p_file->get_8();
+	const uint8_t type_source = p_file->get_8();
+	const uint32_t builtin_type = p_file->get_32();
+	ERR_FAIL_COND_V(kind > GDScriptParser::DataType::UNRESOLVED || type_source > GDScriptParser::DataType::ANNOTATED_INFERRED || builtin_type >= Variant::VARIANT_MAX, false);
+	r_type.kind = (GDScriptParser::DataType::Kind)kind;
+	r_type.type_source = (GDScriptParser::DataType::TypeSource)type_source;
+	r_type.builtin_type = (Variant::Type)builtin_type;
+	r_type.native_type = p_file->get_pascal_string();
+
+	const uint64_t max_count = p_file->get_length();
+	uint32_t count = p_file->get_32();
+	ERR_FAIL_COND_V(count > max_count, false);
+	r_type.container_element_types.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		if (!_load_datatype(p_file, r_type.container_element_types.write[i], p_depth + 1)) {
+			return false;
+		}
+	}
+	count = p_file->get_32();
+	ERR_FAIL_COND_V(count > max_count, false);
+	r_type.union_types.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		if (!_load_datatype(p_file, r_type.union_types.write[i], p_depth + 1)) {
+			return false;
+		}
+	}
+	count = p_file->get_32();
+	ERR_FAIL_COND_V(count > max_count, false);
+	r_type.dictionary_shape_keys.resize(count);
+	r_type.dictionary_shape_value_types.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		r_type.dictionary_shape_keys.write[i] = p_file->get_pascal_string();
+		if (!_load_datatype(p_file, r_type.dictionary_shape_value_types.write[i], p_depth + 1)) {
+			return false;
+		}
+	}
+	count = p_file->get_32();
+	ERR_FAIL_COND_V(count > max_count, false);
+	r_type.dictionary_shape_defaults.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		r_type.dictionary_shape_defaults.write[i] = p_file->get_var();
+	}
+	r_type.is_schema = p_file->get_8() != 0;
+	r_type.schema_name = p_file->get_pascal_string();
+	return !p_file->eof_reached();
+}
+
+Error GDScriptSchemaIndex::load(const String &p_path) {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ, &err);
+	if (f.is_null()) {
+		return err;
+	}
+	if (f->get_32() != MAGIC || f->get_32() != VERSION) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+
+	HashMap<StringName, Entry> loaded;
+	const uint32_t count = f->get_32();
+	for (uint32_t i = 0; i < count && !f->eof_reached(); i++) {
+		const StringName name = f->get_pascal_string();
+		Entry &entry = loaded[name];
+		entry.path = f->get_pascal_string();
+		entry.modified_time = f->get_64();
+		entry.compiled = f->get_8() != 0;
+		if (!entry.compiled) {
+			continue;
+		}
+		const uint32_t dependency_count = f->get_32();
+		ERR_FAIL_COND_V_MSG(dependency_count > f->get_length(), ERR_FILE_CORRUPT, "GDScript: Corrupt schema index: " + p_path);
+		entry.dependencies.resize(dependency_count);
+		for (Dependency &dependency : entry.dependencies) {
+			dependency.path = f->get_pascal_string();
+			dependency.modified_time = f->get_64();
+		}
+		if (!_load_datatype(f, entry.datatype, 0)) {
+			ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, "GDScript: Corrupt schema index: " + p_path);
+		}
+	}
+	ERR_FAIL_COND_V_MSG(f->eof_reached(), ERR_FILE_CORRUPT, "GDScript: Truncated schema index: " + p_path);
+
+	MutexLock lock(mutex);
+	schemas = loaded;
+	dirty = false;
+	return OK;
+}
+
+Error GDScriptSchemaIndex::save(const String &p_path) {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(f.is_null(), err, "GDScript: Can't write schema index: " + p_path);
+
+	MutexLock lock(mutex);
+	f->store_32(MAGIC);
+	f->store_32(VERSION);
+	f->store_32(schemas.size());
+	for (const KeyValue<StringName, Entry> &E : schemas) {
+		f->store_pascal_string(E.key);
+		f->store_pascal_string(E.value.path);
+		f->store_64(E.value.modified_time);
+		f->store_8(E.value.compiled);
+		if (E.value.compiled) {
+			f->store_32(E.value.dependencies.size());
+			for (const Dependency &dependency : E.value.dependencies) {
+				f->store_pascal_string(dependency.path);
+				f->store_64(dependency.modified_time);
+			}
+			_store_datatype(f, E.value.datatype);
+		}
+	}
+
+	dirty = false;
+	return OK;
+}
@@ -0,0 +1,83 @@
+/**************************************************************************/
+/*  gdscript_schema_index.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                            GOBLIN ENGINE                               */
+/**************************************************************************/
+
+#pragma once
+
+#include "gdscript_parser.h"
+
+#include "core/io/file_access.h"
+#include "core/os/mutex.h"
+#include "core/string/string_name.h"
+#include "core/string/ustring.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+
+// `@schema` registry: schema name -> declaring script path, plus the compiled schema
+// datatype (shape, entry types and defaults) once the declaring script has been analyzed.
+// A compiled entry lets `Dictionary[Name]` resolve without parsing the declaring script;
+// it is trusted only while the modification times recorded with it still match, for the
+// declaring script and for every script it depended on (nested schemas, constants used in
+// defaults, and what those depended on in turn).
+//
+// Persisted as `res://.godot/goblin_schema_index.bin` (replaces `goblin_schema_cache.cfg`).
+// Changes are made in memory and flushed in batches by `GDScriptLanguage`. Thread-safe:
+// the editor scan, script reloads and analyzers on worker threads all use it.
+class GDScriptSchemaIndex {
+	static constexpr uint32_t MAGIC = 0x49534447; // "GDSI"
+	static constexpr uint32_t VERSION = 2;
+
+	struct Dependency {
+		String path;
+		uint64_t modified_time = 0;
+
+		bool operator==(const Dependency &p_other) const { return path == p_other.path && modified_time == p_other.modified_time; }
+	};
+
+	struct Entry {
+		String path;
+		uint64_t modified_time = 0; // Of `path` when `datatype` was compiled.
+		bool compiled = false;
+		GDScriptParser::DataType datatype;
+		Vector<Dependency> dependencies; // Other scripts `datatype` was compiled from.
+	};
+
+	mutable Mutex mutex;
+	HashMap<StringName, Entry> schemas;
+	bool dirty = false;
+
+	static bool _can_store(const GDScriptParser::DataType &p_type);
+	static bool _is_same_datatype(const GDScriptParser::DataType &p_a, const GDScriptParser::DataType &p_b);
+	static bool _is_same_dependencies(const Vector<Dependency> &p_a, const Vector<Dependency> &p_b);
+	static bool _is_current(const String &p_path, uint64_t p_modified_time);
+	void _add_nested_dependencies(const StringName &p_name, const GDScriptParser::DataType &p_type, Vector<Dependency> &r_dependencies) const;
+	static void _store_datatype(const Ref<FileAccess> &p_file, const GDScriptParser::DataType &p_type);
+	static bool _load_datatype(const Ref<FileAccess> &p_file, GDScriptParser::DataType &r_type, int p_depth);
+
+public:
+	static String get_cache_path();
+	// The scripts `p_parser` depended on, to pass to `set_datatype()`.
+	static Vector<String> get_dependencies(GDScriptParser *p_parser);
+
+	bool has(const StringName &p_name) const;
+	String get_path(const StringName &p_name) const;
+	// Returns `true` and the schema datatype if a compiled entry matches the script on disk.
+	bool get_datatype(const StringName &p_name, GDScriptParser::DataType &r_type) const;
+
+	// Registration from source (scan, reload). Returns `true` if the index changed.
+	bool add(const StringName &p_name, const String &p_path);
+	// Removes the schemas of `p_path`, except those in `p_keep` (still declared there).
+	bool remove_by_path(const String &p_path, const HashSet<StringName> &p_keep = HashSet<StringName>());
+	// Records the analyzed schema datatype, compiled from `p_path` and `p_dependencies` (the
+	// scripts its parser depended on). Types that reference script classes or enums are only
+	// registered by name, and keep resolving through the declaring script. Only marks the
+	// index dirty if the entry changed.
+	void set_datatype(const StringName &p_name, const String &p_path, const GDScriptParser::DataType &p_type, const Vector<String> &p_dependencies);
+
+	Error load(const String &p_path);
+	Error save(const String &p_path);
+	bool is_dirty() const;
+};
@@ -41,6 +41,14 @@
 #include "editor/settings/editor_settings.h"
 #endif
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GDSCRIPT_TOKENIZER_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define GDSCRIPT_TOKENIZER_NEON
+#endif
+
 static const char *token_names[] = {
 	"Empty", // EMPTY,
 	// Basic
@@ -335,6 +343,140 @@ char32_t GDScriptTokenizerText::_advance() {
 	return _peek(-1);
 }
 
+// Goblin: bulk scanning. Each character class below answers "how many leading
+// code units belong to the class"; the tokenizer then skips the whole run with
+// `_advance_run()`. Blocks of 16 code units (4 vectors of 4 `char32_t`) are
+// tested at once where SSE2/NEON exist; the first block that contains a
+// mismatch, and the tail, fall back to the scalar predicate, which stays the
+// single source of truth for where a run ends.
+
+namespace {
+
+// ASCII `[A-Za-z0-9_]`. Non-ASCII identifier characters stop the run and go
+// through `is_unicode_identifier_continue()` one at a time.
+struct ScanIdentifier {
+	_FORCE_INLINE_ bool match(char32_t c) const {
+		return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+	}
+#if defined(GDSCRIPT_TOKENIZER_SSE2)
+	_FORCE_INLINE_ __m128i match4(__m128i c) const {
+		const __m128i lower = _mm_or_si128(c, _mm_set1_epi32(0x20));
+		const __m128i alpha = _mm_and_si128(_mm_cmpgt_epi32(lower, _mm_set1_epi32('a' - 1)), _mm_cmplt_epi32(lower, _mm_set1_epi32('z' + 1)));
+		const __m128i digit = _mm_and_si128(_mm_cmpgt_epi32(c, _mm_set1_epi32('0' - 1)), _mm_cmplt_epi32(c, _mm_set1_epi32('9' + 1)));
+		return _mm_or_si128(_mm_or_si128(alpha, digit), _mm_cmpeq_epi32(c, _mm_set1_epi32('_')));
+	}
+#elif defined(GDSCRIPT_TOKENIZER_NEON)
+	_FORCE_INLINE_ uint32x4_t match4(uint32x4_t c) const {
+		const uint32x4_t lower = vorrq_u32(c, vdupq_n_u32(0x20));
+		const uint32x4_t alpha = vcltq_u32(vsubq_u32(lower, vdupq_n_u32('a')), vdupq_n_u32(26));
+		const uint32x4_t digit = vcltq_u32(vsubq_u32(c, vdupq_n_u32('0')), vdupq_n_u32(10));
+		return vorrq_u32(vorrq_u32(alpha, digit), vceqq_u32(c, vdupq_n_u32('_')));
+	}
+#endif
+};
+
+// Spaces and tabs inside a line (indentation is handled by `check_indent()`).
+struct ScanBlank {
+	_FORCE_INLINE_ bool match(char32_t c) const {
+		return c == ' ' || c == '\t';
+	}
+#if defined(GDSCRIPT_TOKENIZER_SSE2)
+	_FORCE_INLINE_ __m128i match4(__m128i c) const {
+		return _mm_or_si128(_mm_cmpeq_epi32(c, _mm_set1_epi32(' ')), _mm_cmpeq_epi32(c, _mm_set1_epi32('\t')));
+	}
+#elif defined(GDSCRIPT_TOKENIZER_NEON)
+	_FORCE_INLINE_ uint32x4_t match4(uint32x4_t c) const {
+		return vorrq_u32(vceqq_u32(c, vdupq_n_u32(' ')), vceqq_u32(c, vdupq_n_u32('\t')));
+	}
+#endif
+};
+
+// Comment body: everything up to (not including) the line feed.
+struct ScanCommentBody {
+	_FORCE_INLINE_ bool match(char32_t c) const {
+		return c != '\n';
+	}
+#if defined(GDSCRIPT_TOKENIZER_SSE2)
+	_FORCE_INLINE_ __m128i match4(__m128i c) const {
+		return _mm_xor_si128(_mm_cmpeq_epi32(c, _mm_set1_epi32('\n')), _mm_set1_epi32(-1));
+	}
+#elif defined(GDSCRIPT_TOKENIZER_NEON)
+	_FORCE_INLINE_ uint32x4_t match4(uint32x4_t c) const {
+		return vmvnq_u32(vceqq_u32(c, vdupq_n_u32('\n')));
+	}
+#endif
+};
+
+// String contents that need no special handling: not the quote, not an escape,
+// not a line feed (line counting), and below U+200E so the bidi-control check
+// in `string()` can never be skipped.
+struct ScanStringBody {
+	char32_t quote = 0;
+
+	_FORCE_INLINE_ bool match(char32_t c) const {
+		return c != quote && c != '\\' && c != '\n' && c < 0x200E;
+	}
+#if defined(GDSCRIPT_TOKENIZER_SSE2)
+	_FORCE_INLINE_ __m128i match4(__m128i c) const {
+		const __m128i special = _mm_or_si128(
+				_mm_or_si128(_mm_cmpeq_epi32(c, _mm_set1_epi32(int(quote))), _mm_cmpeq_epi32(c, _mm_set1_epi32('\\'))),
+				_mm_or_si128(_mm_cmpeq_epi32(c, _mm_set1_epi32('\n')), _mm_cmpgt_epi32(c, _mm_set1_epi32(0x200E - 1))));
+		return _mm_xor_si128(special, _mm_set1_epi32(-1));
+	}
+#elif defined(GDSCRIPT_TOKENIZER_NEON)
+	_FORCE_INLINE_ uint32x4_t match4(uint32x4_t c) const {
+		const uint32x4_t special = vorrq_u32(
+				vorrq_u32(vceqq_u32(c, vdupq_n_u32(quote)), vceqq_u32(c, vdupq_n_u32('\\'))),
+				vorrq_u32(vceqq_u32(c, vdupq_n_u32('\n')), vcgeq_u32(c, vdupq_n_u32(0x200E))));
+		return vmvnq_u32(special);
+	}
+#endif
+};
+
+template <typename T>
+int scan_run(const char32_t *p_from, int p_count, const T &p_class) {
+	int i = 0;
+#if defined(GDSCRIPT_TOKENIZER_SSE2)
+	for (; i + 16 <= p_count; i += 16) {
+		const __m128i *block = reinterpret_cast<const __m128i *>(p_from + i);
+		const __m128i all = _mm_and_si128(
+				_mm_and_si128(p_class.match4(_mm_loadu_si128(block)), p_class.match4(_mm_loadu_si128(block + 1))),
+				_mm_and_si128(p_class.match4(_mm_loadu_si128(block + 2)), p_class.match4(_mm_loadu_si128(block + 3))));
+		if (_mm_movemask_epi8(all) != 0xFFFF) {
+			break;
+		}
+	}
+#elif defined(GDSCRIPT_TOKENIZER_NEON)
+	for (; i + 16 <= p_count; i += 16) {
+		const uint32_t *block = reinterpret_cast<const uint32_t *>(p_from + i);
+		const uint32x4_t all = vandq_u32(
+				vandq_u32(p_class.match4(vld1q_u32(block)), p_class.match4(vld1q_u32(block + 4))),
+				vandq_u32(p_class.match4(vld1q_u32(block + 8)), p_class.match4(vld1q_u32(block + 12))));
+		if (vminvq_u32(all) == 0) {
+			break;
+		}
+	}
+#endif
+	while (i < p_count && p_class.match(p_from[i])) {
+		i++;
+	}
+	return i;
+}
+
+} // namespace
+
+void GDScriptTokenizerText::_advance_run(int p_count) {
+	// Only for runs without line feeds. The last character goes through
+	// `_advance()` so reaching the end of the source behaves as before.
+	if (p_count <= 0) {
+		return;
+	}
+	_current += p_count - 1;
+	column += p_count - 1;
+	position += p_count - 1;
+	_advance();
+}
+
 void GDScriptTokenizerText::push_paren(char32_t p_char) {
 	paren_stack.push_back(p_char);
 }
@@ -567,8 +709,16 @@ void GDScriptTokenizerText::make_keyword_list() {
 GDScriptTokenizer::Token GDScriptTokenizerText::potential_identifier() {
 	bool only_ascii = _peek(-1) < 128;
 
-	// Consume all identifier characters.
-	while (is_unicode_identifier_continue(_peek())) {
+	// Consume all identifier characters. ASCII runs are skipped in bulk.
+	for (;;) {
+		int run = scan_run(_current, length - position, ScanIdentifier());
+		if (run > 0) {
+			_advance_run(run);
+			continue;
+		}
+		if (!is_unicode_identifier_continue(_peek())) {
+			break;
+		}
 		char32_t c = _advance();
 		only_ascii = only_ascii && c < 128;
 	}
@@ -1094,6 +1244,13 @@ GDScriptTokenizer::Token GDScriptTokenizerText::string() {
 				push_error(error);
 				prev = 0;
 			}
+			int run = scan_run(_current, length - position, ScanStringBody{ quote_char });
+			if (run > 1) {
+				// Plain run: append it in one go.
+				result += String::utf32(Span(_current, run));
+				_advance_run(run);
+				continue;
+			}
 			result += ch;
 			_advance();
 			if (ch == '\n') {
@@ -1201,16 +1358,13 @@ void GDScriptTokenizerText::check_indent() {
 		}
 		if (_peek() == '#') {
 			// Comment. Advance to the next line.
+			int comment_length = scan_run(_current, length - position, ScanCommentBody());
 #ifdef TOOLS_ENABLED
-			String comment;
-			while (_peek() != '\n' && !_is_at_end()) {
-				comment += _advance();
-			}
+			String comment = String::utf32(Span(_current, comment_length));
+			_advance_run(comment_length);
 			comments[line] = CommentData(comment, true);
 #else
-			while (_peek() != '\n' && !_is_at_end()) {
-				_advance();
-			}
+			_advance_run(comment_length);
 #endif // TOOLS_ENABLED
 			if (_is_at_end()) {
 				// Reached the end with an empty line, so just dedent as much as needed.
@@ -1312,7 +1466,7 @@ void GDScriptTokenizerText::_skip_whitespace() {
 		switch (c) {
 			case ' ':
 			case '\t':
-				_advance();
+				_advance_run(scan_run(_current, length - position, ScanBlank()));
 				break;
 			case '\r':
 				_advance(); // Consume either way.
@@ -1328,16 +1482,13 @@ void GDScriptTokenizerText::_skip_whitespace() {
 				break;
 			case '#': {
 				// Comment.
+				int comment_length = scan_run(_current, length - position, ScanCommentBody());
 #ifdef TOOLS_ENABLED
-				String comment;
-				while (_peek() != '\n' && !_is_at_end()) {
-					comment += _advance();
-				}
+				String comment = String::utf32(Span(_current, comment_length));
+				_advance_run(comment_length);
 				comments[line] = CommentData(comment, is_bol);
 #else
-				while (_peek() != '\n' && !_is_at_end()) {
-					_advance();
-				}
+				_advance_run(comment_length);
 #endif // TOOLS_ENABLED
 				if (_is_at_end()) {
 					return;
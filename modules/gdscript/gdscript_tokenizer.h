@@ -303,6 +303,7 @@ class GDScriptTokenizerText : public GDScriptTokenizer {
 	bool has_error() const { return !error_stack.is_empty(); }
 	Token pop_error();
 	char32_t _advance();
+	void _advance_run(int p_count);
 	String _get_indent_char_name(char32_t ch);
 	void _skip_whitespace();
 	void check_indent();
@@ -33,16 +33,30 @@
 #include "core/io/compression.h"
 #include "core/io/marshalls.h"
 
-int GDScriptTokenizerBuffer::_token_to_binary(const Token &p_token, Vector<uint8_t> &r_buffer, int p_start, HashMap<StringName, uint32_t> &r_identifiers_map, HashMap<Variant, uint32_t> &r_constants_map) {
-	int pos = p_start;
-
-	int token_type = p_token.type & TOKEN_MASK;
+// Goblin: binary token layout, version 102. Everything after the 12-byte file
+// header ("GDSC", version, decompressed size or 0) is the contents block, all
+// fields little-endian uint32 and 4-byte aligned relative to the block start:
+//
+//   identifier_count, constant_count, line_count, token_count, constant_data_size
+//   identifier records  identifier_count * { offset, length } (UTF-32 code units)
+//   identifier data     UTF-32 code units, each byte XOR 0xb6
+//   constant offsets    constant_count * byte offset into the constant data
+//   constant data       encode_variant() payloads, padded to 4 bytes
+//   line records        line_count * { token index, line, column }, sorted by token index
+//   token records       token_count * { type | payload << TOKEN_BITS, line }
+//
+// The payload is the identifier index for IDENTIFIER/ANNOTATION tokens and the
+// constant index for LITERAL/ERROR tokens. Fixed-width records let the
+// tokenizer read token N directly from the buffer, so loading only validates.
+
+void GDScriptTokenizerBuffer::_token_to_binary(const Token &p_token, Vector<uint8_t> &r_buffer, HashMap<StringName, uint32_t> &r_identifiers_map, HashMap<Variant, uint32_t> &r_constants_map) {
+	uint32_t token_type = p_token.type & TOKEN_MASK;
 
 	switch (p_token.type) {
 		case GDScriptTokenizer::Token::ANNOTATION:
 		case GDScriptTokenizer::Token::IDENTIFIER: {
 			// Add identifier to map.
-			int identifier_pos;
+			uint32_t identifier_pos;
 			StringName id = p_token.get_identifier();
 			if (r_identifiers_map.has(id)) {
 				identifier_pos = r_identifiers_map[id];
@@ -55,7 +69,7 @@ int GDScriptTokenizerBuffer::_token_to_binary(const Token &p_token, Vector<uint8
 		case GDScriptTokenizer::Token::ERROR:
 		case GDScriptTokenizer::Token::LITERAL: {
 			// Add literal to map.
-			int constant_pos;
+			uint32_t constant_pos;
 			if (r_constants_map.has(p_token.literal)) {
 				constant_pos = r_constants_map[p_token.literal];
 			} else {
@@ -68,68 +82,71 @@ int GDScriptTokenizerBuffer::_token_to_binary(const Token &p_token, Vector<uint8
 			break;
 	}
 
-	// Encode token.
-	int token_len;
-	if (token_type & TOKEN_MASK) {
-		token_len = 8;
-		r_buffer.resize(pos + token_len);
-		encode_uint32(token_type | TOKEN_BYTE_MASK, &r_buffer.write[pos]);
-		pos += 4;
-	} else {
-		token_len = 5;
-		r_buffer.resize(pos + token_len);
-		r_buffer.write[pos] = token_type;
-		pos++;
+	int pos = r_buffer.size();
+	r_buffer.resize(pos + TOKEN_RECORD_SIZE);
+	encode_uint32(token_type, &r_buffer.write[pos]);
+	encode_uint32(p_token.start_line, &r_buffer.write[pos + 4]);
+}
+
+const StringName &GDScriptTokenizerBuffer::_get_identifier(uint32_t p_index) {
+	StringName &id = identifiers[p_index];
+	if (id == StringName()) {
+		const uint8_t *record = identifier_records + p_index * IDENTIFIER_RECORD_SIZE;
+		const uint32_t offset = decode_uint32(record);
+		const uint32_t len = decode_uint32(record + 4);
+		const uint8_t *b = identifier_data + offset * 4;
+
+		LocalVector<char32_t> cs;
+		cs.resize(len);
+		for (uint32_t j = 0; j < len; j++) {
+			uint8_t tmp[4];
+			for (uint32_t k = 0; k < 4; k++) {
+				tmp[k] = b[j * 4 + k] ^ 0xb6;
+			}
+			cs[j] = decode_uint32(tmp);
+		}
+		id = String::utf32(Span(cs.ptr(), len));
 	}
-	encode_uint32(p_token.start_line, &r_buffer.write[pos]);
-	return token_len;
+	return id;
 }
 
-GDScriptTokenizer::Token GDScriptTokenizerBuffer::_binary_to_token(const uint8_t *p_buffer) {
+const Variant &GDScriptTokenizerBuffer::_get_constant(uint32_t p_index) {
+	if (!constants_decoded[p_index]) {
+		// Offsets were validated in `set_code_buffer()`; the payload itself is checked here.
+		const uint32_t offset = decode_uint32(constant_offsets + p_index * 4);
+		int len = 0;
+		Error err = decode_variant(constants[p_index], constant_data + offset, constant_data_size - offset, &len, false);
+		if (unlikely(err != OK)) {
+			constants[p_index] = Variant();
+		}
+		constants_decoded[p_index] = 1;
+	}
+	return constants[p_index];
+}
+
+GDScriptTokenizer::Token GDScriptTokenizerBuffer::_binary_to_token(uint32_t p_index) {
 	Token token;
-	const uint8_t *b = p_buffer;
+	const uint8_t *b = token_records + p_index * TOKEN_RECORD_SIZE;
 
 	uint32_t token_type = decode_uint32(b);
 	token.type = (Token::Type)(token_type & TOKEN_MASK);
-	if (token_type & TOKEN_BYTE_MASK) {
-		b += 4;
-	} else {
-		b++;
-	}
-	token.start_line = decode_uint32(b);
+	token.start_line = decode_uint32(b + 4);
 	token.end_line = token.start_line;
 
-	token.literal = token.get_name();
-	if (token.type == Token::CONST_NAN) {
-		token.literal = String("NAN"); // Special case since name and notation are different.
-	}
-
 	switch (token.type) {
 		case GDScriptTokenizer::Token::ANNOTATION:
-		case GDScriptTokenizer::Token::IDENTIFIER: {
-			// Get name from map.
-			int identifier_pos = token_type >> TOKEN_BITS;
-			if (unlikely(identifier_pos >= identifiers.size())) {
-				Token error;
-				error.type = Token::ERROR;
-				error.literal = "Identifier index out of bounds.";
-				return error;
-			}
-			token.literal = identifiers[identifier_pos];
-		} break;
+		case GDScriptTokenizer::Token::IDENTIFIER:
+			token.literal = _get_identifier(token_type >> TOKEN_BITS);
+			break;
 		case GDScriptTokenizer::Token::ERROR:
-		case GDScriptTokenizer::Token::LITERAL: {
-			// Get literal from map.
-			int constant_pos = token_type >> TOKEN_BITS;
-			if (unlikely(constant_pos >= constants.size())) {
-				Token error;
-				error.type = Token::ERROR;
-				error.literal = "Constant index out of bounds.";
-				return error;
-			}
-			token.literal = constants[constant_pos];
-		} break;
+		case GDScriptTokenizer::Token::LITERAL:
+			token.literal = _get_constant(token_type >> TOKEN_BITS);
+			break;
+		case GDScriptTokenizer::Token::CONST_NAN:
+			token.literal = String("NAN"); // Special case since name and notation are different.
+			break;
 		default:
+			token.literal = token.get_name();
 			break;
 	}
 
@@ -138,101 +155,97 @@ GDScriptTokenizer::Token GDScriptTokenizerBuffer::_binary_to_token(const uint8_t
 
 Error GDScriptTokenizerBuffer::set_code_buffer(const Vector<uint8_t> &p_buffer) {
 	const uint8_t *buf = p_buffer.ptr();
-	ERR_FAIL_COND_V(p_buffer.size() < 12 || p_buffer[0] != 'G' || p_buffer[1] != 'D' || p_buffer[2] != 'S' || p_buffer[3] != 'C', ERR_INVALID_DATA);
+	ERR_FAIL_COND_V(p_buffer.size() < (int64_t)HEADER_SIZE || p_buffer[0] != 'G' || p_buffer[1] != 'D' || p_buffer[2] != 'S' || p_buffer[3] != 'C', ERR_INVALID_DATA);
 
 	int version = decode_uint32(&buf[4]);
 	ERR_FAIL_COND_V_MSG(version != TOKENIZER_VERSION, ERR_INVALID_DATA, "Binary GDScript is not compatible with this engine version.");
 
 	int decompressed_size = decode_uint32(&buf[8]);
 
-	Vector<uint8_t> contents;
+	uint32_t contents_offset = 0;
 	if (decompressed_size == 0) {
-		contents = p_buffer.slice(12);
+		// Uncompressed: share the caller's buffer, nothing is copied.
+		code_buffer = p_buffer;
+		contents_offset = HEADER_SIZE;
 	} else {
-		contents.resize(decompressed_size);
-		const int64_t result = Compression::decompress(contents.ptrw(), contents.size(), &buf[12], p_buffer.size() - 12, Compression::MODE_ZSTD);
+		code_buffer.resize(decompressed_size);
+		const int64_t result = Compression::decompress(code_buffer.ptrw(), code_buffer.size(), &buf[HEADER_SIZE], p_buffer.size() - HEADER_SIZE, Compression::MODE_ZSTD);
 		ERR_FAIL_COND_V_MSG(result != decompressed_size, ERR_INVALID_DATA, "Error decompressing GDScript tokenizer buffer.");
 	}
 
-	int total_len = contents.size();
-	buf = contents.ptr();
-	uint32_t identifier_count = decode_uint32(&buf[0]);
-	uint32_t constant_count = decode_uint32(&buf[4]);
-	uint32_t token_line_count = decode_uint32(&buf[8]);
-	uint32_t token_count = decode_uint32(&buf[12]);
+	const uint8_t *contents = code_buffer.ptr() + contents_offset;
+	const uint64_t total_len = code_buffer.size() - contents_offset;
+	ERR_FAIL_COND_V(total_len < CONTENTS_HEADER_SIZE, ERR_INVALID_DATA);
 
-	const uint8_t *b = &buf[16];
-	total_len -= 16;
+	identifier_count = decode_uint32(&contents[0]);
+	constant_count = decode_uint32(&contents[4]);
+	line_count = decode_uint32(&contents[8]);
+	token_count = decode_uint32(&contents[12]);
+	constant_data_size = decode_uint32(&contents[16]);
 
-	identifiers.resize(identifier_count);
-	for (uint32_t i = 0; i < identifier_count; i++) {
-		uint32_t len = decode_uint32(b);
-		total_len -= 4;
-		ERR_FAIL_COND_V((len * 4u) > (uint32_t)total_len, ERR_INVALID_DATA);
-		b += 4;
-		Vector<uint32_t> cs;
-		cs.resize(len);
-		for (uint32_t j = 0; j < len; j++) {
-			uint8_t tmp[4];
-			for (uint32_t k = 0; k < 4; k++) {
-				tmp[k] = b[j * 4 + k] ^ 0xb6;
-			}
-			cs.write[j] = decode_uint32(tmp);
-		}
+	// Walk the section sizes in 64-bit so corrupted counts cannot wrap around.
+	uint64_t pos = CONTENTS_HEADER_SIZE;
+
+	identifier_records = contents + pos;
+	pos += uint64_t(identifier_count) * IDENTIFIER_RECORD_SIZE;
+	ERR_FAIL_COND_V(pos > total_len, ERR_INVALID_DATA);
 
-		String s = String::utf32(Span(reinterpret_cast<const char32_t *>(cs.ptr()), len));
-		b += len * 4;
-		total_len -= len * 4;
-		identifiers.write[i] = s;
+	uint64_t identifier_data_len = 0;
+	for (uint32_t i = 0; i < identifier_count; i++) {
+		const uint8_t *record = identifier_records + i * IDENTIFIER_RECORD_SIZE;
+		identifier_data_len = MAX(identifier_data_len, uint64_t(decode_uint32(record)) + decode_uint32(record + 4));
 	}
+	identifier_data = contents + pos;
+	pos += identifier_data_len * 4;
+	ERR_FAIL_COND_V(pos > total_len, ERR_INVALID_DATA);
 
-	constants.resize(constant_count);
+	constant_offsets = contents + pos;
+	pos += uint64_t(constant_count) * 4;
+	ERR_FAIL_COND_V(pos > total_len, ERR_INVALID_DATA);
 	for (uint32_t i = 0; i < constant_count; i++) {
-		Variant v;
-		int len;
-		Error err = decode_variant(v, b, total_len, &len, false);
-		if (err) {
-			return err;
-		}
-		b += len;
-		total_len -= len;
-		constants.write[i] = v;
+		ERR_FAIL_COND_V(decode_uint32(constant_offsets + i * 4) >= constant_data_size, ERR_INVALID_DATA);
 	}
 
-	for (uint32_t i = 0; i < token_line_count; i++) {
-		ERR_FAIL_COND_V(total_len < 8, ERR_INVALID_DATA);
-		uint32_t token_index = decode_uint32(b);
-		b += 4;
-		uint32_t line = decode_uint32(b);
-		b += 4;
-		total_len -= 8;
-		token_lines[token_index] = line;
-	}
-	for (uint32_t i = 0; i < token_line_count; i++) {
-		ERR_FAIL_COND_V(total_len < 8, ERR_INVALID_DATA);
-		uint32_t token_index = decode_uint32(b);
-		b += 4;
-		uint32_t column = decode_uint32(b);
-		b += 4;
-		total_len -= 8;
-		token_columns[token_index] = column;
+	constant_data = contents + pos;
+	pos += (uint64_t(constant_data_size) + 3) & ~uint64_t(3);
+	ERR_FAIL_COND_V(pos > total_len, ERR_INVALID_DATA);
+
+	line_records = contents + pos;
+	pos += uint64_t(line_count) * LINE_RECORD_SIZE;
+	ERR_FAIL_COND_V(pos > total_len, ERR_INVALID_DATA);
+	for (uint32_t i = 1; i < line_count; i++) {
+		ERR_FAIL_COND_V(decode_uint32(line_records + i * LINE_RECORD_SIZE) <= decode_uint32(line_records + (i - 1) * LINE_RECORD_SIZE), ERR_INVALID_DATA);
 	}
 
-	tokens.resize(token_count);
+	token_records = contents + pos;
+	pos += uint64_t(token_count) * TOKEN_RECORD_SIZE;
+	ERR_FAIL_COND_V(pos != total_len, ERR_INVALID_DATA);
+	ERR_FAIL_COND_V(token_count > uint32_t(INT32_MAX), ERR_INVALID_DATA);
+
 	for (uint32_t i = 0; i < token_count; i++) {
-		int token_len = 5;
-		if ((*b) & TOKEN_BYTE_MASK) {
-			token_len = 8;
+		const uint32_t token_type = decode_uint32(token_records + i * TOKEN_RECORD_SIZE);
+		const uint32_t type = token_type & TOKEN_MASK;
+		ERR_FAIL_COND_V(type >= Token::TK_MAX, ERR_INVALID_DATA);
+		switch (type) {
+			case Token::ANNOTATION:
+			case Token::IDENTIFIER:
+				ERR_FAIL_COND_V_MSG((token_type >> TOKEN_BITS) >= identifier_count, ERR_INVALID_DATA, "Identifier index out of bounds.");
+				break;
+			case Token::ERROR:
+			case Token::LITERAL:
+				ERR_FAIL_COND_V_MSG((token_type >> TOKEN_BITS) >= constant_count, ERR_INVALID_DATA, "Constant index out of bounds.");
+				break;
+			default:
+				break;
 		}
-		ERR_FAIL_COND_V(total_len < token_len, ERR_INVALID_DATA);
-		Token token = _binary_to_token(b);
-		b += token_len;
-		ERR_FAIL_INDEX_V(token.type, Token::TK_MAX, ERR_INVALID_DATA);
-		tokens.write[i] = token;
-		total_len -= token_len;
 	}
 
-	ERR_FAIL_COND_V(total_len > 0, ERR_INVALID_DATA);
+	identifiers.resize(identifier_count);
+	constants.resize(constant_count);
+	constants_decoded.resize(constant_count);
+	if (constant_count > 0) {
+		memset(constants_decoded.ptr(), 0, constant_count);
+	}
 
 	return OK;
 }
@@ -248,13 +261,11 @@ Vector<uint8_t> GDScriptTokenizerBuffer::parse_code_string(const String &p_code,
 	tokenizer.set_source_code(p_code);
 	tokenizer.set_multiline_mode(true); // Ignore whitespace tokens.
 	Token current = tokenizer.scan();
-	int token_pos = 0;
 	int last_token_line = 0;
 	int token_counter = 0;
 
 	while (current.type != Token::TK_EOF) {
-		int token_len = _token_to_binary(current, token_buffer, token_pos, identifier_map, constant_map);
-		token_pos += token_len;
+		_token_to_binary(current, token_buffer, identifier_map, constant_map);
 		if (token_counter > 0 && current.start_line > last_token_line) {
 			token_lines[token_counter] = current.start_line;
 			token_columns[token_counter] = current.start_column;
@@ -289,70 +300,87 @@ Vector<uint8_t> GDScriptTokenizerBuffer::parse_code_string(const String &p_code,
 		}
 	}
 
-	Vector<uint8_t> contents;
-	contents.resize(16);
-	encode_uint32(identifier_map.size(), &contents.write[0]);
-	encode_uint32(constant_map.size(), &contents.write[4]);
-	encode_uint32(token_lines.size(), &contents.write[8]);
-	encode_uint32(token_counter, &contents.write[12]);
-
-	int buf_pos = 16;
-
-	// Save identifiers.
-	for (const StringName &id : rev_identifier_map) {
-		String s = id.operator String();
+	// Flat line table, sorted by token index so the reader can walk it with a cursor.
+	LocalVector<uint32_t> line_starts;
+	line_starts.reserve(token_lines.size());
+	for (const KeyValue<uint32_t, uint32_t> &E : token_lines) {
+		line_starts.push_back(E.key);
+	}
+	line_starts.sort();
+
+	// Identifiers: one record per identifier, code units concatenated.
+	Vector<uint8_t> identifier_records;
+	Vector<uint8_t> identifier_data;
+	identifier_records.resize(rev_identifier_map.size() * IDENTIFIER_RECORD_SIZE);
+	uint32_t identifier_offset = 0;
+	for (int i = 0; i < rev_identifier_map.size(); i++) {
+		String s = rev_identifier_map[i].operator String();
 		int len = s.length();
 
-		contents.resize(buf_pos + (len + 1) * 4);
+		encode_uint32(identifier_offset, &identifier_records.write[i * IDENTIFIER_RECORD_SIZE]);
+		encode_uint32(len, &identifier_records.write[i * IDENTIFIER_RECORD_SIZE + 4]);
 
-		encode_uint32(len, &contents.write[buf_pos]);
-		buf_pos += 4;
-
-		for (int i = 0; i < len; i++) {
+		int data_pos = identifier_data.size();
+		identifier_data.resize(data_pos + len * 4);
+		for (int j = 0; j < len; j++) {
 			uint8_t tmp[4];
-			encode_uint32(s[i], tmp);
+			encode_uint32(s[j], tmp);
 
 			for (int b = 0; b < 4; b++) {
-				contents.write[buf_pos + b] = tmp[b] ^ 0xb6;
+				identifier_data.write[data_pos + j * 4 + b] = tmp[b] ^ 0xb6;
 			}
-
-			buf_pos += 4;
 		}
+		identifier_offset += len;
 	}
 
-	// Save constants.
-	for (const Variant &v : rev_constant_map) {
+	// Constants: offset table + concatenated payloads.
+	Vector<uint8_t> constant_offsets;
+	Vector<uint8_t> constant_data;
+	constant_offsets.resize(rev_constant_map.size() * 4);
+	for (int i = 0; i < rev_constant_map.size(); i++) {
+		const Variant &v = rev_constant_map[i];
 		int len;
 		// Objects cannot be constant, never encode objects.
 		Error err = encode_variant(v, nullptr, len, false);
 		ERR_FAIL_COND_V_MSG(err != OK, Vector<uint8_t>(), "Error when trying to encode Variant.");
-		contents.resize(buf_pos + len);
-		encode_variant(v, &contents.write[buf_pos], len, false);
-		buf_pos += len;
+		int data_pos = constant_data.size();
+		encode_uint32(data_pos, &constant_offsets.write[i * 4]);
+		constant_data.resize(data_pos + len);
+		encode_variant(v, &constant_data.write[data_pos], len, false);
 	}
-
-	// Save lines and columns.
-	contents.resize(buf_pos + token_lines.size() * 16);
-	for (const KeyValue<uint32_t, uint32_t> &e : token_lines) {
-		encode_uint32(e.key, &contents.write[buf_pos]);
-		buf_pos += 4;
-		encode_uint32(e.value, &contents.write[buf_pos]);
-		buf_pos += 4;
+	const uint32_t constant_data_size = constant_data.size();
+	constant_data.resize((constant_data_size + 3) & ~3u);
+	for (int i = (int)constant_data_size; i < constant_data.size(); i++) {
+		constant_data.write[i] = 0;
 	}
-	for (const KeyValue<uint32_t, uint32_t> &e : token_columns) {
-		encode_uint32(e.key, &contents.write[buf_pos]);
-		buf_pos += 4;
-		encode_uint32(e.value, &contents.write[buf_pos]);
-		buf_pos += 4;
+
+	Vector<uint8_t> line_data;
+	line_data.resize(line_starts.size() * LINE_RECORD_SIZE);
+	for (uint32_t i = 0; i < line_starts.size(); i++) {
+		encode_uint32(line_starts[i], &line_data.write[i * LINE_RECORD_SIZE]);
+		encode_uint32(token_lines[line_starts[i]], &line_data.write[i * LINE_RECORD_SIZE + 4]);
+		encode_uint32(token_columns[line_starts[i]], &line_data.write[i * LINE_RECORD_SIZE + 8]);
 	}
 
-	// Store tokens.
+	Vector<uint8_t> contents;
+	contents.resize(CONTENTS_HEADER_SIZE);
+	encode_uint32(identifier_map.size(), &contents.write[0]);
+	encode_uint32(constant_map.size(), &contents.write[4]);
+	encode_uint32(line_starts.size(), &contents.write[8]);
+	encode_uint32(token_counter, &contents.write[12]);
+	encode_uint32(constant_data_size, &contents.write[16]);
+
+	contents.append_array(identifier_records);
+	contents.append_array(identifier_data);
+	contents.append_array(constant_offsets);
+	contents.append_array(constant_data);
+	contents.append_array(line_data);
 	contents.append_array(token_buffer);
 
 	Vector<uint8_t> buf;
 
 	// Save header.
-	buf.resize(12);
+	buf.resize(HEADER_SIZE);
 	buf.write[0] = 'G';
 	buf.write[1] = 'D';
 	buf.write[2] = 'S';
@@ -413,7 +441,7 @@ void GDScriptTokenizerBuffer::pop_expression_indented_block() {
 
 GDScriptTokenizer::Token GDScriptTokenizerBuffer::scan() {
 	// Add final newline.
-	if (current >= tokens.size() && !last_token_was_newline) {
+	if (current >= (int)token_count && !last_token_was_newline) {
 		Token newline;
 		newline.type = Token::NEWLINE;
 		newline.start_line = current_line;
@@ -439,7 +467,7 @@ GDScriptTokenizer::Token GDScriptTokenizerBuffer::scan() {
 		return dedent;
 	}
 
-	if (current >= tokens.size()) {
+	if (current >= (int)token_count) {
 		if (!indent_stack.is_empty()) {
 			pending_indents -= indent_stack.size();
 			indent_stack.clear();
@@ -452,9 +480,15 @@ GDScriptTokenizer::Token GDScriptTokenizerBuffer::scan() {
 		return eof;
 	};
 
-	if (!last_token_was_newline && token_lines.has(current)) {
-		current_line = token_lines[current];
-		uint32_t current_column = token_columns[current];
+	// Line records are passed once the token they start has been returned.
+	while (line_cursor < line_count && decode_uint32(line_records + line_cursor * LINE_RECORD_SIZE) < (uint32_t)current) {
+		line_cursor++;
+	}
+
+	if (!last_token_was_newline && line_cursor < line_count && decode_uint32(line_records + line_cursor * LINE_RECORD_SIZE) == (uint32_t)current) {
+		const uint8_t *line_record = line_records + line_cursor * LINE_RECORD_SIZE;
+		current_line = decode_uint32(line_record + 4);
+		uint32_t current_column = decode_uint32(line_record + 8);
 
 		// Check if there's a need to indent/dedent.
 		if (!multiline_mode) {
@@ -488,8 +522,7 @@ GDScriptTokenizer::Token GDScriptTokenizerBuffer::scan() {
 
 	last_token_was_newline = false;
 
-	Token token = tokens[current++];
-	return token;
+	return _binary_to_token(current++);
 }
 
 void GDScriptTokenizerBuffer::push_state() {
@@ -497,6 +530,7 @@ void GDScriptTokenizerBuffer::push_state() {
 	StateSnapshot &state = state_snapshot;
 	state.current = current;
 	state.current_line = current_line;
+	state.line_cursor = line_cursor;
 	state.multiline_mode = multiline_mode;
 	state.indent_stack = indent_stack;
 	state.indent_stack_stack = indent_stack_stack;
@@ -510,6 +544,7 @@ void GDScriptTokenizerBuffer::restore_state() {
 	const StateSnapshot &state = state_snapshot;
 	current = state.current;
 	current_line = state.current_line;
+	line_cursor = state.line_cursor;
 	multiline_mode = state.multiline_mode;
 	indent_stack = state.indent_stack;
 	indent_stack_stack = state.indent_stack_stack;
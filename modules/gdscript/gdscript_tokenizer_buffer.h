@@ -32,6 +32,8 @@
 
 #include "gdscript_tokenizer.h"
 
+#include "core/templates/local_vector.h"
+
 class GDScriptTokenizerBuffer : public GDScriptTokenizer {
 public:
 	enum CompressMode {
@@ -39,19 +41,41 @@ public:
 		COMPRESS_ZSTD,
 	};
 
-	static constexpr uint32_t TOKENIZER_VERSION = 101;
-	static constexpr uint32_t TOKEN_BYTE_MASK = 0x80;
+	// Goblin: version 102 is a flat, fixed-width layout read in place (see the
+	// layout comment in gdscript_tokenizer_buffer.cpp). Loading a script only
+	// validates bounds; tokens, line starts and constants are decoded on demand
+	// straight from the shared code buffer, identifiers are interned lazily.
+	static constexpr uint32_t TOKENIZER_VERSION = 102;
 	static constexpr uint32_t TOKEN_BITS = 8;
-	static constexpr uint32_t TOKEN_MASK = (1 << (TOKEN_BITS - 1)) - 1;
-
-	Vector<StringName> identifiers;
-	Vector<Variant> constants;
-	Vector<int> continuation_lines;
-	HashMap<int, int> token_lines;
-	HashMap<int, int> token_columns;
-	Vector<Token> tokens;
+	static constexpr uint32_t TOKEN_MASK = (1 << TOKEN_BITS) - 1;
+	static constexpr uint32_t HEADER_SIZE = 12;
+	static constexpr uint32_t CONTENTS_HEADER_SIZE = 20;
+	static constexpr uint32_t TOKEN_RECORD_SIZE = 8; // type | payload << TOKEN_BITS, line.
+	static constexpr uint32_t LINE_RECORD_SIZE = 12; // token index, line, column.
+	static constexpr uint32_t IDENTIFIER_RECORD_SIZE = 8; // offset (code units), length.
+
+	// Code buffer (decompressed if needed). Shared with the owning `GDScript`
+	// for uncompressed scripts, so the records below point into it without a copy.
+	Vector<uint8_t> code_buffer;
+	const uint8_t *token_records = nullptr;
+	const uint8_t *line_records = nullptr;
+	const uint8_t *identifier_records = nullptr;
+	const uint8_t *identifier_data = nullptr;
+	const uint8_t *constant_offsets = nullptr;
+	const uint8_t *constant_data = nullptr;
+	uint32_t token_count = 0;
+	uint32_t line_count = 0;
+	uint32_t identifier_count = 0;
+	uint32_t constant_count = 0;
+	uint32_t constant_data_size = 0;
+
+	LocalVector<StringName> identifiers; // Interned on first use.
+	LocalVector<Variant> constants; // Decoded on first use.
+	LocalVector<uint8_t> constants_decoded;
+
 	int current = 0;
 	uint32_t current_line = 1;
+	uint32_t line_cursor = 0; // First line record whose token index is not behind `current`.
 
 	bool multiline_mode = false;
 	List<int> indent_stack;
@@ -63,6 +87,7 @@ public:
 	struct StateSnapshot {
 		int current = 0;
 		uint32_t current_line = 1;
+		uint32_t line_cursor = 0;
 		bool multiline_mode = false;
 		List<int> indent_stack;
 		List<List<int>> indent_stack_stack;
@@ -76,8 +101,10 @@ public:
 	HashMap<int, CommentData> dummy;
 #endif // TOOLS_ENABLED
 
-	static int _token_to_binary(const Token &p_token, Vector<uint8_t> &r_buffer, int p_start, HashMap<StringName, uint32_t> &r_identifiers_map, HashMap<Variant, uint32_t> &r_constants_map);
-	Token _binary_to_token(const uint8_t *p_buffer);
+	static void _token_to_binary(const Token &p_token, Vector<uint8_t> &r_buffer, HashMap<StringName, uint32_t> &r_identifiers_map, HashMap<Variant, uint32_t> &r_constants_map);
+	Token _binary_to_token(uint32_t p_index);
+	const StringName &_get_identifier(uint32_t p_index);
+	const Variant &_get_constant(uint32_t p_index);
 
 public:
 	Error set_code_buffer(const Vector<uint8_t> &p_buffer);
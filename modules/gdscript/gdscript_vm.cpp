@@ -31,10 +31,13 @@
 #include "gdscript.h"
 #include "gdscript_function.h"
 #include "gdscript_lambda_callable.h"
+#include "gdscript_sampling_profiler.h"
+#include "gdscript_vm_stats.h"
 
 #include "core/object/class_db.h"
 #include "core/os/os.h"
 #include "core/profiling/profiling.h"
+#include "modules/goblin/frame_timeline.h"
 
 #ifdef DEBUG_ENABLED
 
@@ -372,6 +375,24 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_ITERATE_PACKED_VECTOR4_ARRAY, \
 		&&OPCODE_ITERATE_OBJECT, \
 		&&OPCODE_ITERATE_RANGE, \
+		&&OPCODE_ITERATE_BEGIN_TYPED_ARRAY_INT, \
+		&&OPCODE_ITERATE_BEGIN_TYPED_ARRAY_FLOAT, \
+		&&OPCODE_ITERATE_BEGIN_TYPED_ARRAY_VECTOR2, \
+		&&OPCODE_ITERATE_BEGIN_TYPED_ARRAY_VECTOR2I, \
+		&&OPCODE_ITERATE_BEGIN_TYPED_ARRAY_VECTOR3, \
+		&&OPCODE_ITERATE_BEGIN_TYPED_ARRAY_VECTOR3I, \
+		&&OPCODE_ITERATE_BEGIN_TYPED_ARRAY_VECTOR4, \
+		&&OPCODE_ITERATE_BEGIN_TYPED_ARRAY_COLOR, \
+		&&OPCODE_ITERATE_TYPED_ARRAY_INT, \
+		&&OPCODE_ITERATE_TYPED_ARRAY_FLOAT, \
+		&&OPCODE_ITERATE_TYPED_ARRAY_VECTOR2, \
+		&&OPCODE_ITERATE_TYPED_ARRAY_VECTOR2I, \
+		&&OPCODE_ITERATE_TYPED_ARRAY_VECTOR3, \
+		&&OPCODE_ITERATE_TYPED_ARRAY_VECTOR3I, \
+		&&OPCODE_ITERATE_TYPED_ARRAY_VECTOR4, \
+		&&OPCODE_ITERATE_TYPED_ARRAY_COLOR, \
+		&&OPCODE_ITERATE_BEGIN_DICTIONARY_KEY_VALUE, \
+		&&OPCODE_ITERATE_DICTIONARY_KEY_VALUE, \
 		&&OPCODE_STORE_GLOBAL, \
 		&&OPCODE_STORE_NAMED_GLOBAL, \
 		&&OPCODE_TYPE_ADJUST_BOOL, \
@@ -426,14 +447,19 @@ void (*type_init_function_table[])(Variant *) = {
 	OPSEXIT:
 #define OPCODES_OUT \
 	OPSOUT:
-#define OPCODE_SWITCH(m_test) goto *switch_table_ops[m_test];
+#define OPCODE_SWITCH(m_test) \
+	GDSCRIPT_VM_STATS_OPCODE(m_test); \
+	goto *switch_table_ops[m_test];
 
 #ifdef DEBUG_ENABLED
 #define DISPATCH_OPCODE \
 	last_opcode = _code_ptr[ip]; \
+	GDSCRIPT_VM_STATS_OPCODE(last_opcode); \
 	goto *switch_table_ops[last_opcode]
 #else // !DEBUG_ENABLED
-#define DISPATCH_OPCODE goto *switch_table_ops[_code_ptr[ip]]
+#define DISPATCH_OPCODE \
+	GDSCRIPT_VM_STATS_OPCODE(_code_ptr[ip]); \
+	goto *switch_table_ops[_code_ptr[ip]]
 #endif // DEBUG_ENABLED
 
 #define OPCODE_BREAK goto OPSEXIT
@@ -448,10 +474,13 @@ void (*type_init_function_table[])(Variant *) = {
 
 #ifdef _MSC_VER
 #define OPCODE_SWITCH(m_test) \
+	GDSCRIPT_VM_STATS_OPCODE(m_test); \
 	__assume(m_test <= OPCODE_END); \
 	switch (m_test)
 #else // !_MSC_VER
-#define OPCODE_SWITCH(m_test) switch (m_test)
+#define OPCODE_SWITCH(m_test) \
+	GDSCRIPT_VM_STATS_OPCODE(m_test); \
+	switch (m_test)
 #endif // _MSC_VER
 
 #define OPCODE_BREAK break
@@ -540,6 +569,7 @@ static Variant _normalize_shaped_dict_entry_value(const Variant &p_value, const
 
 Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_args, int p_argcount, Callable::CallError &r_err, CallState *p_state) {
 	GodotProfileZoneScript(this, source, name, name, _initial_line);
+	FrameTimelineScope timeline_scope("GDScript", name, source); // Goblin: timeline capture.
 
 	OPCODES_TABLE;
 
@@ -713,6 +743,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 	GDScriptLanguage::CallLevel call_level;
 	GDScriptLanguage::get_singleton()->enter_function(&call_level, p_instance, this, stack, &ip, &line);
+	if (unlikely(GDScriptSamplingProfiler::is_active()) && call_level.prev == nullptr) {
+		// Goblin: entered from the engine, ticks since the last sample were spent outside scripts.
+		GDScriptSamplingProfiler::sync_thread();
+	}
+	GDSCRIPT_VM_STATS_ENTER();
 
 #ifdef DEBUG_ENABLED
 #define GD_ERR_BREAK(m_cond) \
@@ -1258,6 +1293,8 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
+				GDSCRIPT_VM_STATS_SITE(ip, *index, *dst);
+
 				bool valid;
 				dst->set_named(*index, *value, valid);
 
@@ -1310,6 +1347,8 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
+				GDSCRIPT_VM_STATS_SITE(ip, *index, *src);
+
 				bool valid;
 #ifdef DEBUG_ENABLED
 				//allow better error message in cases where src and dst are the same stack position
@@ -2073,6 +2112,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GET_INSTRUCTION_ARG(base, argc);
 				Variant **argptrs = instruction_args;
 
+				// Keyed by the opcode position, `ip` already moved past the argument count and arguments.
+				GDSCRIPT_VM_STATS_SITE(ip - instr_arg_count - 1, *methodname, *base);
+
 #ifdef DEBUG_ENABLED
 				uint64_t call_time = 0;
 
@@ -3947,6 +3989,146 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			// Goblin: the iterator is a typed local of the element type, so elements are copied
+			// as raw values (no `Variant` assignment, no type adjust).
+#ifdef DEBUG_ENABLED
+#define CHECK_TYPED_ARRAY_ITERATION(m_array, m_var_type) \
+	if (unlikely(m_array->get_typed_builtin() != Variant::m_var_type)) { \
+		err_text = vformat(R"(Trying to iterate on an untyped array or one of type "%s" as "Array[%s]".)", Variant::get_type_name((Variant::Type)m_array->get_typed_builtin()), Variant::get_type_name(Variant::m_var_type)); \
+		OPCODE_BREAK; \
+	}
+#else
+#define CHECK_TYPED_ARRAY_ITERATION(m_array, m_var_type)
+#endif
+
+#define OPCODE_ITERATE_BEGIN_TYPED_ARRAY(m_var_type, m_get_func) \
+	OPCODE(OPCODE_ITERATE_BEGIN_TYPED_ARRAY_##m_var_type) { \
+		CHECK_SPACE(8); \
+		GET_VARIANT_PTR(counter, 0); \
+		GET_VARIANT_PTR(container, 1); \
+		const Array *array = VariantInternal::get_array((const Variant *)container); \
+		CHECK_TYPED_ARRAY_ITERATION(array, m_var_type); \
+		VariantInternal::initialize(counter, Variant::INT); \
+		*VariantInternal::get_int(counter) = 0; \
+		if (!array->is_empty()) { \
+			GET_VARIANT_PTR(iterator, 2); \
+			VariantInternal::initialize(iterator, Variant::m_var_type); \
+			*VariantInternal::m_get_func(iterator) = *VariantInternal::m_get_func(&(*array)[0]); \
+			ip += 5; \
+		} else { \
+			int jumpto = _code_ptr[ip + 4]; \
+			GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size); \
+			ip = jumpto; \
+		} \
+	} \
+	DISPATCH_OPCODE
+
+#define OPCODE_ITERATE_TYPED_ARRAY(m_var_type, m_get_func) \
+	OPCODE(OPCODE_ITERATE_TYPED_ARRAY_##m_var_type) { \
+		CHECK_SPACE(4); \
+		GET_VARIANT_PTR(counter, 0); \
+		GET_VARIANT_PTR(container, 1); \
+		const Array *array = VariantInternal::get_array((const Variant *)container); \
+		int64_t *idx = VariantInternal::get_int(counter); \
+		(*idx)++; \
+		if (*idx >= array->size()) { \
+			int jumpto = _code_ptr[ip + 4]; \
+			GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size); \
+			ip = jumpto; \
+		} else { \
+			GET_VARIANT_PTR(iterator, 2); \
+			*VariantInternal::m_get_func(iterator) = *VariantInternal::m_get_func(&(*array)[*idx]); \
+			ip += 5; \
+		} \
+	} \
+	DISPATCH_OPCODE
+
+			OPCODE_ITERATE_BEGIN_TYPED_ARRAY(INT, get_int);
+			OPCODE_ITERATE_BEGIN_TYPED_ARRAY(FLOAT, get_float);
+			OPCODE_ITERATE_BEGIN_TYPED_ARRAY(VECTOR2, get_vector2);
+			OPCODE_ITERATE_BEGIN_TYPED_ARRAY(VECTOR2I, get_vector2i);
+			OPCODE_ITERATE_BEGIN_TYPED_ARRAY(VECTOR3, get_vector3);
+			OPCODE_ITERATE_BEGIN_TYPED_ARRAY(VECTOR3I, get_vector3i);
+			OPCODE_ITERATE_BEGIN_TYPED_ARRAY(VECTOR4, get_vector4);
+			OPCODE_ITERATE_BEGIN_TYPED_ARRAY(COLOR, get_color);
+			OPCODE_ITERATE_TYPED_ARRAY(INT, get_int);
+			OPCODE_ITERATE_TYPED_ARRAY(FLOAT, get_float);
+			OPCODE_ITERATE_TYPED_ARRAY(VECTOR2, get_vector2);
+			OPCODE_ITERATE_TYPED_ARRAY(VECTOR2I, get_vector2i);
+			OPCODE_ITERATE_TYPED_ARRAY(VECTOR3, get_vector3);
+			OPCODE_ITERATE_TYPED_ARRAY(VECTOR3I, get_vector3i);
+			OPCODE_ITERATE_TYPED_ARRAY(VECTOR4, get_vector4);
+			OPCODE_ITERATE_TYPED_ARRAY(COLOR, get_color);
+
+#undef CHECK_TYPED_ARRAY_ITERATION
+
+			// Goblin: `for key, value in dict` walks the live dictionary like `for key in dict`
+			// (the counter holds the current key), and writes the value straight into its
+			// iterator, so the body needs no `dict[key]` subscript.
+			OPCODE(OPCODE_ITERATE_BEGIN_DICTIONARY_KEY_VALUE) {
+				CHECK_SPACE(6);
+
+				GET_VARIANT_PTR(counter, 0);
+				GET_VARIANT_PTR(container, 1);
+
+				if (unlikely(container->get_type() != Variant::DICTIONARY)) {
+#ifdef DEBUG_ENABLED
+					err_text = vformat(R"(Unable to iterate on key and value of a value of type "%s". A Dictionary is required.)", Variant::get_type_name(container->get_type()));
+					OPCODE_BREAK;
+#else
+					int jumpto = _code_ptr[ip + 5];
+					GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size);
+					ip = jumpto;
+					DISPATCH_OPCODE;
+#endif
+				}
+
+				const Dictionary *dict = VariantInternal::get_dictionary((const Variant *)container);
+				const Variant *next = dict->next(nullptr);
+
+				if (next) {
+					GET_VARIANT_PTR(key_iterator, 2);
+					GET_VARIANT_PTR(value_iterator, 3);
+					*counter = *next;
+					*key_iterator = *next;
+					*value_iterator = *dict->getptr(*next);
+
+					// Skip regular iterate.
+					ip += 6;
+				} else {
+					// Jump to end of loop.
+					int jumpto = _code_ptr[ip + 5];
+					GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size);
+					ip = jumpto;
+				}
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_ITERATE_DICTIONARY_KEY_VALUE) {
+				CHECK_SPACE(6);
+
+				GET_VARIANT_PTR(counter, 0);
+				GET_VARIANT_PTR(container, 1);
+
+				const Dictionary *dict = VariantInternal::get_dictionary((const Variant *)container);
+				const Variant *next = dict->next(counter);
+
+				if (!next) {
+					int jumpto = _code_ptr[ip + 5];
+					GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size);
+					ip = jumpto;
+				} else {
+					GET_VARIANT_PTR(key_iterator, 2);
+					GET_VARIANT_PTR(value_iterator, 3);
+					*counter = *next;
+					*key_iterator = *next;
+					*value_iterator = *dict->getptr(*next);
+
+					ip += 6; // Loop again.
+				}
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_STORE_GLOBAL) {
 				CHECK_SPACE(3);
 				int global_idx = _code_ptr[ip + 2];
@@ -4066,6 +4248,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			OPCODE(OPCODE_LINE) {
 				CHECK_SPACE(2);
 
+				// Goblin: sample before `line` moves on, so elapsed ticks are charged to the line that used them.
+				if (GDScriptSamplingProfiler::is_sample_pending()) {
+					GDScriptSamplingProfiler::take_sample();
+				}
+
 				line = _code_ptr[ip + 1];
 				ip += 2;
 
@@ -0,0 +1,367 @@
+/**************************************************************************/
+/*  gdscript_vm_stats.cpp                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                            GOBLIN ENGINE                               */
+/**************************************************************************/
+
+#include "gdscript_vm_stats.h"
+
+#ifdef GDSCRIPT_VM_STATS
+
+#include "gdscript.h"
+
+#include "core/io/file_access.h"
+#include "core/object/callable_mp.h"
+#include "core/os/os.h"
+#include "core/string/string_builder.h"
+#include "core/templates/local_vector.h"
+#include "main/performance.h"
+
+// Must follow `GDScriptFunction::Opcode`.
+static const char *opcode_names[] = {
+	"OPERATOR",
+	"OPERATOR_VALIDATED",
+	"TYPE_TEST_BUILTIN",
+	"TYPE_TEST_ARRAY",
+	"TYPE_TEST_DICTIONARY",
+	"TYPE_TEST_NATIVE",
+	"TYPE_TEST_SCRIPT",
+	"SET_KEYED",
+	"SET_KEYED_VALIDATED",
+	"SET_INDEXED_VALIDATED",
+	"GET_KEYED",
+	"GET_KEYED_VALIDATED",
+	"GET_INDEXED_VALIDATED",
+	"SET_NAMED",
+	"SET_NAMED_VALIDATED",
+	"GET_NAMED",
+	"GET_NAMED_VALIDATED",
+	"SET_MEMBER",
+	"GET_MEMBER",
+	"SET_STATIC_VARIABLE",
+	"GET_STATIC_VARIABLE",
+	"ASSIGN",
+	"ASSIGN_NULL",
+	"ASSIGN_TRUE",
+	"ASSIGN_FALSE",
+	"ASSIGN_TYPED_BUILTIN",
+	"ASSIGN_TYPED_ARRAY",
+	"ASSIGN_TYPED_DICTIONARY",
+	"ASSIGN_TYPED_NATIVE",
+	"ASSIGN_TYPED_SCRIPT",
+	"CAST_TO_BUILTIN",
+	"CAST_TO_NATIVE",
+	"CAST_TO_SCRIPT",
+	"CONSTRUCT",
+	"CONSTRUCT_VALIDATED",
+	"CONSTRUCT_ARRAY",
+	"CONSTRUCT_TYPED_ARRAY",
+	"CONSTRUCT_DICTIONARY",
+	"CONSTRUCT_TYPED_DICTIONARY",
+	"CONSTRUCT_SHAPED_DICTIONARY",
+	"CALL",
+	"CALL_RETURN",
+	"CALL_ASYNC",
+	"CALL_UTILITY",
+	"CALL_UTILITY_VALIDATED",
+	"CALL_GDSCRIPT_UTILITY",
+	"CALL_BUILTIN_TYPE_VALIDATED",
+	"CALL_SELF_BASE",
+	"CALL_METHOD_BIND",
+	"CALL_METHOD_BIND_RET",
+	"CALL_BUILTIN_STATIC",
+	"CALL_NATIVE_STATIC",
+	"CALL_NATIVE_STATIC_VALIDATED_RETURN",
+	"CALL_NATIVE_STATIC_VALIDATED_NO_RETURN",
+	"CALL_METHOD_BIND_VALIDATED_RETURN",
+	"CALL_METHOD_BIND_VALIDATED_NO_RETURN",
+	"AWAIT",
+	"AWAIT_RESUME",
+	"CREATE_LAMBDA",
+	"CREATE_SELF_LAMBDA",
+	"JUMP",
+	"JUMP_IF",
+	"JUMP_IF_NOT",
+	"JUMP_TO_DEF_ARGUMENT",
+	"JUMP_IF_SHARED",
+	"RETURN",
+	"RETURN_TYPED_BUILTIN",
+	"RETURN_TYPED_ARRAY",
+	"RETURN_TYPED_DICTIONARY",
+	"RETURN_TYPED_NATIVE",
+	"RETURN_TYPED_SCRIPT",
+	"ITERATE_BEGIN",
+	"ITERATE_BEGIN_INT",
+	"ITERATE_BEGIN_FLOAT",
+	"ITERATE_BEGIN_VECTOR2",
+	"ITERATE_BEGIN_VECTOR2I",
+	"ITERATE_BEGIN_VECTOR3",
+	"ITERATE_BEGIN_VECTOR3I",
+	"ITERATE_BEGIN_STRING",
+	"ITERATE_BEGIN_DICTIONARY",
+	"ITERATE_BEGIN_ARRAY",
+	"ITERATE_BEGIN_PACKED_BYTE_ARRAY",
+	"ITERATE_BEGIN_PACKED_INT32_ARRAY",
+	"ITERATE_BEGIN_PACKED_INT64_ARRAY",
+	"ITERATE_BEGIN_PACKED_FLOAT32_ARRAY",
+	"ITERATE_BEGIN_PACKED_FLOAT64_ARRAY",
+	"ITERATE_BEGIN_PACKED_STRING_ARRAY",
+	"ITERATE_BEGIN_PACKED_VECTOR2_ARRAY",
+	"ITERATE_BEGIN_PACKED_VECTOR3_ARRAY",
+	"ITERATE_BEGIN_PACKED_COLOR_ARRAY",
+	"ITERATE_BEGIN_PACKED_VECTOR4_ARRAY",
+	"ITERATE_BEGIN_OBJECT",
+	"ITERATE_BEGIN_RANGE",
+	"ITERATE",
+	"ITERATE_INT",
+	"ITERATE_FLOAT",
+	"ITERATE_VECTOR2",
+	"ITERATE_VECTOR2I",
+	"ITERATE_VECTOR3",
+	"ITERATE_VECTOR3I",
+	"ITERATE_STRING",
+	"ITERATE_DICTIONARY",
+	"ITERATE_ARRAY",
+	"ITERATE_PACKED_BYTE_ARRAY",
+	"ITERATE_PACKED_INT32_ARRAY",
+	"ITERATE_PACKED_INT64_ARRAY",
+	"ITERATE_PACKED_FLOAT32_ARRAY",
+	"ITERATE_PACKED_FLOAT64_ARRAY",
+	"ITERATE_PACKED_STRING_ARRAY",
+	"ITERATE_PACKED_VECTOR2_ARRAY",
+	"ITERATE_PACKED_VECTOR3_ARRAY",
+	"ITERATE_PACKED_COLOR_ARRAY",
+	"ITERATE_PACKED_VECTOR4_ARRAY",
+	"ITERATE_OBJECT",
+	"ITERATE_RANGE",
+	"ITERATE_BEGIN_TYPED_ARRAY_INT",
+	"ITERATE_BEGIN_TYPED_ARRAY_FLOAT",
+	"ITERATE_BEGIN_TYPED_ARRAY_VECTOR2",
+	"ITERATE_BEGIN_TYPED_ARRAY_VECTOR2I",
+	"ITERATE_BEGIN_TYPED_ARRAY_VECTOR3",
+	"ITERATE_BEGIN_TYPED_ARRAY_VECTOR3I",
+	"ITERATE_BEGIN_TYPED_ARRAY_VECTOR4",
+	"ITERATE_BEGIN_TYPED_ARRAY_COLOR",
+	"ITERATE_TYPED_ARRAY_INT",
+	"ITERATE_TYPED_ARRAY_FLOAT",
+	"ITERATE_TYPED_ARRAY_VECTOR2",
+	"ITERATE_TYPED_ARRAY_VECTOR2I",
+	"ITERATE_TYPED_ARRAY_VECTOR3",
+	"ITERATE_TYPED_ARRAY_VECTOR3I",
+	"ITERATE_TYPED_ARRAY_VECTOR4",
+	"ITERATE_TYPED_ARRAY_COLOR",
+	"ITERATE_BEGIN_DICTIONARY_KEY_VALUE",
+	"ITERATE_DICTIONARY_KEY_VALUE",
+	"STORE_GLOBAL",
+	"STORE_NAMED_GLOBAL",
+	"TYPE_ADJUST_BOOL",
+	"TYPE_ADJUST_INT",
+	"TYPE_ADJUST_FLOAT",
+	"TYPE_ADJUST_STRING",
+	"TYPE_ADJUST_VECTOR2",
+	"TYPE_ADJUST_VECTOR2I",
+	"TYPE_ADJUST_RECT2",
+	"TYPE_ADJUST_RECT2I",
+	"TYPE_ADJUST_VECTOR3",
+	"TYPE_ADJUST_VECTOR3I",
+	"TYPE_ADJUST_TRANSFORM2D",
+	"TYPE_ADJUST_VECTOR4",
+	"TYPE_ADJUST_VECTOR4I",
+	"TYPE_ADJUST_PLANE",
+	"TYPE_ADJUST_QUATERNION",
+	"TYPE_ADJUST_AABB",
+	"TYPE_ADJUST_BASIS",
+	"TYPE_ADJUST_TRANSFORM3D",
+	"TYPE_ADJUST_PROJECTION",
+	"TYPE_ADJUST_COLOR",
+	"TYPE_ADJUST_STRING_NAME",
+	"TYPE_ADJUST_NODE_PATH",
+	"TYPE_ADJUST_RID",
+	"TYPE_ADJUST_OBJECT",
+	"TYPE_ADJUST_CALLABLE",
+	"TYPE_ADJUST_SIGNAL",
+	"TYPE_ADJUST_DICTIONARY",
+	"TYPE_ADJUST_ARRAY",
+	"TYPE_ADJUST_PACKED_BYTE_ARRAY",
+	"TYPE_ADJUST_PACKED_INT32_ARRAY",
+	"TYPE_ADJUST_PACKED_INT64_ARRAY",
+	"TYPE_ADJUST_PACKED_FLOAT32_ARRAY",
+	"TYPE_ADJUST_PACKED_FLOAT64_ARRAY",
+	"TYPE_ADJUST_PACKED_STRING_ARRAY",
+	"TYPE_ADJUST_PACKED_VECTOR2_ARRAY",
+	"TYPE_ADJUST_PACKED_VECTOR3_ARRAY",
+	"TYPE_ADJUST_PACKED_COLOR_ARRAY",
+	"TYPE_ADJUST_PACKED_VECTOR4_ARRAY",
+	"ASSERT",
+	"BREAKPOINT",
+	"LINE",
+	"END",
+};
+static_assert(sizeof(opcode_names) / sizeof(opcode_names[0]) == GDScriptFunction::OPCODE_END + 1, "Opcode name table out of sync with GDScriptFunction::Opcode.");
+
+const char *GDScriptVMStats::get_opcode_name(int p_opcode) {
+	ERR_FAIL_INDEX_V(p_opcode, OPCODE_COUNT, "?");
+	return opcode_names[p_opcode];
+}
+
+uint64_t GDScriptVMStats::_get_total_opcodes() {
+	return total_opcodes.get();
+}
+
+int GDScriptVMStats::_get_polymorphic_sites() {
+	MutexLock lock(sites_mutex);
+	int count = 0;
+	for (const KeyValue<SiteKey, Site> &E : sites) {
+		count += E.value.receivers.size() > 1;
+	}
+	return count;
+}
+
+void GDScriptVMStats::init() {
+	for (const String &arg : OS::get_singleton()->get_cmdline_user_args()) {
+		if (arg == "--gdscript-vm-stats") {
+			output_path = "user://gdscript_vm_stats.txt";
+		} else if (arg.begins_with("--gdscript-vm-stats=")) {
+			output_path = arg.substr(arg.find_char('=') + 1);
+		}
+	}
+
+	Performance *performance = Performance::get_singleton();
+	if (performance != nullptr) {
+		performance->add_custom_monitor("GDScript/VM/opcodes_executed", callable_mp_static(&GDScriptVMStats::_get_total_opcodes), Vector<Variant>());
+		performance->add_custom_monitor("GDScript/VM/polymorphic_sites", callable_mp_static(&GDScriptVMStats::_get_polymorphic_sites), Vector<Variant>());
+	}
+}
+
+void GDScriptVMStats::finish() {
+	if (output_path.is_empty()) {
+		return;
+	}
+	if (save(output_path) == OK) {
+		print_line(vformat("GDScript VM stats written to \"%s\".", output_path));
+	}
+}
+
+void GDScriptVMStats::record_site(const GDScriptFunction *p_function, int p_ip, const StringName &p_name, const Variant &p_receiver) {
+	StringName receiver;
+	if (p_receiver.get_type() == Variant::OBJECT) {
+		Object *obj = p_receiver.get_validated_object();
+		if (obj == nullptr) {
+			receiver = "<freed>";
+		} else {
+			Ref<Script> scr = obj->get_script();
+			receiver = scr.is_valid() && !scr->get_path().is_empty() ? StringName(scr->get_path()) : obj->get_class_name();
+		}
+	} else {
+		receiver = Variant::get_type_name(p_receiver.get_type());
+	}
+
+	MutexLock lock(sites_mutex);
+	SiteKey key{ p_function, p_ip };
+	Site *site = sites.getptr(key);
+	if (site == nullptr) {
+		site = &sites.insert(key, Site())->value;
+		site->location = vformat("%s:%s @%d", p_function->get_script()->get_script_path(), p_function->get_name(), p_ip);
+		site->opcode = p_function->_code_ptr[p_ip];
+		site->name = p_name;
+	}
+	site->receivers[receiver]++;
+}
+
+void GDScriptVMStats::forget_function(const GDScriptFunction *p_function) {
+	MutexLock lock(sites_mutex);
+	LocalVector<SiteKey> removed;
+	for (const KeyValue<SiteKey, Site> &E : sites) {
+		if (E.key.function == p_function) {
+			removed.push_back(E.key);
+		}
+	}
+	for (const SiteKey &key : removed) {
+		sites.erase(key);
+	}
+}
+
+void GDScriptVMStats::reset() {
+	for (int i = 0; i < OPCODE_COUNT; i++) {
+		opcode_counts[i].set(0);
+		for (int j = 0; j < OPCODE_COUNT; j++) {
+			bigram_counts[i][j].set(0);
+		}
+	}
+	total_opcodes.set(0);
+
+	MutexLock lock(sites_mutex);
+	sites.clear();
+}
+
+String GDScriptVMStats::report(int p_top) {
+	struct Entry {
+		String label;
+		uint64_t count = 0;
+		bool operator<(const Entry &p_other) const { return count > p_other.count; }
+	};
+
+	const uint64_t total = MAX(total_opcodes.get(), (uint64_t)1);
+	StringBuilder out;
+
+	LocalVector<Entry> opcodes;
+	LocalVector<Entry> bigrams;
+	for (int i = 0; i < OPCODE_COUNT; i++) {
+		if (opcode_counts[i].get() > 0) {
+			opcodes.push_back({ opcode_names[i], opcode_counts[i].get() });
+		}
+		for (int j = 0; j < OPCODE_COUNT; j++) {
+			if (bigram_counts[i][j].get() > 0) {
+				bigrams.push_back({ vformat("%s -> %s", opcode_names[i], opcode_names[j]), bigram_counts[i][j].get() });
+			}
+		}
+	}
+	opcodes.sort();
+	bigrams.sort();
+
+	out += vformat("== Opcodes (%d executed) ==\n", total_opcodes.get());
+	for (const Entry &E : opcodes) {
+		out += vformat("%6.2f%% %12d  %s\n", 100.0 * E.count / total, E.count, E.label);
+	}
+
+	out += vformat("\n== Top %d bigrams ==\n", p_top);
+	for (uint32_t i = 0; i < bigrams.size() && (int)i < p_top; i++) {
+		out += vformat("%6.2f%% %12d  %s\n", 100.0 * bigrams[i].count / total, bigrams[i].count, bigrams[i].label);
+	}
+
+	LocalVector<Entry> polymorphic;
+	{
+		MutexLock lock(sites_mutex);
+		for (const KeyValue<SiteKey, Site> &E : sites) {
+			if (E.value.receivers.size() < 2) {
+				continue;
+			}
+			uint64_t hits = 0;
+			String receivers;
+			for (const KeyValue<StringName, uint64_t> &R : E.value.receivers) {
+				hits += R.value;
+				receivers += vformat(" %s=%d", R.key, R.value);
+			}
+			polymorphic.push_back({ vformat("%s %s '%s' (%d types):%s", E.value.location, opcode_names[E.value.opcode], E.value.name, E.value.receivers.size(), receivers), hits });
+		}
+	}
+	polymorphic.sort();
+
+	out += vformat("\n== Polymorphic GET_NAMED/SET_NAMED/CALL sites (%d) ==\n", polymorphic.size());
+	for (const Entry &E : polymorphic) {
+		out += vformat("%12d  %s\n", E.count, E.label);
+	}
+
+	return out.as_string();
+}
+
+Error GDScriptVMStats::save(const String &p_path) {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(f.is_null(), err, "GDScript VM stats: Can't write " + p_path);
+	f->store_string(report());
+	return OK;
+}
+
+#endif // GDSCRIPT_VM_STATS
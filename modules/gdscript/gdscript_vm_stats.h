@@ -0,0 +1,106 @@
+/**************************************************************************/
+/*  gdscript_vm_stats.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                            GOBLIN ENGINE                               */
+/**************************************************************************/
+
+#pragma once
+
+// Opt-in VM instrumentation, compiled only with `scons gdscript_vm_stats=yes` (defines
+// `GDSCRIPT_VM_STATS`). Without it this header declares nothing and the VM hooks expand
+// to nothing, so the normal dispatch path is unchanged.
+//
+// Collected: executed opcodes, opcode bigrams (within one function activation), per-instruction
+// execution counts (shown by the disassembler), and the receiver types seen at every
+// `GET_NAMED`/`SET_NAMED`/`CALL` site. Dumped at exit with `++ --gdscript-vm-stats[=<path>]`,
+// and summarized through `GDScript/VM/*` Performance monitors.
+
+#ifdef GDSCRIPT_VM_STATS
+
+#include "gdscript_function.h"
+
+#include "core/os/mutex.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/safe_refcount.h"
+
+class GDScriptVMStats {
+	static constexpr int OPCODE_COUNT = GDScriptFunction::OPCODE_END + 1;
+
+	static inline SafeNumeric<uint64_t> opcode_counts[OPCODE_COUNT];
+	static inline SafeNumeric<uint64_t> bigram_counts[OPCODE_COUNT][OPCODE_COUNT];
+	static inline SafeNumeric<uint64_t> total_opcodes;
+	static inline thread_local int previous_opcode = -1;
+
+	struct SiteKey {
+		const GDScriptFunction *function = nullptr;
+		int ip = 0;
+
+		bool operator==(const SiteKey &p_other) const { return function == p_other.function && ip == p_other.ip; }
+		static uint32_t hash(const SiteKey &p_key) { return hash_murmur3_one_32(p_key.ip, hash_murmur3_one_64((uint64_t)p_key.function)); }
+	};
+
+	struct Site {
+		String location; // "script:function @ip", resolved once so it survives the function.
+		int opcode = 0;
+		StringName name;
+		HashMap<StringName, uint64_t> receivers;
+	};
+
+	static inline Mutex sites_mutex;
+	static inline HashMap<SiteKey, Site, SiteKey> sites;
+	static inline String output_path;
+
+	static uint64_t _get_total_opcodes();
+	static int _get_polymorphic_sites();
+
+public:
+	static const char *get_opcode_name(int p_opcode);
+
+	// Reads `--gdscript-vm-stats[=<path>]` and registers the Performance monitors.
+	static void init();
+	// Writes the report if requested on the command line.
+	static void finish();
+
+	// Bigrams stay within one activation: the caller's previous opcode is kept in its frame
+	// while a call runs, and restored when the call returns.
+	class FunctionScope {
+		int caller_opcode;
+
+	public:
+		_FORCE_INLINE_ FunctionScope() {
+			caller_opcode = previous_opcode;
+			previous_opcode = -1;
+		}
+		_FORCE_INLINE_ ~FunctionScope() { previous_opcode = caller_opcode; }
+	};
+
+	_FORCE_INLINE_ static void record_opcode(const GDScriptFunction *p_function, int p_ip, int p_opcode) {
+		opcode_counts[p_opcode].increment();
+		total_opcodes.increment();
+		if (previous_opcode >= 0) {
+			bigram_counts[previous_opcode][p_opcode].increment();
+		}
+		previous_opcode = p_opcode;
+		// Racy across threads by design; a lost increment does not matter for coverage.
+		p_function->vm_stats_ip_counts[p_ip]++;
+	}
+	static void record_site(const GDScriptFunction *p_function, int p_ip, const StringName &p_name, const Variant &p_receiver);
+	static void forget_function(const GDScriptFunction *p_function);
+
+	static void reset();
+	static String report(int p_top = 50);
+	static Error save(const String &p_path);
+};
+
+#define GDSCRIPT_VM_STATS_ENTER() GDScriptVMStats::FunctionScope vm_stats_scope
+#define GDSCRIPT_VM_STATS_OPCODE(m_op) GDScriptVMStats::record_opcode(this, ip, m_op)
+#define GDSCRIPT_VM_STATS_SITE(m_ip, m_name, m_receiver) GDScriptVMStats::record_site(this, m_ip, m_name, m_receiver)
+
+#else // !GDSCRIPT_VM_STATS
+
+#define GDSCRIPT_VM_STATS_ENTER()
+#define GDSCRIPT_VM_STATS_OPCODE(m_op)
+#define GDSCRIPT_VM_STATS_SITE(m_ip, m_name, m_receiver)
+
+#endif // GDSCRIPT_VM_STATS
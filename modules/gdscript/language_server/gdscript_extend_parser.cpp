@@ -965,15 +965,23 @@ Dictionary ExtendGDScriptParser::generate_api() const {
 }
 
 void ExtendGDScriptParser::parse(const String &p_code, const String &p_path) {
+	parse_code(p_code, p_path);
+	analyze_code(p_code);
+}
+
+void ExtendGDScriptParser::parse_code(const String &p_code, const String &p_path) {
 	path = p_path;
 	lines = p_code.split("\n");
 
 	parse_result = GDScriptParser::parse(p_code, p_path, false);
-	GDScriptAnalyzer analyzer(this);
+}
 
+void ExtendGDScriptParser::analyze_code(const String &p_code) {
+	GDScriptAnalyzer analyzer(this);
 	if (parse_result == OK) {
 		parse_result = analyzer.analyze();
 	}
+
 	update_diagnostics();
 	update_symbols();
 	update_document_links(p_code);
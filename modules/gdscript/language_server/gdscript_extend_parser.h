@@ -164,4 +164,12 @@ public:
 	Dictionary generate_api() const;
 
 	void parse(const String &p_code, const String &p_path);
+
+	// Goblin: `parse()` split in two so the language server can tokenize and parse on a worker.
+	// `parse_code()` only touches this parser. `analyze_code()` runs the analyzer, which resolves
+	// dependencies through the shared `GDScriptCache` parsers and can load resources, then builds
+	// diagnostics, symbols and links, which may query the language protocol; it must run on the
+	// thread that owns the protocol.
+	void parse_code(const String &p_code, const String &p_path);
+	void analyze_code(const String &p_code);
 };
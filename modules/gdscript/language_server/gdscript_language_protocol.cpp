@@ -56,6 +56,25 @@
 
 GDScriptLanguageProtocol *GDScriptLanguageProtocol::singleton = nullptr;
 
+// Goblin: LSP positions index code points within a line, same as `GodotPosition`.
+// Out of range positions are clamped to the end of the line/document.
+static int _lsp_position_to_offset(const String &p_text, const LSP::Position &p_pos) {
+	const int length = p_text.length();
+	int offset = 0;
+	for (int line = 0; line < p_pos.line; line++) {
+		int next = p_text.find_char('\n', offset);
+		if (next == -1) {
+			return length;
+		}
+		offset = next + 1;
+	}
+	int line_end = p_text.find_char('\n', offset);
+	if (line_end == -1) {
+		line_end = length;
+	}
+	return MIN(offset + MAX(p_pos.character, 0), line_end);
+}
+
 Error GDScriptLanguageProtocol::LSPeer::handle_data() {
 	int read = 0;
 	// Read headers
@@ -308,6 +327,11 @@ void GDScriptLanguageProtocol::poll(int p_limit_usec) {
 	HashMap<int, Ref<LSPeer>>::Iterator E = clients.begin();
 	while (E != clients.end()) {
 		Ref<LSPeer> peer = E->value;
+
+		// Goblin: install background analysis results. Diagnostics go to the peer that owns them.
+		latest_client_id = E->key;
+		peer->poll_pending_parses();
+
 		peer->connection->poll();
 		StreamPeerTCP::Status status = peer->connection->get_status();
 		if (status == StreamPeerTCP::STATUS_NONE || status == StreamPeerTCP::STATUS_ERROR) {
@@ -431,6 +455,7 @@ ExtendGDScriptParser *GDScriptLanguageProtocol::LSPeer::parse_script(const Strin
 	parser->parse(content, p_path);
 
 	if (document != nullptr) {
+		GDScriptLanguageProtocol::get_singleton()->get_workspace()->update_index(p_path, content);
 		GDScriptLanguageProtocol::get_singleton()->get_workspace()->publish_diagnostics(p_path);
 	} else {
 		// Don't keep cached for further requests since we can't invalidate the cache properly.
@@ -447,6 +472,8 @@ void GDScriptLanguageProtocol::LSPeer::clear_stale_parsers() {
 }
 
 void GDScriptLanguageProtocol::LSPeer::remove_cached_parser(const String &p_path) {
+	_cancel_pending_parse(p_path);
+
 	HashMap<String, ExtendGDScriptParser *>::Iterator cached = parse_results.find(p_path);
 	if (cached) {
 		memdelete(cached->value);
@@ -456,9 +483,165 @@ void GDScriptLanguageProtocol::LSPeer::remove_cached_parser(const String &p_path
 	stale_parsers.erase(p_path);
 }
 
+void GDScriptLanguageProtocol::LSPeer::_pending_parse_task(void *p_userdata) {
+	PendingParse *pending = static_cast<PendingParse *>(p_userdata);
+	pending->parser->parse_code(pending->code, pending->path);
+}
+
+void GDScriptLanguageProtocol::LSPeer::_start_pending_parse(const String &p_path) {
+	const LSP::TextDocumentItem *document = managed_files.getptr(p_path);
+	ERR_FAIL_NULL(document);
+	if (document->languageId != LSP::LanguageId::GDSCRIPT) {
+		return;
+	}
+
+	PendingParse *pending = memnew(PendingParse);
+	pending->parser = memnew(ExtendGDScriptParser);
+	pending->path = p_path;
+	pending->code = document->text;
+	const uint64_t *revision = document_revisions.getptr(p_path);
+	pending->revision = revision != nullptr ? *revision : 0;
+	pending->task_id = WorkerThreadPool::get_singleton()->add_native_task(&LSPeer::_pending_parse_task, pending, false, "GDScript LSP analysis");
+	pending_parses[p_path] = pending;
+}
+
+ExtendGDScriptParser *GDScriptLanguageProtocol::LSPeer::_collect_pending_parse(PendingParse *p_pending) {
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(p_pending->task_id);
+
+	ExtendGDScriptParser *parser = p_pending->parser;
+	const uint64_t *revision = document_revisions.getptr(p_pending->path);
+	if (p_pending->cancelled.is_set() || revision == nullptr || *revision != p_pending->revision) {
+		memdelete(parser);
+		parser = nullptr;
+	}
+	memdelete(p_pending);
+	return parser;
+}
+
+void GDScriptLanguageProtocol::LSPeer::_install_parse_result(const String &p_path, ExtendGDScriptParser *p_parser) {
+	HashMap<String, ExtendGDScriptParser *>::Iterator cached = parse_results.find(p_path);
+	if (cached) {
+		memdelete(cached->value);
+		cached->value = p_parser;
+	} else {
+		parse_results[p_path] = p_parser;
+	}
+	stale_parsers.erase(p_path);
+
+	const String &code = managed_files[p_path].text;
+	p_parser->analyze_code(code);
+	GDScriptLanguageProtocol::get_singleton()->get_workspace()->update_index(p_path, code);
+	GDScriptLanguageProtocol::get_singleton()->get_workspace()->publish_diagnostics(p_path);
+}
+
+void GDScriptLanguageProtocol::LSPeer::_cancel_pending_parse(const String &p_path) {
+	HashMap<String, PendingParse *>::Iterator E = pending_parses.find(p_path);
+	if (!E) {
+		return;
+	}
+	PendingParse *pending = E->value;
+	pending_parses.remove(E);
+
+	pending->cancelled.set();
+	if (WorkerThreadPool::get_singleton()->is_task_completed(pending->task_id)) {
+		_ALLOW_DISCARD_ _collect_pending_parse(pending);
+	} else {
+		abandoned_parses.push_back(pending);
+	}
+}
+
+void GDScriptLanguageProtocol::LSPeer::_reap_abandoned_parses(bool p_wait) {
+	for (uint32_t i = 0; i < abandoned_parses.size();) {
+		PendingParse *pending = abandoned_parses[i];
+		if (p_wait || WorkerThreadPool::get_singleton()->is_task_completed(pending->task_id)) {
+			_ALLOW_DISCARD_ _collect_pending_parse(pending);
+			abandoned_parses.remove_at_unordered(i);
+		} else {
+			i++;
+		}
+	}
+}
+
+void GDScriptLanguageProtocol::LSPeer::schedule_parse(const String &p_path) {
+	PendingParse **pending = pending_parses.getptr(p_path);
+	if (pending != nullptr) {
+		// The in-flight parse is discarded when it completes: `poll_pending_parses()` restarts
+		// it with the latest text once the worker has let go of it.
+		(*pending)->cancelled.set();
+		return;
+	}
+	_start_pending_parse(p_path);
+}
+
+void GDScriptLanguageProtocol::LSPeer::poll_pending_parses() {
+	_reap_abandoned_parses(false);
+	if (pending_parses.is_empty()) {
+		return;
+	}
+
+	LocalVector<String> finished;
+	for (const KeyValue<String, PendingParse *> &E : pending_parses) {
+		if (WorkerThreadPool::get_singleton()->is_task_completed(E.value->task_id)) {
+			finished.push_back(E.key);
+		}
+	}
+
+	for (const String &path : finished) {
+		PendingParse *pending = pending_parses[path];
+		pending_parses.erase(path);
+
+		ExtendGDScriptParser *parser = _collect_pending_parse(pending);
+		if (parser != nullptr) {
+			_install_parse_result(path, parser);
+		} else if (managed_files.has(path)) {
+			// Superseded by a newer edit.
+			_start_pending_parse(path);
+		}
+	}
+}
+
+void GDScriptLanguageProtocol::LSPeer::finish_pending_parse(const String &p_path) {
+	HashMap<String, PendingParse *>::Iterator E = pending_parses.find(p_path);
+	if (!E) {
+		return;
+	}
+	PendingParse *pending = E->value;
+	pending_parses.remove(E);
+
+	ExtendGDScriptParser *parser = _collect_pending_parse(pending);
+	if (parser != nullptr) {
+		_install_parse_result(p_path, parser);
+	} else {
+		// The text changed while the task ran; a request has to see the current text, so catch up here.
+		parse_script(p_path);
+	}
+}
+
+void GDScriptLanguageProtocol::LSPeer::finish_pending_parses() {
+	LocalVector<String> paths;
+	for (const KeyValue<String, PendingParse *> &E : pending_parses) {
+		paths.push_back(E.key);
+	}
+	for (const String &path : paths) {
+		finish_pending_parse(path);
+	}
+}
+
+void GDScriptLanguageProtocol::finish_pending_parse(const String &p_path) {
+	LSP_CLIENT;
+	client->finish_pending_parse(p_path);
+}
+
+void GDScriptLanguageProtocol::finish_pending_parses() {
+	LSP_CLIENT;
+	client->finish_pending_parses();
+}
+
 ExtendGDScriptParser *GDScriptLanguageProtocol::get_parse_result(const String &p_path) {
 	LSP_CLIENT_V(nullptr);
 
+	client->finish_pending_parse(p_path);
+
 	ExtendGDScriptParser **cached_parser = client->parse_results.getptr(p_path);
 	if (cached_parser == nullptr) {
 		return client->parse_script(p_path);
@@ -510,12 +693,28 @@ void GDScriptLanguageProtocol::lsp_did_change(const Dictionary &p_params) {
 		return;
 	}
 
-	// We only support TextDocumentSyncKind::Full. So only the last full text is relevant.
-	LSP::TextDocumentContentChangeEvent event;
-	event.load(contentChanges.back());
-	document->text = event.text;
+	// Goblin: we advertise TextDocumentSyncKind::Incremental, so changes are applied in order.
+	// A change without a range replaces the whole document.
+	String text = document->text;
+	for (int i = 0; i < contentChanges.size(); i++) {
+		LSP::TextDocumentContentChangeEvent event;
+		event.load(contentChanges[i]);
+		if (!event.has_range) {
+			text = event.text;
+			continue;
+		}
+		int from = _lsp_position_to_offset(text, event.range.start);
+		int to = MAX(from, _lsp_position_to_offset(text, event.range.end));
+		text = text.substr(0, from) + event.text + text.substr(to);
+	}
 
-	client->parse_script(path);
+	if (text == document->text) {
+		return;
+	}
+	document->text = text;
+
+	client->document_revisions[path]++;
+	client->schedule_parse(path);
 }
 
 void GDScriptLanguageProtocol::lsp_did_close(const Dictionary &p_params) {
@@ -528,6 +727,11 @@ void GDScriptLanguageProtocol::lsp_did_close(const Dictionary &p_params) {
 	bool was_opened = client->managed_files.erase(path);
 
 	client->remove_cached_parser(path);
+	client->document_revisions.erase(path);
+	if (was_opened && path.has_extension("gd")) {
+		// Unsaved edits are dropped with the buffer, the file on disk is authoritative again.
+		get_workspace()->refresh_index(path);
+	}
 
 	/// A close notification requires a previous open notification to be sent.
 	ERR_FAIL_COND_MSG(!was_opened, "LSP: Client is closing file without opening it.");
@@ -633,7 +837,7 @@ void GDScriptLanguageProtocol::resolve_related_symbols(const LSP::TextDocumentPo
 	LSP::Range range;
 	symbol_name = parser->get_symbol_name_under_position(p_doc_pos.position, range);
 
-	for (const KeyValue<StringName, ClassMembers> &E : workspace->native_members) {
+	for (const KeyValue<StringName, ClassMembers> &E : workspace->get_native_members()) {
 		if (const LSP::DocumentSymbol *const *symbol = E.value.getptr(symbol_name)) {
 			r_list.push_back(*symbol);
 		}
@@ -656,6 +860,10 @@ void GDScriptLanguageProtocol::resolve_related_symbols(const LSP::TextDocumentPo
 }
 
 GDScriptLanguageProtocol::LSPeer::~LSPeer() {
+	while (!pending_parses.is_empty()) {
+		_cancel_pending_parse(pending_parses.begin()->key);
+	}
+	_reap_abandoned_parses(true);
 	while (!parse_results.is_empty()) {
 		String path = parse_results.begin()->key;
 		remove_cached_parser(path);
@@ -36,6 +36,9 @@
 
 #include "core/io/stream_peer_tcp.h"
 #include "core/io/tcp_server.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 
 #include "modules/jsonrpc/jsonrpc.h"
 
@@ -86,9 +89,44 @@ private:
 		void remove_cached_parser(const String &p_path);
 		ExtendGDScriptParser *parse_script(const String &p_path);
 
+		// Goblin: bumped on every edit of a managed document. A background result is only
+		// installed if it was produced from the current revision.
+		HashMap<String, uint64_t> document_revisions;
+
+		// Goblin: edits are parsed on the `WorkerThreadPool`. `schedule_parse()` supersedes any
+		// in-flight work for the path, `poll_pending_parses()` analyzes and installs finished
+		// results and `finish_pending_parse()` makes the cached result current before a request
+		// reads it. Only the parse runs on the worker: the analyzer shares dependency parsers
+		// through `GDScriptCache` and can load resources, so it runs here, on the polling thread.
+		// A task only touches its own parser, so waiting for one is safe.
+		void schedule_parse(const String &p_path);
+		void poll_pending_parses();
+		void finish_pending_parse(const String &p_path);
+		void finish_pending_parses();
+
 		~LSPeer();
 
 	private:
+		struct PendingParse {
+			ExtendGDScriptParser *parser = nullptr;
+			String path;
+			String code;
+			uint64_t revision = 0;
+			SafeFlag cancelled;
+			WorkerThreadPool::TaskID task_id = WorkerThreadPool::INVALID_TASK_ID;
+		};
+
+		HashMap<String, PendingParse *> pending_parses;
+		LocalVector<PendingParse *> abandoned_parses; // Cancelled, freed once their parse completes.
+
+		static void _pending_parse_task(void *p_userdata);
+		void _start_pending_parse(const String &p_path);
+		// Waits for the task and returns its parser if it is still current, otherwise frees it.
+		ExtendGDScriptParser *_collect_pending_parse(PendingParse *p_pending);
+		void _install_parse_result(const String &p_path, ExtendGDScriptParser *p_parser);
+		void _cancel_pending_parse(const String &p_path);
+		void _reap_abandoned_parses(bool p_wait);
+
 		void clear_stale_parsers();
 		// Paths of parsers which we can't cache longterm.
 		// Can be cleared up using `clear_stale_parsers()`.
@@ -167,6 +205,13 @@ public:
 	 */
 	ExtendGDScriptParser *get_parse_result(const String &p_path);
 
+	/**
+	 * Goblin: makes the parse result and the workspace index of the given path, or of every
+	 * document with an edit under analysis, current without parsing anything else.
+	 */
+	void finish_pending_parse(const String &p_path);
+	void finish_pending_parses();
+
 	GDScriptLanguageProtocol();
 	~GDScriptLanguageProtocol() {
 		clients.clear();
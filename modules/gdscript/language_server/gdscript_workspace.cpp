@@ -34,10 +34,14 @@
 #include "../gdscript_parser.h"
 #include "gdscript_language_protocol.h"
 
+#include "core/config/engine.h"
 #include "core/config/project_settings.h"
 #include "core/object/callable_mp.h"
 #include "core/object/class_db.h"
 #include "core/object/script_language.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
+#include "core/version.h"
 #include "editor/doc/doc_tools.h"
 #include "editor/doc/editor_help.h"
 #include "editor/editor_node.h"
@@ -110,13 +114,13 @@ void GDScriptWorkspace::apply_new_signal(Object *obj, String function, PackedStr
 	GDScriptLanguageProtocol::get_singleton()->request_client("workspace/applyEdit", params.to_json());
 }
 
-const LSP::DocumentSymbol *GDScriptWorkspace::get_native_symbol(const String &p_class, const String &p_member) const {
+const LSP::DocumentSymbol *GDScriptWorkspace::get_native_symbol(const String &p_class, const String &p_member) {
 	StringName class_name = p_class;
 	StringName empty;
 
 	while (class_name != empty) {
-		if (HashMap<StringName, LSP::DocumentSymbol>::ConstIterator E = native_symbols.find(class_name)) {
-			const LSP::DocumentSymbol &class_symbol = E->value;
+		if (const LSP::DocumentSymbol *class_symbol_ptr = _get_native_class_symbol(class_name, EditorHelp::get_doc_data())) {
+			const LSP::DocumentSymbol &class_symbol = *class_symbol_ptr;
 
 			if (p_member.is_empty()) {
 				return &class_symbol;
@@ -230,138 +234,344 @@ void GDScriptWorkspace::list_script_files(const String &p_root_dir, List<String>
 
 #define HANDLE_DOC(m_string) ((is_native ? DTR(m_string) : (m_string)).strip_edges())
 
-Error GDScriptWorkspace::initialize() {
-	if (initialized) {
-		return OK;
+static LSP::DocumentSymbol _make_native_class_symbol(const String &p_class_name, const DocData::ClassDoc &p_class_data) {
+	const bool is_native = !p_class_data.is_script_doc;
+	LSP::DocumentSymbol class_symbol;
+	class_symbol.name = p_class_name;
+	class_symbol.native_class = p_class_name;
+	class_symbol.kind = LSP::SymbolKind::Class;
+	class_symbol.detail = String("<Native> class ") + p_class_name;
+	if (!p_class_data.inherits.is_empty()) {
+		class_symbol.detail += " extends " + p_class_data.inherits;
+	}
+	class_symbol.documentation = HANDLE_DOC(p_class_data.brief_description) + "\n" + HANDLE_DOC(p_class_data.description);
+
+	for (int i = 0; i < p_class_data.constants.size(); i++) {
+		const DocData::ConstantDoc &const_data = p_class_data.constants[i];
+		LSP::DocumentSymbol symbol;
+		symbol.name = const_data.name;
+		symbol.native_class = p_class_name;
+		symbol.kind = LSP::SymbolKind::Constant;
+		symbol.detail = "const " + p_class_name + "." + const_data.name;
+		if (const_data.enumeration.length()) {
+			symbol.detail += ": " + const_data.enumeration;
+		}
+		symbol.detail += " = " + const_data.value;
+		symbol.documentation = HANDLE_DOC(const_data.description);
+		class_symbol.children.push_back(symbol);
 	}
 
-	DocTools *doc = EditorHelp::get_doc_data();
-	for (const KeyValue<String, DocData::ClassDoc> &E : doc->class_list) {
-		const DocData::ClassDoc &class_data = E.value;
-		const bool is_native = !class_data.is_script_doc;
-		LSP::DocumentSymbol class_symbol;
-		String class_name = E.key;
-		class_symbol.name = class_name;
-		class_symbol.native_class = class_name;
-		class_symbol.kind = LSP::SymbolKind::Class;
-		class_symbol.detail = String("<Native> class ") + class_name;
-		if (!class_data.inherits.is_empty()) {
-			class_symbol.detail += " extends " + class_data.inherits;
-		}
-		class_symbol.documentation = HANDLE_DOC(class_data.brief_description) + "\n" + HANDLE_DOC(class_data.description);
-
-		for (int i = 0; i < class_data.constants.size(); i++) {
-			const DocData::ConstantDoc &const_data = class_data.constants[i];
-			LSP::DocumentSymbol symbol;
-			symbol.name = const_data.name;
-			symbol.native_class = class_name;
-			symbol.kind = LSP::SymbolKind::Constant;
-			symbol.detail = "const " + class_name + "." + const_data.name;
-			if (const_data.enumeration.length()) {
-				symbol.detail += ": " + const_data.enumeration;
+	for (int i = 0; i < p_class_data.properties.size(); i++) {
+		const DocData::PropertyDoc &data = p_class_data.properties[i];
+		LSP::DocumentSymbol symbol;
+		symbol.name = data.name;
+		symbol.native_class = p_class_name;
+		symbol.kind = LSP::SymbolKind::Property;
+		symbol.detail = "var " + p_class_name + "." + data.name;
+		if (data.enumeration.length()) {
+			symbol.detail += ": " + data.enumeration;
+		} else {
+			symbol.detail += ": " + data.type;
+		}
+		symbol.documentation = HANDLE_DOC(data.description);
+		class_symbol.children.push_back(symbol);
+	}
+
+	for (int i = 0; i < p_class_data.theme_properties.size(); i++) {
+		const DocData::ThemeItemDoc &data = p_class_data.theme_properties[i];
+		LSP::DocumentSymbol symbol;
+		symbol.name = data.name;
+		symbol.native_class = p_class_name;
+		symbol.kind = LSP::SymbolKind::Property;
+		symbol.detail = "<Theme> var " + p_class_name + "." + data.name + ": " + data.type;
+		symbol.documentation = HANDLE_DOC(data.description);
+		class_symbol.children.push_back(symbol);
+	}
+
+	Vector<DocData::MethodDoc> method_likes;
+	method_likes.append_array(p_class_data.methods);
+	method_likes.append_array(p_class_data.annotations);
+	const int constructors_start_idx = method_likes.size();
+	method_likes.append_array(p_class_data.constructors);
+	const int operator_start_idx = method_likes.size();
+	method_likes.append_array(p_class_data.operators);
+	const int signal_start_idx = method_likes.size();
+	method_likes.append_array(p_class_data.signals);
+
+	for (int i = 0; i < method_likes.size(); i++) {
+		const DocData::MethodDoc &data = method_likes[i];
+
+		LSP::DocumentSymbol symbol;
+		symbol.name = data.name;
+		symbol.native_class = p_class_name;
+
+		if (i >= signal_start_idx) {
+			symbol.kind = LSP::SymbolKind::Event;
+		} else if (i >= operator_start_idx) {
+			symbol.kind = LSP::SymbolKind::Operator;
+		} else if (i >= constructors_start_idx) {
+			symbol.kind = LSP::SymbolKind::Constructor;
+		} else {
+			symbol.kind = LSP::SymbolKind::Method;
+		}
+
+		String params = "";
+		bool arg_default_value_started = false;
+		for (int j = 0; j < data.arguments.size(); j++) {
+			const DocData::ArgumentDoc &arg = data.arguments[j];
+
+			LSP::DocumentSymbol symbol_arg;
+			symbol_arg.name = arg.name;
+			symbol_arg.kind = LSP::SymbolKind::Variable;
+			symbol_arg.detail = arg.type;
+
+			if (!arg_default_value_started && !arg.default_value.is_empty()) {
+				arg_default_value_started = true;
 			}
-			symbol.detail += " = " + const_data.value;
-			symbol.documentation = HANDLE_DOC(const_data.description);
-			class_symbol.children.push_back(symbol);
-		}
-
-		for (int i = 0; i < class_data.properties.size(); i++) {
-			const DocData::PropertyDoc &data = class_data.properties[i];
-			LSP::DocumentSymbol symbol;
-			symbol.name = data.name;
-			symbol.native_class = class_name;
-			symbol.kind = LSP::SymbolKind::Property;
-			symbol.detail = "var " + class_name + "." + data.name;
-			if (data.enumeration.length()) {
-				symbol.detail += ": " + data.enumeration;
-			} else {
-				symbol.detail += ": " + data.type;
+			String arg_str = arg.name + ": " + arg.type;
+			if (arg_default_value_started) {
+				arg_str += " = " + arg.default_value;
 			}
-			symbol.documentation = HANDLE_DOC(data.description);
-			class_symbol.children.push_back(symbol);
-		}
-
-		for (int i = 0; i < class_data.theme_properties.size(); i++) {
-			const DocData::ThemeItemDoc &data = class_data.theme_properties[i];
-			LSP::DocumentSymbol symbol;
-			symbol.name = data.name;
-			symbol.native_class = class_name;
-			symbol.kind = LSP::SymbolKind::Property;
-			symbol.detail = "<Theme> var " + class_name + "." + data.name + ": " + data.type;
-			symbol.documentation = HANDLE_DOC(data.description);
-			class_symbol.children.push_back(symbol);
-		}
-
-		Vector<DocData::MethodDoc> method_likes;
-		method_likes.append_array(class_data.methods);
-		method_likes.append_array(class_data.annotations);
-		const int constructors_start_idx = method_likes.size();
-		method_likes.append_array(class_data.constructors);
-		const int operator_start_idx = method_likes.size();
-		method_likes.append_array(class_data.operators);
-		const int signal_start_idx = method_likes.size();
-		method_likes.append_array(class_data.signals);
-
-		for (int i = 0; i < method_likes.size(); i++) {
-			const DocData::MethodDoc &data = method_likes[i];
-
-			LSP::DocumentSymbol symbol;
-			symbol.name = data.name;
-			symbol.native_class = class_name;
-
-			if (i >= signal_start_idx) {
-				symbol.kind = LSP::SymbolKind::Event;
-			} else if (i >= operator_start_idx) {
-				symbol.kind = LSP::SymbolKind::Operator;
-			} else if (i >= constructors_start_idx) {
-				symbol.kind = LSP::SymbolKind::Constructor;
-			} else {
-				symbol.kind = LSP::SymbolKind::Method;
+			if (j < data.arguments.size() - 1) {
+				arg_str += ", ";
 			}
+			params += arg_str;
 
-			String params = "";
-			bool arg_default_value_started = false;
-			for (int j = 0; j < data.arguments.size(); j++) {
-				const DocData::ArgumentDoc &arg = data.arguments[j];
+			symbol.children.push_back(symbol_arg);
+		}
+		if (data.qualifiers.contains("vararg")) {
+			params += params.is_empty() ? "..." : ", ...";
+		}
 
-				LSP::DocumentSymbol symbol_arg;
-				symbol_arg.name = arg.name;
-				symbol_arg.kind = LSP::SymbolKind::Variable;
-				symbol_arg.detail = arg.type;
+		String return_type = data.return_type;
+		if (return_type.is_empty()) {
+			return_type = "void";
+		}
+		symbol.detail = "func " + p_class_name + "." + data.name + "(" + params + ") -> " + return_type;
+		symbol.documentation = HANDLE_DOC(data.description);
+		class_symbol.children.push_back(symbol);
+	}
 
-				if (!arg_default_value_started && !arg.default_value.is_empty()) {
-					arg_default_value_started = true;
-				}
-				String arg_str = arg.name + ": " + arg.type;
-				if (arg_default_value_started) {
-					arg_str += " = " + arg.default_value;
-				}
-				if (j < data.arguments.size() - 1) {
-					arg_str += ", ";
-				}
-				params += arg_str;
+	return class_symbol;
+}
 
-				symbol.children.push_back(symbol_arg);
-			}
-			if (data.qualifiers.contains("vararg")) {
-				params += params.is_empty() ? "..." : ", ...";
-			}
+/*
+ * Goblin: native symbol cache layout (little endian, `FileAccess` encoding):
+ *   u32 magic ("GDNS"), u32 version, pascal string key, u32 class count
+ *   per class: symbol
+ *   symbol:    pascal string name, detail, documentation, native class, u8 kind,
+ *              u32 child count + symbols
+ * Only classes documented by the engine and extensions are stored; script docs change as
+ * the project is edited and are always built from the doc data.
+ */
 
-			String return_type = data.return_type;
-			if (return_type.is_empty()) {
-				return_type = "void";
+static constexpr int MAX_NATIVE_SYMBOL_DEPTH = 4; // Class, member, argument.
+
+String GDScriptWorkspace::get_native_symbols_cache_path() {
+	return ProjectSettings::get_singleton()->get_project_data_path().path_join("goblin_lsp_native_symbols.bin");
+}
+
+static uint32_t _hash_method_doc(const DocData::MethodDoc &p_method, uint32_t p_hash) {
+	p_hash = hash_murmur3_one_32(p_method.name.hash(), p_hash);
+	p_hash = hash_murmur3_one_32(p_method.return_type.hash(), p_hash);
+	p_hash = hash_murmur3_one_32(p_method.qualifiers.hash(), p_hash);
+	p_hash = hash_murmur3_one_32(p_method.description.hash(), p_hash);
+	for (const DocData::ArgumentDoc &argument : p_method.arguments) {
+		p_hash = hash_murmur3_one_32(argument.name.hash(), p_hash);
+		p_hash = hash_murmur3_one_32(argument.type.hash(), p_hash);
+		p_hash = hash_murmur3_one_32(argument.default_value.hash(), p_hash);
+	}
+	return hash_murmur3_one_32(p_method.arguments.size(), p_hash);
+}
+
+// Symbols depend on the engine build, the extensions loaded by the project (their docs) and
+// the editor language (translated descriptions). Everything a symbol is built from is hashed,
+// so an engine or extension update that only renames an argument or edits a description
+// still invalidates the cache.
+String GDScriptWorkspace::_get_native_symbols_cache_key(const DocTools *p_doc, const String &p_language) {
+	uint32_t classes_hash = 0;
+	for (const KeyValue<String, DocData::ClassDoc> &E : p_doc->class_list) {
+		const DocData::ClassDoc &class_data = E.value;
+		if (class_data.is_script_doc) {
+			continue;
+		}
+		uint32_t hash = hash_murmur3_one_32(E.key.hash());
+		hash = hash_murmur3_one_32(class_data.inherits.hash(), hash);
+		hash = hash_murmur3_one_32(class_data.brief_description.hash(), hash);
+		hash = hash_murmur3_one_32(class_data.description.hash(), hash);
+		for (const DocData::ConstantDoc &constant : class_data.constants) {
+			hash = hash_murmur3_one_32(constant.name.hash(), hash);
+			hash = hash_murmur3_one_32(constant.value.hash(), hash);
+			hash = hash_murmur3_one_32(constant.enumeration.hash(), hash);
+			hash = hash_murmur3_one_32(constant.description.hash(), hash);
+		}
+		for (const DocData::PropertyDoc &property : class_data.properties) {
+			hash = hash_murmur3_one_32(property.name.hash(), hash);
+			hash = hash_murmur3_one_32(property.type.hash(), hash);
+			hash = hash_murmur3_one_32(property.enumeration.hash(), hash);
+			hash = hash_murmur3_one_32(property.description.hash(), hash);
+		}
+		for (const DocData::ThemeItemDoc &theme_property : class_data.theme_properties) {
+			hash = hash_murmur3_one_32(theme_property.name.hash(), hash);
+			hash = hash_murmur3_one_32(theme_property.type.hash(), hash);
+			hash = hash_murmur3_one_32(theme_property.description.hash(), hash);
+		}
+		// Sizes separate the lists, so a member moving from one to the next changes the key.
+		hash = hash_murmur3_one_32(class_data.constants.size(), hash);
+		hash = hash_murmur3_one_32(class_data.properties.size(), hash);
+		hash = hash_murmur3_one_32(class_data.theme_properties.size(), hash);
+		for (const Vector<DocData::MethodDoc> *methods : { &class_data.methods, &class_data.annotations, &class_data.constructors, &class_data.operators, &class_data.signals }) {
+			for (const DocData::MethodDoc &method : *methods) {
+				hash = _hash_method_doc(method, hash);
 			}
-			symbol.detail = "func " + class_name + "." + data.name + "(" + params + ") -> " + return_type;
-			symbol.documentation = HANDLE_DOC(data.description);
-			class_symbol.children.push_back(symbol);
+			hash = hash_murmur3_one_32(methods->size(), hash);
 		}
+		classes_hash += hash_fmix32(hash); // Order independent, `class_list` order isn't stable.
+	}
+	return vformat("%s|%s|%s|%d|%x", GODOT_VERSION_FULL_BUILD, GODOT_VERSION_HASH, p_language, p_doc->class_list.size(), classes_hash);
+}
 
-		native_symbols.insert(class_name, class_symbol);
+static void _store_native_symbol(const Ref<FileAccess> &p_file, const LSP::DocumentSymbol &p_symbol) {
+	p_file->store_pascal_string(p_symbol.name);
+	p_file->store_pascal_string(p_symbol.detail);
+	p_file->store_pascal_string(p_symbol.documentation);
+	p_file->store_pascal_string(p_symbol.native_class);
+	p_file->store_8(p_symbol.kind);
+	p_file->store_32(p_symbol.children.size());
+	for (const LSP::DocumentSymbol &child : p_symbol.children) {
+		_store_native_symbol(p_file, child);
 	}
+}
 
-	reload_all_workspace_scripts();
+static bool _load_native_symbol(const Ref<FileAccess> &p_file, LSP::DocumentSymbol &r_symbol, int p_depth) {
+	ERR_FAIL_COND_V(p_depth >= MAX_NATIVE_SYMBOL_DEPTH, false);
+	r_symbol.name = p_file->get_pascal_string();
+	r_symbol.detail = p_file->get_pascal_string();
+	r_symbol.documentation = p_file->get_pascal_string();
+	r_symbol.native_class = p_file->get_pascal_string();
+	r_symbol.kind = p_file->get_8();
+	const uint32_t count = p_file->get_32();
+	ERR_FAIL_COND_V(count > p_file->get_length(), false);
+	r_symbol.children.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		if (!_load_native_symbol(p_file, r_symbol.children.write[i], p_depth + 1)) {
+			return false;
+		}
+	}
+	return !p_file->eof_reached();
+}
+
+struct GDScriptWorkspace::NativeSymbolBuild {
+	LocalVector<String> class_names;
+	LocalVector<const DocData::ClassDoc *> classes;
+	LocalVector<LSP::DocumentSymbol> symbols;
+};
+
+void GDScriptWorkspace::_build_native_symbol_task(uint32_t p_index, NativeSymbolBuild *p_build) {
+	p_build->symbols[p_index] = _make_native_class_symbol(p_build->class_names[p_index], *p_build->classes[p_index]);
+}
+
+const LSP::DocumentSymbol *GDScriptWorkspace::_get_native_class_symbol(const StringName &p_class, const DocTools *p_doc) {
+	if (LSP::DocumentSymbol *symbol = native_symbols.getptr(p_class)) {
+		return symbol;
+	}
+	const String class_name = p_class;
+	const DocData::ClassDoc *class_data = p_doc->class_list.getptr(class_name);
+	if (class_data == nullptr) {
+		return nullptr;
+	}
+	// `HashMap` elements don't move on insertion, so returned symbols stay valid.
+	return &native_symbols.insert(p_class, _make_native_class_symbol(class_name, *class_data))->value;
+}
+
+Error GDScriptWorkspace::_load_native_symbols(const String &p_path, const String &p_key) {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ, &err);
+	if (f.is_null()) {
+		return err;
+	}
+	if (f->get_32() != NATIVE_SYMBOLS_MAGIC || f->get_32() != NATIVE_SYMBOLS_VERSION || f->get_pascal_string() != p_key) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
 
-	if (GDScriptLanguageProtocol::get_singleton()->is_smart_resolve_enabled()) {
+	const uint32_t count = f->get_32();
+	ERR_FAIL_COND_V_MSG(count > f->get_length(), ERR_FILE_CORRUPT, "LSP: Corrupt native symbol cache: " + p_path);
+	LocalVector<LSP::DocumentSymbol> loaded;
+	loaded.resize(count);
+	for (LSP::DocumentSymbol &symbol : loaded) {
+		ERR_FAIL_COND_V_MSG(!_load_native_symbol(f, symbol, 0), ERR_FILE_CORRUPT, "LSP: Corrupt native symbol cache: " + p_path);
+	}
+
+	for (LSP::DocumentSymbol &symbol : loaded) {
+		const StringName class_name = symbol.name;
+		if (!native_symbols.has(class_name)) {
+			native_symbols.insert(class_name, symbol);
+		}
+	}
+	return OK;
+}
+
+Error GDScriptWorkspace::_save_native_symbols(const String &p_path, const String &p_key, const DocTools *p_doc) const {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(f.is_null(), err, "LSP: Can't write native symbol cache: " + p_path);
+
+	LocalVector<const LSP::DocumentSymbol *> stored;
+	for (const KeyValue<StringName, LSP::DocumentSymbol> &E : native_symbols) {
+		const DocData::ClassDoc *class_data = p_doc->class_list.getptr(E.key);
+		if (class_data != nullptr && !class_data->is_script_doc) {
+			stored.push_back(&E.value);
+		}
+	}
+
+	f->store_32(NATIVE_SYMBOLS_MAGIC);
+	f->store_32(NATIVE_SYMBOLS_VERSION);
+	f->store_pascal_string(p_key);
+	f->store_32(stored.size());
+	for (const LSP::DocumentSymbol *symbol : stored) {
+		_store_native_symbol(f, *symbol);
+	}
+	return OK;
+}
+
+void GDScriptWorkspace::_build_native_symbols() {
+	if (native_symbols_complete) {
+		return;
+	}
+	const uint64_t start = OS::get_singleton()->get_ticks_usec();
+	const DocTools *doc = EditorHelp::get_doc_data();
+	const String cache_path = get_native_symbols_cache_path();
+	const String cache_key = _get_native_symbols_cache_key(doc, EDITOR_GET("interface/editor/editor_language"));
+	const bool cached = _load_native_symbols(cache_path, cache_key) == OK;
+
+	// Whatever the cache didn't cover (everything on a miss, script docs on a hit) is built on
+	// the worker pool. The symbols only read the doc data, which is not modified meanwhile.
+	NativeSymbolBuild build;
+	for (const KeyValue<String, DocData::ClassDoc> &E : doc->class_list) {
+		if (!native_symbols.has(E.key)) {
+			build.class_names.push_back(E.key);
+			build.classes.push_back(&E.value);
+		}
+	}
+	build.symbols.resize(build.classes.size());
+	if (!build.classes.is_empty()) {
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GDScriptWorkspace::_build_native_symbol_task, &build, build.classes.size(), -1, true, "LSP native symbols");
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	}
+	for (uint32_t i = 0; i < build.classes.size(); i++) {
+		native_symbols.insert(build.class_names[i], build.symbols[i]);
+	}
+	native_symbols_complete = true;
+
+	if (!cached) {
+		_save_native_symbols(cache_path, cache_key, doc);
+	}
+	print_verbose(vformat("LSP: %d native class symbols ready in %d ms (%s).", native_symbols.size(), (OS::get_singleton()->get_ticks_usec() - start) / 1000, cached ? "cached" : "built"));
+}
+
+const HashMap<StringName, ClassMembers> &GDScriptWorkspace::get_native_members() {
+	if (!native_members_built) {
+		_build_native_symbols();
 		for (const KeyValue<StringName, LSP::DocumentSymbol> &E : native_symbols) {
 			ClassMembers members;
 			const LSP::DocumentSymbol &class_symbol = E.value;
@@ -371,8 +581,30 @@ Error GDScriptWorkspace::initialize() {
 			}
 			native_members.insert(E.key, members);
 		}
+		native_members_built = true;
+	}
+	return native_members;
+}
+
+Error GDScriptWorkspace::initialize() {
+	if (initialized) {
+		return OK;
+	}
+
+	reload_all_workspace_scripts();
+
+	// Goblin: bring the persisted identifier index up to date. Only files changed since the last session are tokenized.
+	symbol_index.load(GDScriptWorkspaceIndex::get_cache_path());
+	List<String> script_paths;
+	list_script_files("res://", script_paths);
+	symbol_index.sync(script_paths);
+	if (symbol_index.is_dirty()) {
+		symbol_index.save(GDScriptWorkspaceIndex::get_cache_path());
 	}
 
+	// Goblin: native class symbols are no longer built here. Lookups build single classes on
+	// demand, and the full table (smart resolve) is built on first use, see `get_native_members()`.
+
 	EditorNode *editor_node = EditorNode::get_singleton();
 	editor_node->connect("script_add_function_request", callable_mp(this, &GDScriptWorkspace::apply_new_signal));
 
@@ -431,41 +663,66 @@ bool GDScriptWorkspace::can_rename(const LSP::TextDocumentPositionParams &p_doc_
 	return false;
 }
 
+void GDScriptWorkspace::_add_usage_if_resolves(const LSP::DocumentSymbol &p_symbol, const String &p_uri, const LSP::Position &p_position, Vector<LSP::Location> &r_usages) {
+	LSP::TextDocumentPositionParams params;
+	params.textDocument.uri = p_uri;
+	params.position = p_position;
+
+	const LSP::DocumentSymbol *other_symbol = resolve_symbol(params);
+	if (other_symbol == &p_symbol) {
+		LSP::Location loc;
+		loc.uri = p_uri;
+		loc.range.start = p_position;
+		loc.range.end.line = p_position.line;
+		loc.range.end.character = p_position.character + p_symbol.name.length();
+		r_usages.append(loc);
+	}
+}
+
 Vector<LSP::Location> GDScriptWorkspace::find_usages_in_file(const LSP::DocumentSymbol &p_symbol, const String &p_file_path) {
 	Vector<LSP::Location> usages;
 
 	const String &identifier = p_symbol.name;
+
+	// Goblin: indexed files only resolve the positions where the tokenizer saw the identifier,
+	// and files that never mention it are not parsed at all. An edit still under analysis
+	// hasn't reached the index yet.
+	GDScriptLanguageProtocol::get_singleton()->finish_pending_parse(p_file_path);
+	const GDScriptWorkspaceIndex::Occurrences *occurrences = nullptr;
+	const bool use_index = symbol_index.has_file(p_file_path) && identifier.is_valid_unicode_identifier();
+	if (use_index) {
+		occurrences = symbol_index.get_occurrences(p_file_path, identifier);
+		if (occurrences == nullptr) {
+			return usages;
+		}
+	}
+
 	const ExtendGDScriptParser *parser = GDScriptLanguageProtocol::get_singleton()->get_parse_result(p_file_path);
-	if (parser) {
+	if (parser && use_index) {
+		const String uri = get_file_uri(p_file_path);
+		for (const Vector2i &occurrence : *occurrences) {
+			LSP::Position position(occurrence.y, occurrence.x);
+			LSP::Range range;
+			// Guards against an index entry that is older than the parse result.
+			if (parser->get_symbol_name_under_position(position, range) == identifier) {
+				_add_usage_if_resolves(p_symbol, uri, position, usages);
+			}
+		}
+	} else if (parser) {
+		const String uri = get_file_uri(p_file_path);
 		const PackedStringArray &content = parser->get_lines();
 		for (int i = 0; i < content.size(); ++i) {
 			String line = content[i];
 
 			int character = line.find(identifier);
 			while (character > -1) {
-				LSP::TextDocumentPositionParams params;
-
-				LSP::TextDocumentIdentifier text_doc;
-				text_doc.uri = get_file_uri(p_file_path);
-
-				params.textDocument = text_doc;
-				params.position.line = i;
-				params.position.character = character;
+				LSP::Position position(i, character);
 
 				LSP::Range range;
-				String identifier_under_cursor = parser->get_symbol_name_under_position(params.position, range);
+				String identifier_under_cursor = parser->get_symbol_name_under_position(position, range);
 
 				if (identifier_under_cursor == identifier) {
-					const LSP::DocumentSymbol *other_symbol = resolve_symbol(params);
-
-					if (other_symbol == &p_symbol) {
-						LSP::Location loc;
-						loc.uri = text_doc.uri;
-						loc.range.start = params.position;
-						loc.range.end.line = params.position.line;
-						loc.range.end.character = params.position.character + identifier.length();
-						usages.append(loc);
-					}
+					_add_usage_if_resolves(p_symbol, uri, position, usages);
 				}
 
 				if (identifier_under_cursor.length() < identifier.length()) {
@@ -492,6 +749,16 @@ Vector<LSP::Location> GDScriptWorkspace::find_all_usages(const LSP::DocumentSymb
 	List<String> paths;
 	list_script_files("res://", paths);
 
+	// Goblin: only files whose tokens contain the name can hold a usage. `sync()` just stats
+	// unchanged files, so scripts created or edited outside the client are still picked up.
+	// Edits under analysis are indexed first, so the file list reflects them.
+	if (p_symbol.name.is_valid_unicode_identifier()) {
+		GDScriptLanguageProtocol::get_singleton()->finish_pending_parses();
+		symbol_index.sync(paths);
+		paths.clear();
+		symbol_index.get_files_with(p_symbol.name, paths);
+	}
+
 	Vector<LSP::Location> usages;
 	for (const String &path : paths) {
 		usages.append_array(find_usages_in_file(p_symbol, path));
@@ -499,6 +766,17 @@ Vector<LSP::Location> GDScriptWorkspace::find_all_usages(const LSP::DocumentSymb
 	return usages;
 }
 
+void GDScriptWorkspace::update_index(const String &p_path, const String &p_code) {
+	symbol_index.update_file(p_path, p_code, 0);
+}
+
+void GDScriptWorkspace::refresh_index(const String &p_path) {
+	symbol_index.refresh_file(p_path);
+	if (symbol_index.is_dirty() && Engine::get_singleton()->is_editor_hint()) {
+		symbol_index.save(GDScriptWorkspaceIndex::get_cache_path());
+	}
+}
+
 String GDScriptWorkspace::get_file_path(const String &p_uri) {
 	int port;
 	String scheme;
@@ -715,8 +993,8 @@ const LSP::DocumentSymbol *GDScriptWorkspace::resolve_symbol(const LSP::TextDocu
 }
 
 const LSP::DocumentSymbol *GDScriptWorkspace::resolve_native_symbol(const LSP::NativeSymbolInspectParams &p_params) {
-	if (HashMap<StringName, LSP::DocumentSymbol>::Iterator E = native_symbols.find(p_params.native_class)) {
-		const LSP::DocumentSymbol &symbol = E->value;
+	if (const LSP::DocumentSymbol *class_symbol = _get_native_class_symbol(p_params.native_class, EditorHelp::get_doc_data())) {
+		const LSP::DocumentSymbol &symbol = *class_symbol;
 		if (p_params.symbol_name.is_empty() || p_params.symbol_name == symbol.name) {
 			return &symbol;
 		}
@@ -31,13 +31,21 @@
 #pragma once
 
 #include "gdscript_extend_parser.h"
+#include "gdscript_workspace_index.h"
 #include "godot_lsp.h"
 
 #include "core/error/error_macros.h"
 #include "core/variant/variant.h"
 
+class DocTools;
+
+namespace GDScriptTests {
+class TestGDScriptWorkspaceAccessor;
+}
+
 class GDScriptWorkspace : public RefCounted {
 	GDCLASS(GDScriptWorkspace, RefCounted);
+	friend class GDScriptTests::TestGDScriptWorkspaceAccessor;
 
 private:
 #ifndef DISABLE_DEPRECATED
@@ -55,12 +63,34 @@ private:
 protected:
 	static void _bind_methods();
 	bool initialized = false;
+
+	// Goblin: native class symbols from the doc data, built per class on first lookup. The full
+	// table is only needed by smart resolve; it is built on the worker pool, or read from a cache
+	// keyed by engine build, the content of the engine and extension docs, and editor language.
+	static constexpr uint32_t NATIVE_SYMBOLS_MAGIC = 0x534E4447; // "GDNS"
+	static constexpr uint32_t NATIVE_SYMBOLS_VERSION = 2;
+	struct NativeSymbolBuild;
+
 	HashMap<StringName, LSP::DocumentSymbol> native_symbols;
+	bool native_symbols_complete = false;
+	HashMap<StringName, ClassMembers> native_members;
+	bool native_members_built = false;
+
+	static String _get_native_symbols_cache_key(const DocTools *p_doc, const String &p_language);
+	const LSP::DocumentSymbol *_get_native_class_symbol(const StringName &p_class, const DocTools *p_doc);
+	void _build_native_symbol_task(uint32_t p_index, NativeSymbolBuild *p_build);
+	void _build_native_symbols();
+	Error _load_native_symbols(const String &p_path, const String &p_key);
+	Error _save_native_symbols(const String &p_path, const String &p_key, const DocTools *p_doc) const;
 
 	// Absolute paths that are known to point to res://
 	HashSet<String> absolute_res_paths;
 
-	const LSP::DocumentSymbol *get_native_symbol(const String &p_class, const String &p_member = "") const;
+	// Goblin: identifier positions of all workspace scripts, narrows references/rename to candidate files.
+	GDScriptWorkspaceIndex symbol_index;
+	void _add_usage_if_resolves(const LSP::DocumentSymbol &p_symbol, const String &p_uri, const LSP::Position &p_position, Vector<LSP::Location> &r_usages);
+
+	const LSP::DocumentSymbol *get_native_symbol(const String &p_class, const String &p_member = "");
 	const LSP::DocumentSymbol *get_script_symbol(const String &p_path) const;
 	const LSP::DocumentSymbol *get_parameter_symbol(const LSP::DocumentSymbol *p_parent, const String &symbol_identifier);
 	const LSP::DocumentSymbol *get_local_symbol_at(const ExtendGDScriptParser *p_parser, const String &p_symbol_identifier, const LSP::Position p_position);
@@ -75,15 +105,22 @@ public:
 	String root;
 	String root_uri;
 
-	HashMap<StringName, ClassMembers> native_members;
-
 public:
 	Error initialize();
 
+	static String get_native_symbols_cache_path();
+	// Members of every documented class, by name. Builds the full native symbol table on first call.
+	const HashMap<StringName, ClassMembers> &get_native_members();
+
 	String get_file_path(const String &p_uri);
 	String get_file_uri(const String &p_path) const;
 
 	void publish_diagnostics(const String &p_path);
+
+	// Goblin: `update_index()` indexes an unsaved editor buffer, `refresh_index()` goes back to the
+	// file on disk (save/close) and persists the index.
+	void update_index(const String &p_path, const String &p_code);
+	void refresh_index(const String &p_path);
 	void completion(const LSP::CompletionParams &p_params, List<ScriptLanguage::CodeCompletionOption> *r_options);
 
 	const LSP::DocumentSymbol *resolve_symbol(const LSP::TextDocumentPositionParams &p_doc_pos, const String &p_symbol_name = "", bool p_func_required = false);
@@ -0,0 +1,198 @@
+/**************************************************************************/
+/*  gdscript_workspace_index.cpp                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                            GOBLIN ENGINE                               */
+/**************************************************************************/
+
+#include "gdscript_workspace_index.h"
+
+#include "../gdscript_tokenizer.h"
+
+#include "core/config/project_settings.h"
+#include "core/io/file_access.h"
+
+/*
+ * Cache file layout (little endian, `FileAccess` encoding):
+ *   u32 magic ("GDLI"), u32 version, u32 file count
+ *   per file:       pascal string path, u64 modified time, u32 identifier count
+ *   per identifier: pascal string name, u32 occurrence count, occurrence count * (u32 column, u32 line)
+ * Unsaved editor buffers (modified time 0) are not written.
+ */
+
+String GDScriptWorkspaceIndex::get_cache_path() {
+	return ProjectSettings::get_singleton()->get_project_data_path().path_join("goblin_lsp_index.bin");
+}
+
+void GDScriptWorkspaceIndex::_unlink_file(const String &p_path, const FileEntry &p_entry) {
+	for (const KeyValue<StringName, Occurrences> &E : p_entry.occurrences) {
+		HashMap<StringName, HashSet<String>>::Iterator F = files_by_identifier.find(E.key);
+		if (!F) {
+			continue;
+		}
+		F->value.erase(p_path);
+		if (F->value.is_empty()) {
+			files_by_identifier.remove(F);
+		}
+	}
+}
+
+void GDScriptWorkspaceIndex::_link_file(const String &p_path, const FileEntry &p_entry) {
+	for (const KeyValue<StringName, Occurrences> &E : p_entry.occurrences) {
+		files_by_identifier[E.key].insert(p_path);
+	}
+}
+
+void GDScriptWorkspaceIndex::update_file(const String &p_path, const String &p_code, uint64_t p_modified_time) {
+	FileEntry entry;
+	entry.modified_time = p_modified_time;
+
+	GDScriptTokenizerText tokenizer;
+	tokenizer.set_source_code(p_code);
+	for (GDScriptTokenizer::Token token = tokenizer.scan(); token.type != GDScriptTokenizer::Token::TK_EOF; token = tokenizer.scan()) {
+		if (token.type == GDScriptTokenizer::Token::IDENTIFIER) {
+			entry.occurrences[token.get_identifier()].push_back(Vector2i(token.start_column - 1, token.start_line - 1));
+		}
+	}
+
+	remove_file(p_path);
+	_link_file(p_path, entry);
+	files.insert(p_path, entry);
+	dirty = true;
+}
+
+void GDScriptWorkspaceIndex::refresh_file(const String &p_path) {
+	Error err;
+	String code = FileAccess::get_file_as_string(p_path, &err);
+	if (err != OK) {
+		remove_file(p_path);
+		return;
+	}
+	update_file(p_path, code, FileAccess::get_modified_time(p_path));
+}
+
+void GDScriptWorkspaceIndex::remove_file(const String &p_path) {
+	HashMap<String, FileEntry>::Iterator E = files.find(p_path);
+	if (!E) {
+		return;
+	}
+	_unlink_file(p_path, E->value);
+	files.remove(E);
+	dirty = true;
+}
+
+void GDScriptWorkspaceIndex::sync(const List<String> &p_paths) {
+	HashSet<String> present;
+	for (const String &path : p_paths) {
+		present.insert(path);
+
+		uint64_t modified_time = FileAccess::get_modified_time(path);
+		const FileEntry *entry = files.getptr(path);
+		if (entry != nullptr && (entry->modified_time == 0 || entry->modified_time == modified_time)) {
+			continue;
+		}
+		refresh_file(path);
+	}
+
+	LocalVector<String> removed;
+	for (const KeyValue<String, FileEntry> &E : files) {
+		if (!present.has(E.key)) {
+			removed.push_back(E.key);
+		}
+	}
+	for (const String &path : removed) {
+		remove_file(path);
+	}
+}
+
+void GDScriptWorkspaceIndex::get_files_with(const StringName &p_identifier, List<String> &r_files) const {
+	const HashSet<String> *paths = files_by_identifier.getptr(p_identifier);
+	if (paths == nullptr) {
+		return;
+	}
+	for (const String &path : *paths) {
+		r_files.push_back(path);
+	}
+}
+
+const GDScriptWorkspaceIndex::Occurrences *GDScriptWorkspaceIndex::get_occurrences(const String &p_path, const StringName &p_identifier) const {
+	const FileEntry *entry = files.getptr(p_path);
+	if (entry == nullptr) {
+		return nullptr;
+	}
+	return entry->occurrences.getptr(p_identifier);
+}
+
+Error GDScriptWorkspaceIndex::load(const String &p_path) {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ, &err);
+	if (f.is_null()) {
+		return err;
+	}
+	if (f->get_32() != MAGIC || f->get_32() != VERSION) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+
+	HashMap<String, FileEntry> loaded;
+	uint32_t file_count = f->get_32();
+	for (uint32_t i = 0; i < file_count && !f->eof_reached(); i++) {
+		String path = f->get_pascal_string();
+		FileEntry &entry = loaded[path];
+		entry.modified_time = f->get_64();
+
+		uint32_t identifier_count = f->get_32();
+		for (uint32_t j = 0; j < identifier_count && !f->eof_reached(); j++) {
+			Occurrences &occurrences = entry.occurrences[f->get_pascal_string()];
+			uint32_t occurrence_count = f->get_32();
+			ERR_FAIL_COND_V(occurrence_count > f->get_length() / 8, ERR_FILE_CORRUPT);
+			occurrences.resize(occurrence_count);
+			for (uint32_t k = 0; k < occurrence_count; k++) {
+				occurrences[k].x = f->get_32();
+				occurrences[k].y = f->get_32();
+			}
+		}
+	}
+	ERR_FAIL_COND_V_MSG(f->eof_reached(), ERR_FILE_CORRUPT, "LSP: Truncated workspace index: " + p_path);
+
+	files = loaded;
+	files_by_identifier.clear();
+	for (const KeyValue<String, FileEntry> &E : files) {
+		_link_file(E.key, E.value);
+	}
+	dirty = false;
+	return OK;
+}
+
+Error GDScriptWorkspaceIndex::save(const String &p_path) {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(f.is_null(), err, "LSP: Can't write workspace index: " + p_path);
+
+	uint32_t file_count = 0;
+	for (const KeyValue<String, FileEntry> &E : files) {
+		file_count += E.value.modified_time != 0;
+	}
+
+	f->store_32(MAGIC);
+	f->store_32(VERSION);
+	f->store_32(file_count);
+	for (const KeyValue<String, FileEntry> &E : files) {
+		if (E.value.modified_time == 0) {
+			continue;
+		}
+		f->store_pascal_string(E.key);
+		f->store_64(E.value.modified_time);
+		f->store_32(E.value.occurrences.size());
+		for (const KeyValue<StringName, Occurrences> &F : E.value.occurrences) {
+			f->store_pascal_string(F.key);
+			f->store_32(F.value.size());
+			for (const Vector2i &occurrence : F.value) {
+				f->store_32(occurrence.x);
+				f->store_32(occurrence.y);
+			}
+		}
+	}
+
+	dirty = false;
+	return OK;
+}
@@ -0,0 +1,62 @@
+/**************************************************************************/
+/*  gdscript_workspace_index.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                            GOBLIN ENGINE                               */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/vector2i.h"
+#include "core/string/string_name.h"
+#include "core/string/ustring.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/list.h"
+#include "core/templates/local_vector.h"
+
+// Inverted identifier index over the workspace scripts: identifier -> files -> positions.
+// Built from the tokenizer only (no parse), so it answers "where could this name be used"
+// and the workspace confirms each hit semantically. Persisted between editor sessions and
+// refreshed per file by modification time.
+class GDScriptWorkspaceIndex {
+public:
+	// Identifier starts in LSP coordinates: `x` is the 0-based code point column, `y` the 0-based line.
+	typedef LocalVector<Vector2i> Occurrences;
+
+private:
+	static constexpr uint32_t MAGIC = 0x494C4447; // "GDLI"
+	static constexpr uint32_t VERSION = 1;
+
+	struct FileEntry {
+		uint64_t modified_time = 0;
+		HashMap<StringName, Occurrences> occurrences;
+	};
+
+	HashMap<String, FileEntry> files;
+	HashMap<StringName, HashSet<String>> files_by_identifier;
+	bool dirty = false;
+
+	void _unlink_file(const String &p_path, const FileEntry &p_entry);
+	void _link_file(const String &p_path, const FileEntry &p_entry);
+
+public:
+	static String get_cache_path();
+
+	// `p_modified_time` of 0 marks an unsaved editor buffer. Those entries win over the file on disk
+	// until the buffer is saved or closed, and are never persisted.
+	void update_file(const String &p_path, const String &p_code, uint64_t p_modified_time);
+	// Re-reads the file from disk, or drops it if it is gone.
+	void refresh_file(const String &p_path);
+	void remove_file(const String &p_path);
+	// Re-indexes files whose modification time changed and drops files that are gone.
+	void sync(const List<String> &p_paths);
+
+	void get_files_with(const StringName &p_identifier, List<String> &r_files) const;
+	const Occurrences *get_occurrences(const String &p_path, const StringName &p_identifier) const;
+	bool has_file(const String &p_path) const { return files.has(p_path); }
+
+	Error load(const String &p_path);
+	Error save(const String &p_path);
+	bool is_dirty() const { return dirty; }
+};
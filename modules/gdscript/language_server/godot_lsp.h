@@ -622,7 +622,7 @@ struct TextDocumentSyncOptions {
 	 * Change notifications are sent to the server. See TextDocumentSyncKind.None, TextDocumentSyncKind.Full
 	 * and TextDocumentSyncKind.Incremental. If omitted it defaults to TextDocumentSyncKind.None.
 	 */
-	int change = TextDocumentSyncKind::Full;
+	int change = TextDocumentSyncKind::Incremental;
 
 	/**
 	 * If present will save notifications are sent to the server. If omitted the notification should not be
@@ -735,6 +735,13 @@ struct TextDocumentItem {
  * An event describing a change to a text document.
  */
 struct TextDocumentContentChangeEvent {
+	/**
+	 * The range of the document that changed. Only valid if `has_range` is set,
+	 * otherwise `text` replaces the whole document.
+	 */
+	Range range;
+	bool has_range = false;
+
 	/**
 	 * The new text of the range/document.
 	 */
@@ -742,6 +749,10 @@ struct TextDocumentContentChangeEvent {
 
 	void load(const Dictionary &p_params) {
 		text = p_params["text"];
+		has_range = p_params.has("range");
+		if (has_range) {
+			range.load(p_params["range"]);
+		}
 	}
 };
 
@@ -34,6 +34,7 @@
 #include "gdscript_cache.h"
 #include "gdscript_parser.h"
 #include "gdscript_resource_format.h"
+#include "gdscript_schema_index.h"
 #include "gdscript_tokenizer_buffer.h"
 #include "gdscript_utility_functions.h"
 
@@ -58,7 +59,6 @@
 #include "core/object/class_db.h"
 
 #ifdef TOOLS_ENABLED
-#include "core/io/config_file.h"
 #include "core/io/dir_access.h"
 #include "editor/editor_node.h"
 #include "editor/export/editor_export.h"
@@ -149,9 +149,7 @@ static void _editor_init() {
 	if (!FileAccess::exists(GDScriptLanguage::get_singleton()->get_schema_cache_path())) {
 		const String schema_cache_path = GDScriptLanguage::get_singleton()->get_schema_cache_path();
 		DirAccess::make_dir_recursive_absolute(schema_cache_path.get_base_dir());
-		Ref<ConfigFile> empty_cache;
-		empty_cache.instantiate();
-		empty_cache->save(schema_cache_path);
+		GDScriptSchemaIndex().save(schema_cache_path);
 		DirAccess::remove_absolute(EditorPaths::get_singleton()->get_project_settings_dir().path_join("filesystem_cache10"));
 	}
 
@@ -258,9 +256,28 @@ void test_bytecode() {
 	GDScriptTests::test(GDScriptTests::TestType::TEST_BYTECODE);
 }
 
+void benchmark_tokenizer() {
+	GDScriptTests::benchmark_tokenizer();
+}
+
+void benchmark_scripts() {
+	GDScriptTests::benchmark_scripts();
+}
+
+#ifdef TOOLS_ENABLED
+void benchmark_highlighter() {
+	GDScriptTests::benchmark_highlighter();
+}
+#endif
+
 REGISTER_TEST_COMMAND("gdscript-tokenizer", &test_tokenizer);
 REGISTER_TEST_COMMAND("gdscript-tokenizer-buffer", &test_tokenizer_buffer);
 REGISTER_TEST_COMMAND("gdscript-parser", &test_parser);
 REGISTER_TEST_COMMAND("gdscript-compiler", &test_compiler);
 REGISTER_TEST_COMMAND("gdscript-bytecode", &test_bytecode);
+REGISTER_TEST_COMMAND("gdscript-tokenizer-benchmark", &benchmark_tokenizer);
+REGISTER_TEST_COMMAND("gdscript-benchmark", &benchmark_scripts);
+#ifdef TOOLS_ENABLED
+REGISTER_TEST_COMMAND("gdscript-highlighter-benchmark", &benchmark_highlighter);
+#endif
 #endif
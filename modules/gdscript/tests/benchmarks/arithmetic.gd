@@ -0,0 +1,15 @@
+# Typed int/float/vector arithmetic in tight loops.
+
+const ITERATIONS = 200000
+
+func benchmark():
+	var a := 0
+	var b := 1.0
+	var v := Vector3(1, 2, 3)
+	var w := Vector2i(1, 1)
+	for i in ITERATIONS:
+		a = (a + i * 3) % 1000003
+		b = b * 0.5 + float(i) * 0.25
+		v = v * 0.99 + Vector3(0.1, 0.2, 0.3)
+		w += Vector2i(i & 1, 1)
+	return a + int(b) + int(v.length()) + w.x
@@ -0,0 +1,29 @@
+# Script-to-script calls: typed static, typed member, untyped member and native.
+
+const ITERATIONS = 100000
+
+var counter := 0
+
+static func add_static(a: int, b: int) -> int:
+	return a + b
+
+func add_typed(a: int, b: int) -> int:
+	return a + b
+
+func add_untyped(a, b):
+	return a + b
+
+func bump() -> void:
+	counter += 1
+
+func benchmark():
+	var total := 0
+	for i in ITERATIONS:
+		total = add_static(total, i)
+		total = add_typed(total, 1)
+		total = add_untyped(total, 1)
+		bump()
+	var text := "goblin"
+	for i in ITERATIONS:
+		total += text.length()
+	return total
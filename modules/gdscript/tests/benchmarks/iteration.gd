@@ -0,0 +1,32 @@
+# `for` over ranges, untyped/typed/packed arrays and dictionaries.
+
+const SIZE = 20000
+
+var untyped := []
+var ints: Array[int] = []
+var floats: Packed[float] = []
+var table := {}
+
+func _init():
+	for i in SIZE:
+		untyped.append(i)
+		ints.append(i)
+		floats.append(i * 0.5)
+		table[i] = i * 2
+
+func benchmark():
+	var total := 0
+	for i in range(SIZE):
+		total += i
+	for x in untyped:
+		total += x
+	for x in ints:
+		total += x
+	var sum := 0.0
+	for x in floats:
+		sum += x
+	for key in table:
+		total += key
+	for key, value in table:
+		total += value
+	return total + int(sum)
@@ -0,0 +1,22 @@
+# Lambda creation, captures and calls, including through Array.map/filter.
+
+const ITERATIONS = 50000
+
+var values: Array[int] = []
+
+func _init():
+	for i in 1000:
+		values.append(i)
+
+func benchmark():
+	var total := 0
+	var offset := 3
+	var add := func(x: int) -> int: return x + offset
+	for i in ITERATIONS:
+		total = add.call(total) & 0xFFFF
+	for i in ITERATIONS / 1000:
+		var captured := i
+		var scale := func(x: int) -> int: return x * captured
+		total += values.map(scale).size()
+		total += values.filter(func(x: int) -> bool: return x % 2 == 0).size()
+	return total
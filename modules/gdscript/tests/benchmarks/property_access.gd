@@ -0,0 +1,28 @@
+# Member variables, setters/getters and native properties.
+
+const ITERATIONS = 100000
+
+class Entity:
+	var hp := 100
+	var position := Vector3()
+	var speed: float = 1.0:
+		set(value):
+			speed = maxf(value, 0.0)
+
+var entity := Entity.new()
+var node := Node3D.new()
+
+func benchmark():
+	var e := entity
+	for i in ITERATIONS:
+		e.hp -= 1
+		e.hp += 1
+		e.position.x += 0.5
+		e.speed = e.speed + 0.001
+	for i in ITERATIONS / 10:
+		node.position = node.position + Vector3.ONE
+	return e.hp
+
+func _notification(what):
+	if what == NOTIFICATION_PREDELETE:
+		node.free()
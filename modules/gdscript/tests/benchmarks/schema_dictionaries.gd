@@ -0,0 +1,14 @@
+# `Dictionary[Name]` instances of a `@schema`: default fill, override merge and access.
+
+const ITERATIONS = 20000
+
+@schema const bench_critter = { hp: int = 10, dmg: int = 2, name: String = "", pos: Vector2 = Vector2() }
+
+func benchmark():
+	var total := 0
+	for i in ITERATIONS:
+		var c: Dictionary[bench_critter]
+		var d: Dictionary[bench_critter] = { hp = i & 15 }
+		c.dmg += d.hp
+		total += c.hp + c.dmg + d.dmg
+	return total
@@ -0,0 +1,16 @@
+# Construction of and typed access into shaped (Lua-style typed) dictionary literals.
+
+const ITERATIONS = 20000
+
+func benchmark():
+	var total := 0
+	for i in ITERATIONS:
+		var unit := {
+			hp: int = 10,
+			pos: Vector3 = Vector3.ZERO,
+			tag: String = "goblin",
+		}
+		unit.hp += i & 7
+		unit.pos.x += 1.0
+		total += unit.hp + unit.tag.length()
+	return total
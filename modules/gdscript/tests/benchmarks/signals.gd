@@ -0,0 +1,36 @@
+# Signal emission fanning out to script methods: own, inherited and overridden listeners.
+
+const EMISSIONS = 2000
+const LISTENERS = 100
+
+signal ticked(amount: int)
+
+class Listener:
+	var total := 0
+
+	func on_tick(amount: int) -> void:
+		total += amount
+
+class InheritedListener extends Listener:
+	pass
+
+class OverridingListener extends Listener:
+	func on_tick(amount: int) -> void:
+		total -= amount
+
+func benchmark():
+	var listeners: Array[Listener] = []
+	for i in LISTENERS:
+		match i % 3:
+			0:
+				listeners.append(Listener.new())
+			1:
+				listeners.append(InheritedListener.new())
+			_:
+				listeners.append(OverridingListener.new())
+		ticked.connect(listeners[i].on_tick)
+	for i in EMISSIONS:
+		ticked.emit(1)
+	for listener in listeners:
+		ticked.disconnect(listener.on_tick)
+	return listeners[0].total
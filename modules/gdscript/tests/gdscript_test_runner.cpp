@@ -45,6 +45,7 @@
 #include "core/object/class_db.h"
 #include "core/os/os.h"
 #include "core/string/string_builder.h"
+#include "core/templates/local_vector.h"
 #include "scene/resources/packed_scene.h"
 #include "tests/test_macros.h"
 #include "tests/test_utils.h"
@@ -212,13 +213,25 @@ int GDScriptTestRunner::run_tests() {
 		return -1;
 	}
 
+	struct TestTiming {
+		String file;
+		uint64_t usec = 0;
+		bool operator<(const TestTiming &p_other) const { return usec > p_other.usec; }
+	};
+	LocalVector<TestTiming> timings;
+	const uint64_t run_begin = OS::get_singleton()->get_ticks_usec();
+
 	int failed = 0;
 	for (int i = 0; i < tests.size(); i++) {
 		GDScriptTest test = tests[i];
 		if (print_filenames) {
 			print_line(test.get_source_relative_filepath());
 		}
+		const uint64_t test_begin = OS::get_singleton()->get_ticks_usec();
 		GDScriptTest::TestResult result = test.run_test();
+		if (print_timings) {
+			timings.push_back({ test.get_source_relative_filepath(), OS::get_singleton()->get_ticks_usec() - test_begin });
+		}
 
 		String expected = FileAccess::get_file_as_string(test.get_output_file());
 #ifndef DEBUG_ENABLED
@@ -233,9 +246,65 @@ int GDScriptTestRunner::run_tests() {
 		CHECK_MESSAGE(result.passed, (result.passed ? String() : result.output));
 	}
 
+	if (print_timings) {
+		const uint64_t run_usec = OS::get_singleton()->get_ticks_usec() - run_begin;
+		print_line(vformat("Ran %d GDScript tests in %.2f s (shard %d/%d). Slowest:", tests.size(), run_usec / 1000000.0, shard_index, shard_count));
+		timings.sort();
+		for (uint32_t i = 0; i < MIN(timings.size(), 10u); i++) {
+			print_line(vformat("%8.2f ms  %s", timings[i].usec / 1000.0, timings[i].file));
+		}
+	}
+
 	return failed;
 }
 
+void GDScriptTestRunner::set_shard(int p_index, int p_count) {
+	ERR_FAIL_COND(p_count < 1 || p_index < 0 || p_index >= p_count);
+	shard_index = p_index;
+	shard_count = p_count;
+}
+
+int GDScriptTestRunner::run_tests_in_subprocesses(int p_jobs, const List<String> &p_forwarded_args) {
+	const String executable = OS::get_singleton()->get_executable_path();
+
+	LocalVector<OS::ProcessID> children;
+	for (int i = 0; i < p_jobs; i++) {
+		List<String> args;
+		args.push_back("--test");
+		args.push_back("--test-case=Script compilation and runtime");
+		args.push_back(vformat("--gdscript-test-shard=%d/%d", i, p_jobs));
+		for (const String &arg : p_forwarded_args) {
+			args.push_back(arg);
+		}
+
+		OS::ProcessID pid = 0;
+		Error err = OS::get_singleton()->create_process(executable, args, &pid);
+		if (err != OK) {
+			// Don't leave the shards already started running on their own.
+			for (const OS::ProcessID child : children) {
+				OS::get_singleton()->kill(child);
+				while (OS::get_singleton()->is_process_running(child)) {
+					OS::get_singleton()->delay_usec(10000);
+				}
+			}
+			ERR_FAIL_V_MSG(p_jobs, vformat("Could not start GDScript test shard %d/%d.", i, p_jobs));
+		}
+		children.push_back(pid);
+	}
+
+	int failed_shards = 0;
+	for (uint32_t i = 0; i < children.size(); i++) {
+		while (OS::get_singleton()->is_process_running(children[i])) {
+			OS::get_singleton()->delay_usec(10000);
+		}
+		if (OS::get_singleton()->get_process_exit_code(children[i]) != 0) {
+			print_line(vformat("GDScript test shard %d/%d failed.", i, p_jobs));
+			failed_shards++;
+		}
+	}
+	return failed_shards;
+}
+
 bool GDScriptTestRunner::generate_outputs() {
 	is_generating = true;
 
@@ -351,7 +420,29 @@ bool GDScriptTestRunner::make_tests() {
 	ERR_FAIL_COND_V_MSG(err != OK, false, "Could not open specified test directory.");
 
 	source_dir = dir->get_current_dir() + "/"; // Make it absolute path.
-	return make_tests_for_dir(dir->get_current_dir());
+	if (!make_tests_for_dir(dir->get_current_dir())) {
+		return false;
+	}
+
+	if (shard_count > 1) {
+		// Directory listing order is not guaranteed, so shards agree on a sorted list.
+		struct TestOrder {
+			_FORCE_INLINE_ bool operator()(const GDScriptTest &p_a, const GDScriptTest &p_b) const {
+				if (p_a.get_source_file() != p_b.get_source_file()) {
+					return p_a.get_source_file() < p_b.get_source_file();
+				}
+				return p_a.get_tokenizer_mode() < p_b.get_tokenizer_mode();
+			}
+		};
+		tests.sort_custom<TestOrder>();
+
+		Vector<GDScriptTest> shard;
+		for (int i = shard_index; i < tests.size(); i += shard_count) {
+			shard.push_back(tests[i]);
+		}
+		tests = shard;
+	}
+	return true;
 }
 
 static bool generate_class_index_recursive(const String &p_dir) {
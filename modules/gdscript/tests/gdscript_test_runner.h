@@ -34,6 +34,7 @@
 #include "core/string/print_string.h"
 #include "core/string/string_name.h"
 #include "core/string/ustring.h"
+#include "core/templates/list.h"
 #include "core/templates/vector.h"
 
 namespace GDScriptTests {
@@ -117,6 +118,9 @@ class GDScriptTestRunner {
 	bool do_init_languages = false;
 	bool print_filenames; // Whether filenames should be printed when generated/running tests
 	bool binary_tokens; // Test with buffer tokenizer.
+	bool print_timings = false; // Goblin: print the total and the slowest tests after a run.
+	int shard_index = 0; // Goblin: run only every `shard_count`-th test, starting at `shard_index`.
+	int shard_count = 1;
 
 	bool make_tests();
 	bool make_tests_for_dir(const String &p_dir);
@@ -126,9 +130,16 @@ public:
 	static StringName test_function_name;
 
 	static void handle_cmdline();
+	// Goblin: runs the suite in `p_jobs` child processes, one shard each, and returns the
+	// number of shards that failed. The VM, script cache and print/error handlers are
+	// process-wide, so tests can't be spread over threads.
+	static int run_tests_in_subprocesses(int p_jobs, const List<String> &p_forwarded_args);
 	int run_tests();
 	bool generate_outputs();
 
+	void set_shard(int p_index, int p_count);
+	void set_print_timings(bool p_print_timings) { print_timings = p_print_timings; }
+
 	GDScriptTestRunner(const String &p_source_dir, bool p_init_language, bool p_print_filenames = false, bool p_use_binary_tokens = false);
 	~GDScriptTestRunner();
 };
@@ -59,9 +59,41 @@ public:
 #ifdef TOOLS_ENABLED
 TEST_SUITE("[Modules][GDScript]") {
 	TEST_CASE("Script compilation and runtime") {
-		bool print_filenames = OS::get_singleton()->get_cmdline_args().find("--print-filenames") != nullptr;
-		bool use_binary_tokens = OS::get_singleton()->get_cmdline_args().find("--use-binary-tokens") != nullptr;
+		const List<String> cmdline_args = OS::get_singleton()->get_cmdline_args();
+		bool print_filenames = cmdline_args.find("--print-filenames") != nullptr;
+		bool use_binary_tokens = cmdline_args.find("--use-binary-tokens") != nullptr;
+		bool print_timings = cmdline_args.find("--gdscript-test-timings") != nullptr;
+
+		// Goblin: `--gdscript-test-jobs=<n>` splits the suite over n child processes, each
+		// running the tests selected by `--gdscript-test-shard=<index>/<n>`.
+		int jobs = 1;
+		int shard_index = 0;
+		int shard_count = 1;
+		for (const String &arg : cmdline_args) {
+			if (arg.begins_with("--gdscript-test-jobs=")) {
+				jobs = MAX(1, arg.get_slicec('=', 1).to_int());
+			} else if (arg.begins_with("--gdscript-test-shard=")) {
+				const String shard = arg.get_slicec('=', 1);
+				shard_index = shard.get_slicec('/', 0).to_int();
+				shard_count = MAX(1, shard.get_slicec('/', 1).to_int());
+			}
+		}
+
+		if (jobs > 1 && shard_count == 1) {
+			List<String> forwarded_args;
+			for (const String &arg : { String("--print-filenames"), String("--use-binary-tokens"), String("--gdscript-test-timings") }) {
+				if (cmdline_args.find(arg) != nullptr) {
+					forwarded_args.push_back(arg);
+				}
+			}
+			int failed_shards = GDScriptTestRunner::run_tests_in_subprocesses(jobs, forwarded_args);
+			REQUIRE_MESSAGE(failed_shards == 0, "All GDScript test shards should pass.");
+			return;
+		}
+
 		GDScriptTestRunner runner("modules/goblin/modules/gdscript/tests/scripts", true, print_filenames, use_binary_tokens);
+		runner.set_shard(shard_index, shard_count);
+		runner.set_print_timings(print_timings);
 		int fail_count = runner.run_tests();
 		INFO("Make sure `*.out` files have expected results.");
 		REQUIRE_MESSAGE(fail_count == 0, "All GDScript tests should pass.");
@@ -0,0 +1,4 @@
+func test():
+	var values: Array[int] = [1, 2]
+	for key, value in values:
+		print(key, value)
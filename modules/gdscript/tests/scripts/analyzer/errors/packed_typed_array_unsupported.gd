@@ -0,0 +1,2 @@
+func test():
+	var nodes: Packed[Node] = []
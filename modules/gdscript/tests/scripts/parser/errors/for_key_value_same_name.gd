@@ -0,0 +1,3 @@
+func test():
+	for item, item in {}:
+		pass
@@ -0,0 +1,57 @@
+func test():
+	var scores := { "a": 1, "b": 2, "c": 3 }
+	for key, value in scores:
+		print(key, " = ", value)
+
+	var typed: Dictionary[StringName, Vector2i] = { &"x": Vector2i(1, 2), &"y": Vector2i(3, 4) }
+	for key, value in typed:
+		print(key, " ", value, " ", typeof(key) == TYPE_STRING_NAME, " ", typeof(value) == TYPE_VECTOR2I)
+
+	for key: String, value: float in { "pi": 3, "e": 2 }:
+		print(key, " ", value)
+
+	# The loop walks the live dictionary, like `for key in dict`: changed values and added
+	# entries are seen, erased ones are not.
+	var counts := { 1: 10, 2: 20, 3: 30 }
+	for key, value in counts:
+		if key == 1:
+			counts[2] = 21
+			counts.erase(3)
+		print(key, " ", value)
+	var grown := { 1: 10 }
+	for key, value in grown:
+		if key < 3:
+			grown[key + 1] = value + 10
+		print(key, " ", value)
+
+	var empty := {}
+	for key, value in empty:
+		print("never")
+
+	for key, value in scores:
+		if key == "a":
+			continue
+		if key == "c":
+			break
+		print("body ", key)
+
+	var ints: Array[int] = [1, 2, 3]
+	var total := 0
+	for i in ints:
+		total += i
+	print(total)
+
+	var points: Array[Vector3] = [Vector3(1, 0, 0), Vector3(0, 2, 0)]
+	var sum := Vector3()
+	for p: Vector3 in points:
+		sum += p
+	print(sum == Vector3(1, 2, 0))
+
+	var floats: Array[float] = []
+	for f in floats:
+		print("never")
+
+	# The typed iterator can be reassigned in the body.
+	for i in ints:
+		i *= 2
+		print(i)
@@ -0,0 +1,29 @@
+var positions: Packed[Vector3] = [Vector3(1, 0, 0), Vector3(0, 1, 0)]
+
+func sum(values: Packed[float]) -> float:
+	var total := 0.0
+	for v in values:
+		total += v
+	return total
+
+func test():
+	print(typeof(positions) == TYPE_PACKED_VECTOR3_ARRAY)
+	positions.push_back(Vector3(0, 0, 1))
+	print(positions.size())
+
+	var ids: Packed[int] = [3, 1, 2]
+	ids.sort()
+	print(ids)
+	print(typeof(ids) == TYPE_PACKED_INT64_ARRAY)
+	print(ids is PackedInt64Array)
+
+	var weights: Packed[float] = [0.5, 1.5, 2.0]
+	print(sum(weights))
+
+	var names: Packed[String] = []
+	names.append("a")
+	names.append("b")
+	print(",".join(names))
+
+	var tints: Packed[Color] = [Color.RED]
+	print(tints[0] == Color.RED)
@@ -0,0 +1,33 @@
+# Emissions and dynamic calls resolve script methods through the inheritance chain, overrides
+# included. Resolved methods are cached per script, so repeated calls must stay per class.
+
+signal ticked(amount: int)
+
+class Base:
+	var total := 0
+
+	func on_tick(amount: int) -> void:
+		total += amount
+
+	func describe() -> String:
+		return "base"
+
+class Derived extends Base:
+	func describe() -> String:
+		return "derived"
+
+class Override extends Base:
+	func on_tick(amount: int) -> void:
+		total -= amount
+
+func test():
+	var listeners: Array[Base] = [Base.new(), Derived.new(), Override.new()]
+	for listener in listeners:
+		ticked.connect(listener.on_tick)
+	for i in 3:
+		ticked.emit(i + 1)
+	print(listeners.map(func(listener: Base): return listener.total))
+
+	for _pass in 2:
+		print(listeners.map(func(listener: Base): return listener.call(&"describe")))
+	print(listeners[1].has_method(&"on_tick"), " ", listeners[1].has_method(&"missing"))
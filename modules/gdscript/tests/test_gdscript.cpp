@@ -31,6 +31,7 @@
 #include "test_gdscript.h"
 
 #include "../gdscript_analyzer.h"
+#include "../gdscript_cache.h"
 #include "../gdscript_compiler.h"
 #include "../gdscript_parser.h"
 #include "../gdscript_tokenizer.h"
@@ -38,12 +39,20 @@
 #include "gdscript_test_runner.h"
 
 #include "core/config/project_settings.h"
+#include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/io/json.h"
+#include "core/os/memory.h"
 #include "core/os/os.h"
 #include "core/string/string_builder.h"
+#include "core/templates/local_vector.h"
 
 #ifdef TOOLS_ENABLED
+#include "../editor/gdscript_highlighter.h"
+
+#include "editor/file_system/editor_paths.h"
 #include "editor/settings/editor_settings.h"
+#include "scene/gui/text_edit.h"
 #endif
 
 namespace GDScriptTests {
@@ -365,4 +374,340 @@ void test(TestType p_type) {
 
 	finish_language();
 }
+
+static void collect_benchmark_sources(const String &p_dir, Vector<String> &r_sources) {
+	Ref<DirAccess> dir = DirAccess::open(p_dir);
+	if (dir.is_null()) {
+		return;
+	}
+
+	dir->list_dir_begin();
+	for (String next = dir->get_next(); !next.is_empty(); next = dir->get_next()) {
+		if (dir->current_is_dir()) {
+			if (next != "." && next != "..") {
+				collect_benchmark_sources(p_dir.path_join(next), r_sources);
+			}
+		} else if (next.has_extension("gd")) {
+			r_sources.push_back(FileAccess::get_file_as_string(p_dir.path_join(next)));
+		}
+	}
+	dir->list_dir_end();
+}
+
+void benchmark_tokenizer() {
+	const int ROUNDS = 20;
+
+	String dir = "modules/goblin/modules/gdscript/tests/scripts";
+	List<String> cmdlargs = OS::get_singleton()->get_cmdline_args();
+	if (!cmdlargs.is_empty() && DirAccess::exists(cmdlargs.back()->get())) {
+		dir = cmdlargs.back()->get();
+	}
+
+	Vector<String> sources;
+	collect_benchmark_sources(dir, sources);
+	if (sources.is_empty()) {
+		print_line("No GDScript files found under: " + dir);
+		return;
+	}
+
+	int64_t code_units = 0;
+	for (const String &source : sources) {
+		code_units += source.length();
+	}
+
+	int64_t tokens = 0;
+	uint64_t best_usec = UINT64_MAX;
+	for (int round = 0; round < ROUNDS; round++) {
+		int64_t round_tokens = 0;
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (const String &source : sources) {
+			GDScriptTokenizerText tokenizer;
+			tokenizer.set_source_code(source);
+			while (tokenizer.scan().type != GDScriptTokenizer::Token::TK_EOF) {
+				round_tokens++;
+			}
+		}
+		best_usec = MIN(best_usec, OS::get_singleton()->get_ticks_usec() - begin);
+		tokens = round_tokens;
+	}
+
+	const double seconds = MAX(best_usec, (uint64_t)1) / 1000000.0;
+	print_line(vformat("Tokenized %d files, %d code units, %d tokens (best of %d rounds).", sources.size(), code_units, tokens, ROUNDS));
+	print_line(vformat("%.3f ms per pass, %.2f M code units/s, %.2f M tokens/s.", seconds * 1000.0, code_units / seconds / 1000000.0, tokens / seconds / 1000000.0));
+}
+
+struct ScriptBenchmarkResult {
+	String name;
+	uint64_t median_usec = 0;
+	uint64_t p95_usec = 0;
+	int64_t mem_growth_bytes = 0; // Average growth of `Memory::get_mem_usage()` per run, not a count of live allocations.
+};
+
+static bool run_script_benchmark(const String &p_path, int p_warmup, int p_runs, ScriptBenchmarkResult &r_result) {
+	static const StringName benchmark_function_name = StringName("benchmark");
+
+	Ref<GDScript> script;
+	script.instantiate();
+	script->set_path(p_path);
+	if (script->load_source_code(p_path) != OK || script->reload() != OK) {
+		print_line("Could not load benchmark: " + p_path);
+		return false;
+	}
+	if (!script->get_member_functions().has(benchmark_function_name)) {
+		print_line("Benchmark has no benchmark() function: " + p_path);
+		return false;
+	}
+
+	Object *obj = ClassDB::instantiate(script->get_native()->get_name());
+	Ref<RefCounted> obj_ref;
+	if (obj->is_ref_counted()) {
+		obj_ref = Ref<RefCounted>(Object::cast_to<RefCounted>(obj));
+	}
+	obj->set_script(script);
+	ScriptInstance *instance = obj->get_script_instance();
+
+	Callable::CallError call_err;
+	for (int i = 0; i < p_warmup; i++) {
+		instance->callp(benchmark_function_name, nullptr, 0, call_err);
+	}
+
+	LocalVector<uint64_t> samples;
+	int64_t mem_growth = 0;
+	for (int i = 0; i < p_runs && call_err.error == Callable::CallError::CALL_OK; i++) {
+		const uint64_t mem_begin = Memory::get_mem_usage();
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		instance->callp(benchmark_function_name, nullptr, 0, call_err);
+		samples.push_back(OS::get_singleton()->get_ticks_usec() - begin);
+		mem_growth += (int64_t)Memory::get_mem_usage() - (int64_t)mem_begin;
+	}
+
+	if (obj_ref.is_null()) {
+		memdelete(obj);
+	}
+	GDScriptCache::remove_script(p_path);
+
+	if (call_err.error != Callable::CallError::CALL_OK || samples.is_empty()) {
+		print_line("Benchmark failed to run: " + p_path);
+		return false;
+	}
+
+	samples.sort();
+	r_result.name = p_path.get_file().get_basename();
+	r_result.median_usec = samples[samples.size() / 2];
+	r_result.p95_usec = samples[MIN(samples.size() - 1, (uint32_t)Math::ceil(samples.size() * 0.95) - 1)];
+	r_result.mem_growth_bytes = mem_growth / (int64_t)samples.size();
+	return true;
+}
+
+void benchmark_scripts() {
+	String dir = "modules/goblin/modules/gdscript/tests/benchmarks";
+	int warmup = 3;
+	int runs = 20;
+	double threshold = 10.0;
+	String baseline_path;
+	String save_path;
+
+	for (const String &arg : OS::get_singleton()->get_cmdline_args()) {
+		if (arg.begins_with("--benchmark-runs=")) {
+			runs = MAX(1, arg.get_slicec('=', 1).to_int());
+		} else if (arg.begins_with("--benchmark-warmup=")) {
+			warmup = MAX(0, arg.get_slicec('=', 1).to_int());
+		} else if (arg.begins_with("--benchmark-threshold=")) {
+			threshold = arg.get_slicec('=', 1).to_float();
+		} else if (arg.begins_with("--benchmark-baseline=")) {
+			baseline_path = arg.substr(arg.find_char('=') + 1);
+		} else if (arg == "--benchmark-save-baseline") {
+			save_path = "baseline.json";
+		} else if (arg.begins_with("--benchmark-save-baseline=")) {
+			save_path = arg.substr(arg.find_char('=') + 1);
+		} else if (!arg.begins_with("-") && DirAccess::dir_exists_absolute(arg)) {
+			dir = arg;
+		}
+	}
+	if (baseline_path.is_empty() && FileAccess::exists(dir.path_join("baseline.json"))) {
+		baseline_path = dir.path_join("baseline.json");
+	}
+	if (!save_path.is_empty() && save_path.is_relative_path()) {
+		save_path = dir.path_join(save_path);
+	}
+
+	PackedStringArray files = DirAccess::get_files_at(dir);
+	if (files.is_empty()) {
+		print_line("No GDScript benchmarks found under: " + dir);
+		return;
+	}
+
+	Dictionary baseline;
+	if (!baseline_path.is_empty()) {
+		const Dictionary data = JSON::parse_string(FileAccess::get_file_as_string(baseline_path));
+		baseline = data.get("benchmarks", Dictionary());
+	}
+
+	init_language(dir);
+
+	print_line(vformat("%s %10s %10s %12s %12s", String("Benchmark").rpad(24), "median ms", "p95 ms", "mem growth B", "vs baseline"));
+	Dictionary results;
+	int regressions = 0;
+	for (const String &file : files) {
+		if (!file.has_extension("gd")) {
+			continue;
+		}
+		ScriptBenchmarkResult result;
+		if (!run_script_benchmark(dir.path_join(file), warmup, runs, result)) {
+			continue;
+		}
+
+		String comparison = "-";
+		const Dictionary previous = baseline.get(result.name, Dictionary());
+		const uint64_t previous_median = (int64_t)previous.get("median_usec", 0);
+		if (previous_median > 0) {
+			const double change = 100.0 * ((double)result.median_usec - (double)previous_median) / (double)previous_median;
+			comparison = vformat("%+.1f%%", change);
+			if (change > threshold) {
+				comparison += " REGRESSION";
+				regressions++;
+			}
+		}
+#ifdef DEBUG_ENABLED
+		const String mem_growth = itos(result.mem_growth_bytes);
+#else
+		const String mem_growth = "-"; // The memory counter is only kept in debug builds.
+#endif
+		print_line(vformat("%s %10.3f %10.3f %12s %12s", result.name.rpad(24), result.median_usec / 1000.0, result.p95_usec / 1000.0, mem_growth, comparison));
+
+		Dictionary entry;
+		entry["median_usec"] = result.median_usec;
+		entry["p95_usec"] = result.p95_usec;
+		entry["mem_growth_bytes"] = result.mem_growth_bytes;
+		results[result.name] = entry;
+	}
+
+	finish_language();
+
+	print_line(vformat("%d runs after %d warm-up runs each.", runs, warmup));
+	if (!baseline.is_empty()) {
+		print_line(vformat("%d regression(s) above %.1f%% against %s.", regressions, threshold, baseline_path));
+	}
+
+	if (!save_path.is_empty()) {
+		Dictionary data;
+		data["runs"] = runs;
+		data["warmup"] = warmup;
+		data["benchmarks"] = results;
+		Ref<FileAccess> f = FileAccess::open(save_path, FileAccess::WRITE);
+		ERR_FAIL_COND_MSG(f.is_null(), "Could not write benchmark baseline: " + save_path);
+		f->store_string(JSON::stringify(data, "\t") + "\n");
+		print_line("Baseline written to " + save_path);
+	}
+}
+
+#ifdef TOOLS_ENABLED
+static String make_highlighter_benchmark_source(int p_lines) {
+	StringBuilder source;
+	int lines = 0;
+	for (int block = 0; lines < p_lines; block++) {
+		source += vformat("## Generated data block %d.\n", block);
+		source += vformat("const TABLE_%d = {\n", block);
+		source += vformat("\t\"name\": \"item_%d\", \"weight\": %d.5, \"path\": ^\"Root/Node_%d\",\n", block, block, block);
+		source += "\t\"tags\": [&\"a\", &\"b\"], # TODO: Trim.\n";
+		source += "}\n";
+		source += vformat("var description_%d := \"\"\"\n", block);
+		source += vformat("Multi-line string %d\n", block);
+		source += "with \"quotes\", escapes \\t and {placeholders} %s\n";
+		source += "\"\"\"\n";
+		source += "\n";
+		source += vformat("func compute_%d(value: int, scale := 2.0) -> float:\n", block);
+		source += "\tvar total := value * scale + 0x1F\n";
+		source += vformat("\tfor i in range(%d):\n", block % 97);
+		source += "\t\ttotal += sin(i) * 0.5 # Accumulate.\n";
+		source += "\treturn total\n";
+		source += "\n";
+		lines += 16;
+	}
+	return source.as_string();
+}
+
+static uint64_t highlight_lines(const Ref<GDScriptSyntaxHighlighter> &p_highlighter, int p_from, int p_to) {
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int line = p_from; line < p_to; line++) {
+		p_highlighter->get_line_syntax_highlighting(line);
+	}
+	return OS::get_singleton()->get_ticks_usec() - begin;
+}
+
+void benchmark_highlighter() {
+	int line_count = 20000;
+	for (const String &arg : OS::get_singleton()->get_cmdline_args()) {
+		if (arg.begins_with("--benchmark-lines=")) {
+			line_count = MAX(100, arg.get_slicec('=', 1).to_int());
+		}
+	}
+	const int VIEWPORT = 50;
+	const int KEYSTROKES = 40;
+
+	// The highlighter reads its colors from the editor settings.
+	const bool own_settings = EditorSettings::get_singleton() == nullptr;
+	if (own_settings) {
+		EditorPaths::create();
+		EditorSettings::create();
+	}
+
+	TextEdit *text_edit = memnew(TextEdit);
+	text_edit->set_text(make_highlighter_benchmark_source(line_count));
+	line_count = text_edit->get_line_count();
+	Ref<GDScriptSyntaxHighlighter> highlighter;
+	highlighter.instantiate();
+	highlighter->set_text_edit(text_edit);
+
+	// Drawing only requests visible lines; dropping the generic per-line cache of
+	// `SyntaxHighlighter` before each frame measures the GDScript line states alone.
+	print_line(vformat("Highlighting %d lines, %d-line viewport.", line_count, VIEWPORT));
+	uint64_t usec = 0;
+	for (int top = 0; top < line_count; top += VIEWPORT) {
+		usec += highlight_lines(highlighter, top, MIN(top + VIEWPORT, line_count));
+	}
+	print_line(vformat("%s %10.3f ms", String("Scroll to end, cold").rpad(36), usec / 1000.0));
+
+	highlighter->clear_highlighting_cache();
+	usec = 0;
+	for (int top = 0; top < line_count; top += VIEWPORT) {
+		usec += highlight_lines(highlighter, top, MIN(top + VIEWPORT, line_count));
+	}
+	print_line(vformat("%s %10.3f ms", String("Scroll to end, warm").rpad(36), usec / 1000.0));
+
+	// Typing in a function body near the top, then looking at the end of the file.
+	const int edit_line = 12;
+	LocalVector<uint64_t> keystrokes;
+	for (int i = 0; i < KEYSTROKES; i++) {
+		text_edit->insert_text("x", edit_line, text_edit->get_line(edit_line).length());
+		highlighter->clear_highlighting_cache();
+		keystrokes.push_back(highlight_lines(highlighter, 0, MIN(VIEWPORT, line_count)));
+	}
+	keystrokes.sort();
+	print_line(vformat("%s %10.3f ms (p95 %.3f ms)", String("Keystroke, median").rpad(36), keystrokes[keystrokes.size() / 2] / 1000.0, keystrokes[keystrokes.size() * 95 / 100] / 1000.0));
+
+	highlighter->clear_highlighting_cache();
+	usec = highlight_lines(highlighter, line_count - VIEWPORT, line_count);
+	print_line(vformat("%s %10.3f ms", String("Jump to end after typing").rpad(36), usec / 1000.0));
+
+	// Opening a multi-line string flips the region state of every line below it.
+	text_edit->insert_text("\"\"\"", edit_line, 0);
+	highlighter->clear_highlighting_cache();
+	usec = highlight_lines(highlighter, 0, VIEWPORT) + highlight_lines(highlighter, line_count - VIEWPORT, line_count);
+	print_line(vformat("%s %10.3f ms", String("Open string, jump to end").rpad(36), usec / 1000.0));
+
+	text_edit->remove_text(edit_line, 0, edit_line, 3);
+	highlighter->clear_highlighting_cache();
+	usec = highlight_lines(highlighter, 0, VIEWPORT) + highlight_lines(highlighter, line_count - VIEWPORT, line_count);
+	print_line(vformat("%s %10.3f ms", String("Close string, jump to end").rpad(36), usec / 1000.0));
+
+	highlighter.unref();
+	memdelete(text_edit);
+	if (own_settings) {
+		EditorSettings::destroy();
+		EditorPaths::free();
+	}
+}
+#endif // TOOLS_ENABLED
+
 } // namespace GDScriptTests
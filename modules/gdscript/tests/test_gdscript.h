@@ -42,4 +42,19 @@ enum TestType {
 
 void test(TestType p_type);
 
+// Goblin: tokenizer throughput over a script corpus (every `.gd` under the
+// directory given as last argument, the fork test scripts by default).
+void benchmark_tokenizer();
+
+// Goblin: runs every `benchmark()` in the `.gd` files of a directory (`tests/benchmarks`
+// by default) after warm-up and prints median / p95 time and memory growth per run,
+// compared with a baseline JSON when one is given or `baseline.json` exists there.
+void benchmark_scripts();
+
+#ifdef TOOLS_ENABLED
+// Goblin: `GDScriptSyntaxHighlighter` on a generated file (`--benchmark-lines=<n>`, 20000 by
+// default): viewport-by-viewport scrolling, keystrokes, and edits that open/close a string region.
+void benchmark_highlighter();
+#endif
+
 } // namespace GDScriptTests
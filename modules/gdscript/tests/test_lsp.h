@@ -38,12 +38,15 @@
 #include "../language_server/gdscript_extend_parser.h"
 #include "../language_server/gdscript_language_protocol.h"
 #include "../language_server/gdscript_workspace.h"
+#include "../language_server/gdscript_workspace_index.h"
 #include "../language_server/godot_lsp.h"
 #include "gdscript_test_runner.h"
 
 #include "core/io/dir_access.h"
+#include "editor/doc/doc_tools.h"
 #include "editor/file_system/editor_file_system.h"
 #include "tests/test_macros.h"
+#include "tests/test_utils.h"
 
 #include "modules/regex/regex.h"
 
@@ -320,6 +323,46 @@ void assert_no_errors_in(const String &p_path) {
 	REQUIRE_MESSAGE(err == OK, vformat("Errors while analyzing '%s'", p_path));
 }
 
+class TestGDScriptWorkspaceAccessor {
+public:
+	static String get_native_symbols_cache_key(const DocTools *p_doc) {
+		return GDScriptWorkspace::_get_native_symbols_cache_key(p_doc, "en");
+	}
+
+	static const LSP::DocumentSymbol *get_native_class_symbol(const Ref<GDScriptWorkspace> &p_workspace, const StringName &p_class, const DocTools *p_doc) {
+		return p_workspace->_get_native_class_symbol(p_class, p_doc);
+	}
+
+	static int get_native_symbol_count(const Ref<GDScriptWorkspace> &p_workspace) {
+		return p_workspace->native_symbols.size();
+	}
+
+	static Error save_native_symbols(const Ref<GDScriptWorkspace> &p_workspace, const String &p_path, const String &p_key, const DocTools *p_doc) {
+		return p_workspace->_save_native_symbols(p_path, p_key, p_doc);
+	}
+
+	static Error load_native_symbols(const Ref<GDScriptWorkspace> &p_workspace, const String &p_path, const String &p_key) {
+		return p_workspace->_load_native_symbols(p_path, p_key);
+	}
+};
+
+static DocData::ClassDoc make_native_test_class() {
+	DocData::ClassDoc class_doc;
+	class_doc.name = "GoblinNativeTest";
+	class_doc.inherits = "Object";
+	class_doc.description = "A test class.";
+	DocData::MethodDoc method;
+	method.name = "move";
+	method.return_type = "void";
+	method.description = "Moves.";
+	DocData::ArgumentDoc argument;
+	argument.name = "speed";
+	argument.type = "float";
+	method.arguments.push_back(argument);
+	class_doc.methods.push_back(method);
+	return class_doc;
+}
+
 // Note:
 // * Cursor is BETWEEN chars
 //	 * `va|r` -> cursor between `a`&`r`
@@ -453,6 +496,169 @@ TEST_SUITE("[Modules][GDScript][LSP][Editor]") {
 		finish_language();
 	}
 
+	TEST_CASE("[text_document][did_change] Incremental changes") {
+		EditorFileSystem *efs = memnew(EditorFileSystem);
+		GDScriptLanguageProtocol *proto = initialize(root);
+		REQUIRE(proto);
+		Ref<GDScriptWorkspace> workspace = proto->get_workspace();
+
+		const String path = "res://lsp/incremental_change.gd";
+		const String uri = workspace->get_file_uri(path);
+
+		Dictionary document;
+		document["uri"] = uri;
+		document["languageId"] = "gdscript";
+		document["version"] = 0;
+		document["text"] = "extends Node\n\nvar a := 1\n";
+		Dictionary open_params;
+		open_params["textDocument"] = document;
+		proto->lsp_did_open(open_params);
+
+		Dictionary identifier;
+		identifier["uri"] = uri;
+		identifier["version"] = 1;
+
+		Dictionary rename_var;
+		rename_var["range"] = range(pos(2, 4), pos(2, 5)).to_json();
+		rename_var["text"] = "abc";
+		Dictionary add_func;
+		add_func["range"] = range(pos(3, 0), pos(3, 0)).to_json();
+		add_func["text"] = "\nfunc f():\n\tpass\n";
+
+		Array changes;
+		changes.push_back(rename_var);
+		changes.push_back(add_func);
+		Dictionary change_params;
+		change_params["textDocument"] = identifier;
+		change_params["contentChanges"] = changes;
+		proto->lsp_did_change(change_params);
+
+		// Waits for the background parse of the edit, then analyzes it on this thread.
+		ExtendGDScriptParser *parser = proto->get_parse_result(path);
+		REQUIRE(parser);
+		const Vector<String> &lines = parser->get_lines();
+		REQUIRE_EQ(lines.size(), 7);
+		CHECK_EQ(lines[2], "var abc := 1");
+		CHECK_EQ(lines[4], "func f():");
+		CHECK(parser->get_member_symbol("abc") != nullptr);
+		CHECK(parser->get_member_symbol("f") != nullptr);
+		CHECK(parser->get_member_symbol("a") == nullptr);
+
+		// An edit made while the previous one is still being parsed supersedes it.
+		Dictionary rename_func;
+		rename_func["range"] = range(pos(4, 5), pos(4, 6)).to_json();
+		rename_func["text"] = "g";
+		Array first_changes;
+		first_changes.push_back(rename_func);
+		change_params["contentChanges"] = first_changes;
+		identifier["version"] = 2;
+		change_params["textDocument"] = identifier;
+		proto->lsp_did_change(change_params);
+		Dictionary rename_again;
+		rename_again["range"] = range(pos(4, 5), pos(4, 6)).to_json();
+		rename_again["text"] = "h";
+		Array second_changes;
+		second_changes.push_back(rename_again);
+		change_params["contentChanges"] = second_changes;
+		identifier["version"] = 3;
+		change_params["textDocument"] = identifier;
+		proto->lsp_did_change(change_params);
+
+		parser = proto->get_parse_result(path);
+		REQUIRE(parser);
+		CHECK_EQ(parser->get_lines()[4], "func h():");
+		CHECK(parser->get_member_symbol("h") != nullptr);
+		CHECK(parser->get_member_symbol("g") == nullptr);
+		CHECK(parser->get_member_symbol("f") == nullptr);
+
+		Dictionary close_params;
+		close_params["textDocument"] = identifier;
+		proto->lsp_did_close(close_params);
+
+		memdelete(efs);
+		finish_language();
+	}
+
+	TEST_CASE("[workspace][index] Identifier index") {
+		GDScriptWorkspaceIndex index;
+		index.update_file("res://a.gd", "var speed := 1\n\nfunc go():\n\tspeed += 1 # speed in a comment\n", 0);
+		index.update_file("res://b.gd", "var other = \"speed\"\n", 0);
+
+		List<String> files;
+		index.get_files_with("speed", files);
+		REQUIRE_EQ(files.size(), 1);
+		CHECK_EQ(files.front()->get(), "res://a.gd");
+
+		const GDScriptWorkspaceIndex::Occurrences *occurrences = index.get_occurrences("res://a.gd", "speed");
+		REQUIRE(occurrences);
+		REQUIRE_EQ(occurrences->size(), 2u);
+		CHECK_EQ((*occurrences)[0], Vector2i(4, 0));
+		CHECK_EQ((*occurrences)[1], Vector2i(1, 3));
+
+		index.update_file("res://a.gd", "var velocity := 1\n", 0);
+		files.clear();
+		index.get_files_with("speed", files);
+		CHECK(files.is_empty());
+
+		index.remove_file("res://b.gd");
+		CHECK_FALSE(index.has_file("res://b.gd"));
+		CHECK(index.get_occurrences("res://b.gd", "other") == nullptr);
+	}
+
+	TEST_CASE("[workspace][native_symbols] Lazy symbols and cache") {
+		DocTools doc;
+		doc.class_list["GoblinNativeTest"] = make_native_test_class();
+		const String key = TestGDScriptWorkspaceAccessor::get_native_symbols_cache_key(&doc);
+
+		SUBCASE("The cache key follows signatures and docs, not only member counts") {
+			DocTools renamed;
+			renamed.class_list["GoblinNativeTest"] = make_native_test_class();
+			CHECK_EQ(TestGDScriptWorkspaceAccessor::get_native_symbols_cache_key(&renamed), key);
+			renamed.class_list["GoblinNativeTest"].methods.write[0].arguments.write[0].name = "velocity";
+			CHECK_NE(TestGDScriptWorkspaceAccessor::get_native_symbols_cache_key(&renamed), key);
+
+			DocTools redocumented;
+			redocumented.class_list["GoblinNativeTest"] = make_native_test_class();
+			redocumented.class_list["GoblinNativeTest"].methods.write[0].description = "Moves faster.";
+			CHECK_NE(TestGDScriptWorkspaceAccessor::get_native_symbols_cache_key(&redocumented), key);
+		}
+
+		SUBCASE("Symbols are built per class, and read back from the cache") {
+			Ref<GDScriptWorkspace> workspace;
+			workspace.instantiate();
+			CHECK(TestGDScriptWorkspaceAccessor::get_native_class_symbol(workspace, "Unknown", &doc) == nullptr);
+			const LSP::DocumentSymbol *symbol = TestGDScriptWorkspaceAccessor::get_native_class_symbol(workspace, "GoblinNativeTest", &doc);
+			REQUIRE(symbol != nullptr);
+			REQUIRE_EQ(symbol->children.size(), 1);
+			CHECK_EQ(symbol->children[0].name, "move");
+			CHECK_EQ(symbol->children[0].detail, "func GoblinNativeTest.move(speed: float) -> void");
+			CHECK_EQ(TestGDScriptWorkspaceAccessor::get_native_symbol_count(workspace), 1);
+			// Built once.
+			CHECK_EQ(TestGDScriptWorkspaceAccessor::get_native_class_symbol(workspace, "GoblinNativeTest", &doc), symbol);
+
+			const String cache_path = TestUtils::get_temp_path("goblin_lsp_native_symbols.bin");
+			REQUIRE_EQ(TestGDScriptWorkspaceAccessor::save_native_symbols(workspace, cache_path, key, &doc), OK);
+
+			Ref<GDScriptWorkspace> stale;
+			stale.instantiate();
+			CHECK_EQ(TestGDScriptWorkspaceAccessor::load_native_symbols(stale, cache_path, key + "x"), ERR_FILE_UNRECOGNIZED);
+			CHECK_EQ(TestGDScriptWorkspaceAccessor::get_native_symbol_count(stale), 0);
+
+			Ref<GDScriptWorkspace> cached;
+			cached.instantiate();
+			REQUIRE_EQ(TestGDScriptWorkspaceAccessor::load_native_symbols(cached, cache_path, key), OK);
+			CHECK_EQ(TestGDScriptWorkspaceAccessor::get_native_symbol_count(cached), 1);
+			DocTools empty;
+			const LSP::DocumentSymbol *loaded = TestGDScriptWorkspaceAccessor::get_native_class_symbol(cached, "GoblinNativeTest", &empty);
+			REQUIRE(loaded != nullptr);
+			REQUIRE_EQ(loaded->children.size(), 1);
+			CHECK_EQ(loaded->children[0].detail, symbol->children[0].detail);
+			CHECK_EQ(loaded->children[0].documentation, symbol->children[0].documentation);
+
+			DirAccess::remove_absolute(cache_path);
+		}
+	}
+
 	TEST_CASE("BBCode to markdown conversion") {
 		// This tests the conversion from BBCode docstrings to the markdown markup sent to
 		// the LSP client on documentation requests
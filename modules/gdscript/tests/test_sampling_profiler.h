@@ -0,0 +1,70 @@
+/**************************************************************************/
+/*  test_sampling_profiler.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                            GOBLIN ENGINE                               */
+/**************************************************************************/
+
+#pragma once
+
+#include "../gdscript.h"
+#include "../gdscript_sampling_profiler.h"
+
+#include "core/io/file_access.h"
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace GDScriptTests {
+
+TEST_SUITE("[Modules][GDScript][SamplingProfiler]") {
+	TEST_CASE("Samples name the script function that keeps the VM busy") {
+		REQUIRE_FALSE(GDScriptSamplingProfiler::is_active());
+		GDScriptLanguage::get_singleton()->init();
+		Ref<GDScript> gdscript = memnew(GDScript);
+		gdscript->set_source_code(R"(
+extends RefCounted
+
+func busy_for(usec):
+	var total := 0
+	var begin := Time.get_ticks_usec()
+	while Time.get_ticks_usec() - begin < usec:
+		total += 1
+	return total
+)");
+		ERR_PRINT_OFF;
+		const Error error = gdscript->reload();
+		ERR_PRINT_ON;
+		REQUIRE(error == OK);
+		Ref<RefCounted> ref_counted = memnew(RefCounted);
+		ref_counted->set_script(gdscript);
+
+		GDScriptSamplingProfiler::clear();
+		GDScriptSamplingProfiler::start();
+		CHECK(GDScriptSamplingProfiler::is_active());
+		ref_counted->call("busy_for", 100000);
+		GDScriptSamplingProfiler::stop();
+		CHECK_FALSE(GDScriptSamplingProfiler::is_active());
+
+		// Folded stacks: "main;<path>:busy_for:<line> <samples>".
+		const String stacks_path = TestUtils::get_temp_path("sampling_profiler.folded");
+		REQUIRE(GDScriptSamplingProfiler::save_stacks(stacks_path) == OK);
+		const String stacks = FileAccess::get_file_as_string(stacks_path);
+		CHECK(stacks.begins_with("main;"));
+		CHECK(stacks.contains(":busy_for:"));
+
+		// Line table: "<percent> <samples>  <path>:<line> (busy_for)".
+		const String lines_path = TestUtils::get_temp_path("sampling_profiler.lines.txt");
+		REQUIRE(GDScriptSamplingProfiler::save_lines(lines_path) == OK);
+		const String lines = FileAccess::get_file_as_string(lines_path);
+		CHECK(lines.contains("(busy_for)"));
+		CHECK_FALSE(lines.begins_with("# 0 samples"));
+
+		// Nothing is recorded while stopped.
+		GDScriptSamplingProfiler::clear();
+		ref_counted->call("busy_for", 10000);
+		REQUIRE(GDScriptSamplingProfiler::save_lines(lines_path) == OK);
+		CHECK(FileAccess::get_file_as_string(lines_path).begins_with("# 0 samples"));
+	}
+}
+
+} // namespace GDScriptTests
@@ -0,0 +1,142 @@
+/**************************************************************************/
+/*  test_schema_index.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                            GOBLIN ENGINE                               */
+/**************************************************************************/
+
+#pragma once
+
+#include "../gdscript_schema_index.h"
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace GDScriptTests {
+
+static String write_schema_test_file(const String &p_name, const String &p_source) {
+	const String path = TestUtils::get_temp_path(p_name);
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+	f->store_string(p_source);
+	return path;
+}
+
+static GDScriptParser::DataType make_builtin_test_type(Variant::Type p_type) {
+	GDScriptParser::DataType type;
+	type.kind = GDScriptParser::DataType::BUILTIN;
+	type.type_source = GDScriptParser::DataType::ANNOTATED_EXPLICIT;
+	type.builtin_type = p_type;
+	return type;
+}
+
+// `@schema const <p_name> = { "hp": 10, <p_nested_key>: <p_nested> }`.
+static GDScriptParser::DataType make_schema_test_type(const StringName &p_name, const StringName &p_nested_key = StringName(), const StringName &p_nested = StringName()) {
+	GDScriptParser::DataType type = make_builtin_test_type(Variant::DICTIONARY);
+	type.is_schema = true;
+	type.schema_name = p_name;
+	type.dictionary_shape_keys.push_back("hp");
+	type.dictionary_shape_value_types.push_back(make_builtin_test_type(Variant::INT));
+	type.dictionary_shape_defaults.push_back(10);
+	if (p_nested != StringName()) {
+		GDScriptParser::DataType nested = make_schema_test_type(p_nested);
+		type.dictionary_shape_keys.push_back(p_nested_key);
+		type.dictionary_shape_value_types.push_back(nested);
+		Dictionary nested_default;
+		nested_default["hp"] = 10;
+		type.dictionary_shape_defaults.push_back(nested_default);
+	}
+	return type;
+}
+
+TEST_SUITE("[Modules][GDScript][SchemaIndex]") {
+	TEST_CASE("Compiled schemas survive a write and read of the index") {
+		const String stats_path = write_schema_test_file("schema_stats.gd", "@schema const Stats = { \"hp\": 10 }\n");
+		const String unit_path = write_schema_test_file("schema_unit.gd", "@schema const Unit = { \"hp\": 10, \"stats\": Stats }\n");
+		const String index_path = TestUtils::get_temp_path("goblin_schema_index_roundtrip.bin");
+
+		GDScriptSchemaIndex index;
+		index.set_datatype("Stats", stats_path, make_schema_test_type("Stats"), Vector<String>());
+		index.set_datatype("Unit", unit_path, make_schema_test_type("Unit", "stats", "Stats"), { stats_path });
+		index.add("Named", unit_path);
+		CHECK(index.is_dirty());
+		REQUIRE(index.save(index_path) == OK);
+		CHECK_FALSE(index.is_dirty());
+
+		GDScriptSchemaIndex loaded;
+		REQUIRE(loaded.load(index_path) == OK);
+		CHECK_FALSE(loaded.is_dirty());
+		CHECK(loaded.get_path("Unit") == unit_path);
+		CHECK(loaded.get_path("Named") == unit_path);
+
+		GDScriptParser::DataType unit;
+		REQUIRE(loaded.get_datatype("Unit", unit));
+		CHECK(unit.is_schema);
+		CHECK(unit.schema_name == StringName("Unit"));
+		REQUIRE(unit.dictionary_shape_keys.size() == 2);
+		CHECK(unit.dictionary_shape_keys[1] == StringName("stats"));
+		CHECK(unit.dictionary_shape_value_types[0].builtin_type == Variant::INT);
+		CHECK(unit.dictionary_shape_value_types[1].schema_name == StringName("Stats"));
+		CHECK(unit.dictionary_shape_defaults[0] == Variant(10));
+		CHECK(Dictionary(unit.dictionary_shape_defaults[1])["hp"] == Variant(10));
+		GDScriptParser::DataType named;
+		CHECK_FALSE(loaded.get_datatype("Named", named));
+
+		// Publishing the same datatype again leaves the index clean, a different one doesn't.
+		loaded.set_datatype("Unit", unit_path, make_schema_test_type("Unit", "stats", "Stats"), { stats_path });
+		CHECK_FALSE(loaded.is_dirty());
+		GDScriptParser::DataType changed = make_schema_test_type("Unit", "stats", "Stats");
+		changed.dictionary_shape_defaults.write[0] = 20;
+		loaded.set_datatype("Unit", unit_path, changed, { stats_path });
+		CHECK(loaded.is_dirty());
+
+		// An index written in an older format is ignored.
+		Ref<FileAccess> f = FileAccess::open(index_path, FileAccess::WRITE);
+		f->store_32(0x49534447);
+		f->store_32(1);
+		f = Ref<FileAccess>();
+		CHECK(loaded.load(index_path) == ERR_FILE_UNRECOGNIZED);
+
+		DirAccess::remove_absolute(index_path);
+		DirAccess::remove_absolute(stats_path);
+		DirAccess::remove_absolute(unit_path);
+	}
+
+	TEST_CASE("Compiled schemas go stale with the scripts they depend on") {
+		const String base_path = write_schema_test_file("schema_base.gd", "const BASE_HP = 10\n");
+		const String stats_path = write_schema_test_file("schema_stats_dep.gd", "@schema const Stats = { \"hp\": Base.BASE_HP }\n");
+		const String unit_path = write_schema_test_file("schema_unit_dep.gd", "@schema const Unit = { \"hp\": 10, \"stats\": Stats }\n");
+
+		GDScriptSchemaIndex index;
+		index.set_datatype("Stats", stats_path, make_schema_test_type("Stats"), { base_path });
+		// `Unit` only depends on `Stats` directly; the nested schema brings its own dependencies.
+		index.set_datatype("Unit", unit_path, make_schema_test_type("Unit", "stats", "Stats"), { stats_path });
+		GDScriptParser::DataType type;
+		CHECK(index.get_datatype("Stats", type));
+		CHECK(index.get_datatype("Unit", type));
+
+		ERR_PRINT_OFF;
+		DirAccess::remove_absolute(base_path);
+		CHECK_FALSE(index.get_datatype("Stats", type));
+		CHECK_FALSE(index.get_datatype("Unit", type));
+		ERR_PRINT_ON;
+
+		// Not compiled data: only the name is registered, and nothing is served.
+		index.set_datatype("Stats", stats_path, GDScriptParser::DataType(), Vector<String>());
+		CHECK(index.has("Stats"));
+		CHECK_FALSE(index.get_datatype("Stats", type));
+
+		// The declaring script itself.
+		index.set_datatype("Unit", unit_path, make_schema_test_type("Unit"), Vector<String>());
+		CHECK(index.get_datatype("Unit", type));
+		DirAccess::remove_absolute(unit_path);
+		ERR_PRINT_OFF;
+		CHECK_FALSE(index.get_datatype("Unit", type));
+		ERR_PRINT_ON;
+
+		DirAccess::remove_absolute(stats_path);
+	}
+}
+
+} // namespace GDScriptTests
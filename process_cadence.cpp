@@ -0,0 +1,233 @@
+/**************************************************************************/
+/*  process_cadence.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                            GOBLIN ENGINE                               */
+/**************************************************************************/
+
+#include "process_cadence.h"
+
+#include "core/config/engine.h"
+#include "core/object/callable_mp.h"
+#include "core/object/class_db.h"
+#include "main/performance.h"
+#include "scene/main/node.h"
+
+static constexpr uint64_t SWEEP_INTERVAL = 64; // Frames between drops of freed nodes.
+
+uint64_t ProcessCadence::_get_processed_monitor() {
+	return singleton != nullptr ? singleton->processed_last : 0;
+}
+
+uint64_t ProcessCadence::_get_deferred_monitor() {
+	return singleton != nullptr ? singleton->deferred_last : 0;
+}
+
+uint64_t ProcessCadence::_get_busiest_bucket_monitor() {
+	return singleton != nullptr ? singleton->get_busiest_bucket_load() : 0;
+}
+
+// The measured frame rate, or 60 until the first second has been measured.
+int ProcessCadence::_get_frame_rate() const {
+	const int fps = (int)Math::round(Engine::get_singleton()->get_frames_per_second());
+	return fps > 0 ? fps : 60;
+}
+
+uint32_t ProcessCadence::_frames_for_rate(double p_rate) const {
+	const double frames = Math::round(frame_rate / p_rate);
+	return (uint32_t)CLAMP(frames, 1.0, (double)MAX_CADENCE);
+}
+
+void ProcessCadence::_assign_bucket(Entry &r_entry) {
+	LocalVector<uint32_t> &buckets = loads[r_entry.frames];
+	if (buckets.size() < r_entry.frames) {
+		buckets.resize_initialized(r_entry.frames);
+	}
+	const uint32_t start = rotor++ % r_entry.frames;
+	uint32_t best = start;
+	for (uint32_t i = 1; i < r_entry.frames; i++) {
+		const uint32_t bucket = (start + i) % r_entry.frames;
+		if (buckets[bucket] < buckets[best]) {
+			best = bucket;
+		}
+	}
+	buckets[best]++;
+	r_entry.bucket = best;
+}
+
+void ProcessCadence::_release_bucket(const Entry &p_entry) {
+	LocalVector<uint32_t> *buckets = loads.getptr(p_entry.frames);
+	ERR_FAIL_NULL(buckets);
+	(*buckets)[p_entry.bucket]--;
+}
+
+void ProcessCadence::_set_entry(Node *p_node, uint32_t p_frames, double p_rate) {
+	const ObjectID id = p_node->get_instance_id();
+	Entry *entry = entries.getptr(id);
+	if (entry == nullptr) {
+		entry = &entries.insert(id, Entry())->value;
+	} else {
+		_release_bucket(*entry);
+		rate_entries -= entry->rate > 0.0;
+	}
+	entry->frames = p_frames;
+	entry->rate = p_rate;
+	rate_entries += p_rate > 0.0;
+	_assign_bucket(*entry);
+}
+
+void ProcessCadence::set_process_cadence(Node *p_node, int p_frames) {
+	ERR_FAIL_NULL(p_node);
+	ERR_FAIL_COND_MSG(p_frames > MAX_CADENCE, vformat("Process cadence can't exceed %d frames.", MAX_CADENCE));
+	if (p_frames <= 1) {
+		clear_process_cadence(p_node);
+		return;
+	}
+	_set_entry(p_node, p_frames, 0.0);
+}
+
+void ProcessCadence::set_process_rate(Node *p_node, double p_rate) {
+	ERR_FAIL_NULL(p_node);
+	if (p_rate <= 0.0) {
+		clear_process_cadence(p_node);
+		return;
+	}
+	if (frame_rate == 0) {
+		frame_rate = _get_frame_rate();
+	}
+	_set_entry(p_node, _frames_for_rate(p_rate), p_rate);
+}
+
+void ProcessCadence::clear_process_cadence(Node *p_node) {
+	ERR_FAIL_NULL(p_node);
+	HashMap<ObjectID, Entry>::Iterator E = entries.find(p_node->get_instance_id());
+	if (!E) {
+		return;
+	}
+	_release_bucket(E->value);
+	rate_entries -= E->value.rate > 0.0;
+	entries.remove(E);
+}
+
+int ProcessCadence::get_process_cadence(Node *p_node) const {
+	ERR_FAIL_NULL_V(p_node, 1);
+	const Entry *entry = entries.getptr(p_node->get_instance_id());
+	return entry != nullptr ? entry->frames : 1;
+}
+
+double ProcessCadence::get_process_rate(Node *p_node) const {
+	ERR_FAIL_NULL_V(p_node, 0.0);
+	const Entry *entry = entries.getptr(p_node->get_instance_id());
+	return entry != nullptr ? entry->rate : 0.0;
+}
+
+PackedInt32Array ProcessCadence::get_bucket_loads(int p_frames) const {
+	PackedInt32Array result;
+	const LocalVector<uint32_t> *buckets = loads.getptr(p_frames);
+	if (buckets != nullptr) {
+		result.resize(buckets->size());
+		for (uint32_t i = 0; i < buckets->size(); i++) {
+			result.set(i, (*buckets)[i]);
+		}
+	}
+	return result;
+}
+
+int ProcessCadence::get_busiest_bucket_load() const {
+	uint32_t busiest = 0;
+	for (const KeyValue<uint32_t, LocalVector<uint32_t>> &E : loads) {
+		for (const uint32_t load : E.value) {
+			busiest = MAX(busiest, load);
+		}
+	}
+	return busiest;
+}
+
+void ProcessCadence::begin_frame() {
+	if (unlikely(!monitors_added) && Performance::get_singleton() != nullptr) {
+		Performance::get_singleton()->add_custom_monitor("Goblin/ProcessCadence/processed", callable_mp_static(&ProcessCadence::_get_processed_monitor), Vector<Variant>());
+		Performance::get_singleton()->add_custom_monitor("Goblin/ProcessCadence/deferred", callable_mp_static(&ProcessCadence::_get_deferred_monitor), Vector<Variant>());
+		Performance::get_singleton()->add_custom_monitor("Goblin/ProcessCadence/busiest_bucket", callable_mp_static(&ProcessCadence::_get_busiest_bucket_monitor), Vector<Variant>());
+		monitors_added = true;
+	}
+
+	frame++;
+	processed_last = processed;
+	deferred_last = deferred;
+	processed = 0;
+	deferred = 0;
+	if (entries.is_empty()) {
+		return;
+	}
+
+	// Rates follow the measured frame rate (updated once per second).
+	if (rate_entries > 0) {
+		const int fps = _get_frame_rate();
+		if (fps != frame_rate) {
+			frame_rate = fps;
+			for (KeyValue<ObjectID, Entry> &E : entries) {
+				if (E.value.rate > 0.0 && _frames_for_rate(E.value.rate) != E.value.frames) {
+					_release_bucket(E.value);
+					E.value.frames = _frames_for_rate(E.value.rate);
+					_assign_bucket(E.value);
+				}
+			}
+		}
+	}
+
+	if (frame % SWEEP_INTERVAL == 0) {
+		LocalVector<ObjectID> freed;
+		for (const KeyValue<ObjectID, Entry> &E : entries) {
+			if (ObjectDB::get_instance(E.key) == nullptr) {
+				freed.push_back(E.key);
+			}
+		}
+		for (const ObjectID &id : freed) {
+			HashMap<ObjectID, Entry>::Iterator E = entries.find(id);
+			_release_bucket(E->value);
+			rate_entries -= E->value.rate > 0.0;
+			entries.remove(E);
+		}
+	}
+}
+
+bool ProcessCadence::should_process(const Node *p_node, double p_delta, double &r_delta) {
+	Entry *entry = entries.getptr(p_node->get_instance_id());
+	if (entry == nullptr) {
+		r_delta = p_delta;
+		return true;
+	}
+	entry->pending += p_delta;
+	if (frame % entry->frames != entry->bucket) {
+		deferred++;
+		return false;
+	}
+	r_delta = entry->pending;
+	entry->pending = 0.0;
+	processed++;
+	return true;
+}
+
+void ProcessCadence::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_process_cadence", "node", "frames"), &ProcessCadence::set_process_cadence);
+	ClassDB::bind_method(D_METHOD("set_process_rate", "node", "rate"), &ProcessCadence::set_process_rate);
+	ClassDB::bind_method(D_METHOD("clear_process_cadence", "node"), &ProcessCadence::clear_process_cadence);
+	ClassDB::bind_method(D_METHOD("get_process_cadence", "node"), &ProcessCadence::get_process_cadence);
+	ClassDB::bind_method(D_METHOD("get_process_rate", "node"), &ProcessCadence::get_process_rate);
+	ClassDB::bind_method(D_METHOD("get_bucket_loads", "frames"), &ProcessCadence::get_bucket_loads);
+	ClassDB::bind_method(D_METHOD("get_busiest_bucket_load"), &ProcessCadence::get_busiest_bucket_load);
+
+	BIND_CONSTANT(MAX_CADENCE);
+}
+
+ProcessCadence::ProcessCadence() {
+	if (singleton == nullptr) {
+		singleton = this;
+	}
+}
+
+ProcessCadence::~ProcessCadence() {
+	if (singleton == this) {
+		singleton = nullptr;
+	}
+}
@@ -0,0 +1,92 @@
+/**************************************************************************/
+/*  process_cadence.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                            GOBLIN ENGINE                               */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/object.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+
+class Node;
+
+// Reduced process rates (`ProcessCadence` singleton), applied by `SceneTree::_process_group()`.
+//
+// A node with a cadence of N frames gets `NOTIFICATION_PROCESS` (and the internal one) on
+// one frame out of N, with the delta accumulated since its last process as
+// `get_process_delta_time()`. Nodes of the same cadence are spread over N staggered
+// buckets, each new node going to the least loaded one, so the work is even across
+// frames instead of landing on the same frame. A target rate in Hz is converted to frames
+// from the measured frame rate, and follows it when it changes.
+//
+// Only idle processing of nodes in main-thread process groups is rate-limited; physics
+// processing and sub-thread groups run every frame (their delta is shared with the other
+// threads of the frame).
+class ProcessCadence : public Object {
+	GDCLASS(ProcessCadence, Object);
+
+	static inline ProcessCadence *singleton = nullptr;
+
+	struct Entry {
+		uint32_t frames = 1;
+		uint32_t bucket = 0;
+		double rate = 0.0; // Hz, or 0 for a fixed number of frames.
+		double pending = 0.0; // Delta accumulated since the last process.
+	};
+
+	HashMap<ObjectID, Entry> entries;
+	HashMap<uint32_t, LocalVector<uint32_t>> loads; // Cadence -> nodes per bucket.
+	uint32_t rate_entries = 0;
+	uint32_t rotor = 0; // Where the least-loaded search starts, so cadences don't all favor bucket 0.
+	uint64_t frame = 0;
+	int frame_rate = 0; // Used to convert rates, see `_get_frame_rate()`.
+	bool monitors_added = false;
+
+	// Cadenced nodes processed and deferred, last frame and this one.
+	uint32_t processed = 0;
+	uint32_t deferred = 0;
+	uint32_t processed_last = 0;
+	uint32_t deferred_last = 0;
+
+	static uint64_t _get_processed_monitor();
+	static uint64_t _get_deferred_monitor();
+	static uint64_t _get_busiest_bucket_monitor();
+
+	int _get_frame_rate() const;
+	uint32_t _frames_for_rate(double p_rate) const;
+	void _assign_bucket(Entry &r_entry);
+	void _release_bucket(const Entry &p_entry);
+	void _set_entry(Node *p_node, uint32_t p_frames, double p_rate);
+
+protected:
+	static void _bind_methods();
+
+public:
+	enum {
+		MAX_CADENCE = 240,
+	};
+
+	static ProcessCadence *get_singleton() { return singleton; }
+
+	void set_process_cadence(Node *p_node, int p_frames);
+	void set_process_rate(Node *p_node, double p_rate);
+	void clear_process_cadence(Node *p_node);
+	int get_process_cadence(Node *p_node) const;
+	double get_process_rate(Node *p_node) const;
+
+	PackedInt32Array get_bucket_loads(int p_frames) const;
+	int get_busiest_bucket_load() const;
+
+	// Called by `SceneTree::process()` before the idle process pass.
+	void begin_frame();
+	_FORCE_INLINE_ bool is_empty() const { return entries.is_empty(); }
+	// Returns `false` if the node waits for its bucket this frame. Otherwise, `r_delta` is the
+	// delta to process it with. Main thread only.
+	bool should_process(const Node *p_node, double p_delta, double &r_delta);
+
+	ProcessCadence();
+	~ProcessCadence();
+};
@@ -0,0 +1,85 @@
+/**************************************************************************/
+/*  process_group_scheduler.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                            GOBLIN ENGINE                               */
+/**************************************************************************/
+
+#include "process_group_scheduler.h"
+
+#include "core/config/project_settings.h"
+#include "core/object/class_db.h"
+#include "scene/main/node.h"
+
+void ProcessGroupScheduler::set_overlap_main_thread(bool p_enabled) {
+	overlap_main_thread = p_enabled;
+}
+
+bool ProcessGroupScheduler::is_overlapping_main_thread() const {
+	return overlap_main_thread;
+}
+
+void ProcessGroupScheduler::set_split_threshold(int p_nodes) {
+	split_threshold = MAX(0, p_nodes);
+}
+
+int ProcessGroupScheduler::get_split_threshold() const {
+	return split_threshold;
+}
+
+TypedArray<Dictionary> ProcessGroupScheduler::get_group_timings(bool p_physics) const {
+	TypedArray<Dictionary> result;
+	for (const GroupTiming &timing : timings[p_physics]) {
+		Dictionary entry;
+		entry["owner"] = ObjectDB::get_instance(timing.owner);
+		entry["order"] = timing.order;
+		entry["threaded"] = timing.threaded;
+		entry["nodes"] = timing.nodes;
+		entry["tasks"] = timing.tasks;
+		entry["wall_usec"] = timing.wall_usec;
+		entry["busy_usec"] = timing.busy_usec;
+		result.push_back(entry);
+	}
+	return result;
+}
+
+void ProcessGroupScheduler::begin_pass(bool p_physics) {
+	timings[p_physics].clear();
+}
+
+void ProcessGroupScheduler::record_group(bool p_physics, const Node *p_owner, int p_order, bool p_threaded, uint32_t p_nodes, uint32_t p_tasks, uint64_t p_wall_usec, uint64_t p_busy_usec) {
+	GroupTiming timing;
+	timing.owner = p_owner != nullptr ? p_owner->get_instance_id() : ObjectID();
+	timing.order = p_order;
+	timing.threaded = p_threaded;
+	timing.nodes = p_nodes;
+	timing.tasks = p_tasks;
+	timing.wall_usec = p_wall_usec;
+	timing.busy_usec = p_busy_usec;
+	timings[p_physics].push_back(timing);
+}
+
+void ProcessGroupScheduler::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_overlap_main_thread", "enabled"), &ProcessGroupScheduler::set_overlap_main_thread);
+	ClassDB::bind_method(D_METHOD("is_overlapping_main_thread"), &ProcessGroupScheduler::is_overlapping_main_thread);
+	ClassDB::bind_method(D_METHOD("set_split_threshold", "nodes"), &ProcessGroupScheduler::set_split_threshold);
+	ClassDB::bind_method(D_METHOD("get_split_threshold"), &ProcessGroupScheduler::get_split_threshold);
+	ClassDB::bind_method(D_METHOD("get_group_timings", "physics"), &ProcessGroupScheduler::get_group_timings, DEFVAL(false));
+
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "overlap_main_thread"), "set_overlap_main_thread", "is_overlapping_main_thread");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "split_threshold", PROPERTY_HINT_RANGE, "0,100000,1,or_greater"), "set_split_threshold", "get_split_threshold");
+}
+
+ProcessGroupScheduler::ProcessGroupScheduler() {
+	if (singleton == nullptr) {
+		singleton = this;
+	}
+	overlap_main_thread = GLOBAL_DEF("threading/scene_tree/overlap_main_thread_groups", false);
+	set_split_threshold(GLOBAL_DEF(PropertyInfo(Variant::INT, "threading/scene_tree/split_group_threshold", PROPERTY_HINT_RANGE, "0,100000,1,or_greater"), 0));
+}
+
+ProcessGroupScheduler::~ProcessGroupScheduler() {
+	if (singleton == this) {
+		singleton = nullptr;
+	}
+}
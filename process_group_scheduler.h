@@ -0,0 +1,68 @@
+/**************************************************************************/
+/*  process_group_scheduler.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                            GOBLIN ENGINE                               */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/object.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/typed_array.h"
+
+class Node;
+
+// Process thread group scheduling options and per-group timings (`ProcessGroupScheduler`
+// singleton), used by `SceneTree::_process()`.
+//
+// Two opt-in changes to how a `process_thread_group_order` block runs:
+// - Overlap: the main thread processes the main-thread groups of an order while the
+//   sub-thread groups of the same order run, instead of waiting for them first. Main-thread
+//   nodes of that order must then not touch sub-thread nodes (collect their results from a
+//   greater order, as the process thread group documentation recommends).
+// - Splitting: a sub-thread group with more processing nodes than the threshold is cut into
+//   node ranges of that size, which idle workers pick up like any other task. Nodes of a
+//   split group may then run concurrently, so they must not touch each other.
+//
+// Wall and busy time of every process group is recorded each pass, for the idle and the
+// physics frame separately.
+class ProcessGroupScheduler : public Object {
+	GDCLASS(ProcessGroupScheduler, Object);
+
+	static inline ProcessGroupScheduler *singleton = nullptr;
+
+	struct GroupTiming {
+		ObjectID owner; // Null for the default group.
+		int order = 0;
+		bool threaded = false;
+		uint32_t nodes = 0;
+		uint32_t tasks = 0;
+		uint64_t wall_usec = 0;
+		uint64_t busy_usec = 0;
+	};
+
+	bool overlap_main_thread = false;
+	int split_threshold = 0;
+	LocalVector<GroupTiming> timings[2]; // Idle, physics.
+
+protected:
+	static void _bind_methods();
+
+public:
+	static ProcessGroupScheduler *get_singleton() { return singleton; }
+
+	void set_overlap_main_thread(bool p_enabled);
+	bool is_overlapping_main_thread() const;
+	void set_split_threshold(int p_nodes);
+	int get_split_threshold() const;
+
+	TypedArray<Dictionary> get_group_timings(bool p_physics = false) const;
+
+	// Main thread only, called by `SceneTree::_process()`.
+	void begin_pass(bool p_physics);
+	void record_group(bool p_physics, const Node *p_owner, int p_order, bool p_threaded, uint32_t p_nodes, uint32_t p_tasks, uint64_t p_wall_usec, uint64_t p_busy_usec);
+
+	ProcessGroupScheduler();
+	~ProcessGroupScheduler();
+};
@@ -7,6 +7,13 @@
 
 #include "register_types.h"
 
+#include "frame_timeline.h"
+#include "process_cadence.h"
+#include "process_group_scheduler.h"
+#include "scene_tree_group_iterator.h"
+#include "spatial_group_index.h"
+#include "tween_batch.h"
+
 #include "core/config/engine.h"
 #include "core/object/class_db.h"
 
@@ -14,11 +21,48 @@
 #include "editor/branding_translations.h"
 #endif
 
+static TweenBatch *tween_batch = nullptr;
+static ProcessCadence *process_cadence = nullptr;
+static ProcessGroupScheduler *process_group_scheduler = nullptr;
+#ifndef _3D_DISABLED
+static SpatialGroupIndex *spatial_group_index = nullptr;
+#endif // _3D_DISABLED
+
 void preregister_goblin_types() {
 	// Called before other modules for docgen
 }
 
 void initialize_goblin_module(ModuleInitializationLevel p_level) {
+	if (p_level == MODULE_INITIALIZATION_LEVEL_SCENE) {
+		// Frame timeline capture (all build types, headless included).
+		FrameTimeline::configure();
+
+		// Batched property tweens, stepped by SceneTree::process_tweens().
+		GDREGISTER_ABSTRACT_CLASS(TweenBatch);
+		tween_batch = memnew(TweenBatch);
+		Engine::get_singleton()->add_singleton(Engine::Singleton("TweenBatch", tween_batch));
+
+		// Reduced process rates, applied by SceneTree::_process_group().
+		GDREGISTER_ABSTRACT_CLASS(ProcessCadence);
+		process_cadence = memnew(ProcessCadence);
+		Engine::get_singleton()->add_singleton(Engine::Singleton("ProcessCadence", process_cadence));
+
+		// Process thread group scheduling options and timings, used by SceneTree::_process().
+		GDREGISTER_ABSTRACT_CLASS(ProcessGroupScheduler);
+		process_group_scheduler = memnew(ProcessGroupScheduler);
+		Engine::get_singleton()->add_singleton(Engine::Singleton("ProcessGroupScheduler", process_group_scheduler));
+
+		// Copy-free group walks, for `for node in SceneTreeGroupIterator.iterate(&"group"):`.
+		GDREGISTER_ABSTRACT_CLASS(SceneTreeGroupIterator);
+
+#ifndef _3D_DISABLED
+		// Radius, AABB and nearest-member queries on Node3D groups, kept up to date by SceneTree.
+		GDREGISTER_ABSTRACT_CLASS(SpatialGroupIndex);
+		spatial_group_index = memnew(SpatialGroupIndex);
+		Engine::get_singleton()->add_singleton(Engine::Singleton("SpatialGroupIndex", spatial_group_index));
+#endif // _3D_DISABLED
+	}
+
 	// Project Manager + Editor UI are initialized at EDITOR level.
 	// We also initialize at SCENE level to cover non-editor runtime usage.
 #ifdef TOOLS_ENABLED
@@ -31,6 +75,29 @@ void initialize_goblin_module(ModuleInitializationLevel p_level) {
 }
 
 void uninitialize_goblin_module(ModuleInitializationLevel p_level) {
-	// No per-level cleanup: branding translations are not unregistered (parity
-	// with the previous runtime singletons, which never removed them).
+	// Branding translations are not unregistered (parity with the previous
+	// runtime singletons, which never removed them).
+	if (p_level == MODULE_INITIALIZATION_LEVEL_SCENE) {
+		FrameTimeline::finish();
+
+		SceneTreeGroupIterator::clear_pool();
+
+		Engine::get_singleton()->remove_singleton("TweenBatch");
+		memdelete(tween_batch);
+		tween_batch = nullptr;
+
+		Engine::get_singleton()->remove_singleton("ProcessCadence");
+		memdelete(process_cadence);
+		process_cadence = nullptr;
+
+		Engine::get_singleton()->remove_singleton("ProcessGroupScheduler");
+		memdelete(process_group_scheduler);
+		process_group_scheduler = nullptr;
+
+#ifndef _3D_DISABLED
+		Engine::get_singleton()->remove_singleton("SpatialGroupIndex");
+		memdelete(spatial_group_index);
+		spatial_group_index = nullptr;
+#endif // _3D_DISABLED
+	}
 }
@@ -43,7 +43,14 @@ STATIC_ASSERT_INCOMPLETE_TYPE(class, RenderingServer);
 #include "core/object/class_db.h"
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
+#include "core/os/rw_lock.h"
 #include "core/profiling/profiling.h"
+#include "core/templates/safe_refcount.h"
+#include "modules/goblin/frame_timeline.h"
+#include "modules/goblin/process_cadence.h"
+#include "modules/goblin/process_group_scheduler.h"
+#include "modules/goblin/scene_tree_group_iterator.h"
+#include "modules/goblin/tween_batch.h"
 #include "scene/animation/tween.h"
 #include "scene/debugger/scene_debugger.h"
 #include "scene/gui/control.h"
@@ -62,6 +69,7 @@ STATIC_ASSERT_INCOMPLETE_TYPE(class, RenderingServer);
 #include "servers/rendering/rendering_server.h"
 
 #ifndef _3D_DISABLED
+#include "modules/goblin/spatial_group_index.h"
 #include "scene/3d/node_3d.h"
 #include "scene/resources/3d/world_3d.h"
 #endif // _3D_DISABLED
@@ -74,6 +82,188 @@ STATIC_ASSERT_INCOMPLETE_TYPE(class, RenderingServer);
 #include "servers/physics_3d/physics_server_3d.h"
 #endif // PHYSICS_3D_DISABLED
 
+#include <atomic>
+
+// Goblin Engine: fast scene tree (M-18) — timer queues. Scheduled timers sit in
+// a min-heap per queue (idle/physics × pausable/always × scaled/unscaled), keyed
+// by absolute expiry on that queue's clock, so a frame advances the clocks and
+// pops what expired instead of decrementing every timer. Upstream fires a timer
+// once `time_left` minus each frame's delta reaches 0; the clock agrees with that
+// except when the deltas add up to the time exactly (0.3 against 18 frames of
+// 1/60 fires a frame early on the clock), so entries within rounding distance of
+// their expiry replay upstream's countdown over the queue's last deltas. The log
+// is a fixed window: a timer scheduled before it starts its replay from the
+// clock's time left at the window start, which only differs from upstream by
+// the rounding of the frames before the window.
+// `SceneTree::timers` still owns the timers in creation order; the per-timer
+// state lives here since the class headers are upstream. Rescheduling pushes a
+// new heap entry and bumps the version, which leaves the old entry stale. Fired
+// timers are not recycled: scripts can keep their `timeout` signal or instance
+// ID past the timeout.
+struct TimerHeapEntry {
+	double expiry = 0.0;
+	uint64_t order = 0; // Creation order, the order timeouts fire in.
+	SceneTreeTimer *timer = nullptr;
+	uint32_t version = 0;
+};
+
+// Frames of deltas kept for the countdown replay (about 4 seconds at 60 FPS).
+static constexpr uint32_t TIMER_DELTA_WINDOW = 256;
+
+struct TimerQueue {
+	double clock = 0.0;
+	LocalVector<TimerHeapEntry> heap;
+	uint32_t live = 0;
+	// Ring of the last deltas; frame `f` advanced the clock by `deltas[f % TIMER_DELTA_WINDOW]`.
+	LocalVector<double> deltas;
+	uint64_t frame = 0; // Frames advanced since the queue was restarted.
+	double window_clock = 0.0; // Clock at the first frame still in `deltas`.
+};
+
+struct ScheduledTimer {
+	SceneTree *tree = nullptr;
+	List<Ref<SceneTreeTimer>>::Element *element = nullptr;
+	double expiry = 0.0;
+	double time = 0.0; // Time left when scheduled, at queue frame `frame`.
+	uint64_t frame = 0;
+	uint64_t order = 0;
+	uint32_t version = 0;
+	uint8_t queue = 0;
+};
+
+struct TreeTimers {
+	TimerQueue queues[8];
+	uint64_t next_order = 0;
+};
+
+static HashMap<const SceneTree *, TreeTimers> tree_timers;
+static HashMap<const SceneTreeTimer *, ScheduledTimer> scheduled_timers;
+static Mutex timers_mutex;
+
+static uint8_t _timer_queue_index(bool p_physics, bool p_process_always, bool p_ignore_time_scale) {
+	return (p_physics ? 1 : 0) | (p_process_always ? 2 : 0) | (p_ignore_time_scale ? 4 : 0);
+}
+
+static bool _timer_entry_less(const TimerHeapEntry &p_a, const TimerHeapEntry &p_b) {
+	return p_a.expiry < p_b.expiry || (p_a.expiry == p_b.expiry && p_a.order < p_b.order);
+}
+
+static void _timer_heap_push(LocalVector<TimerHeapEntry> &p_heap, const TimerHeapEntry &p_entry) {
+	uint32_t i = p_heap.size();
+	p_heap.push_back(p_entry);
+	while (i > 0) {
+		const uint32_t parent = (i - 1) / 2;
+		if (!_timer_entry_less(p_heap[i], p_heap[parent])) {
+			break;
+		}
+		SWAP(p_heap[i], p_heap[parent]);
+		i = parent;
+	}
+}
+
+static TimerHeapEntry _timer_heap_pop(LocalVector<TimerHeapEntry> &p_heap) {
+	const TimerHeapEntry top = p_heap[0];
+	p_heap[0] = p_heap[p_heap.size() - 1];
+	p_heap.resize(p_heap.size() - 1);
+	const uint32_t count = p_heap.size();
+	uint32_t i = 0;
+	while (true) {
+		const uint32_t left = i * 2 + 1;
+		if (left >= count) {
+			break;
+		}
+		const uint32_t child = (left + 1 < count && _timer_entry_less(p_heap[left + 1], p_heap[left])) ? left + 1 : left;
+		if (!_timer_entry_less(p_heap[child], p_heap[i])) {
+			break;
+		}
+		SWAP(p_heap[i], p_heap[child]);
+		i = child;
+	}
+	return top;
+}
+
+static bool _is_timer_entry_live(const TimerHeapEntry &p_entry) {
+	const ScheduledTimer *state = scheduled_timers.getptr(p_entry.timer);
+	return state != nullptr && state->version == p_entry.version;
+}
+
+// Upstream's countdown: the time left of a timer decremented by each frame's delta.
+static double _timer_countdown(const TimerQueue &p_queue, const ScheduledTimer &p_state) {
+	const uint64_t window_start = p_queue.frame - MIN(p_queue.frame, uint64_t(TIMER_DELTA_WINDOW));
+	uint64_t frame = p_state.frame;
+	double time_left = p_state.time;
+	if (frame < window_start) {
+		frame = window_start;
+		time_left = p_state.expiry - p_queue.window_clock;
+	}
+	for (; frame < p_queue.frame; frame++) {
+		time_left = MAX(time_left, 0.0) - p_queue.deltas[frame % TIMER_DELTA_WINDOW];
+	}
+	return time_left;
+}
+
+static void _advance_timer_queue(TimerQueue &p_queue, double p_delta) {
+	if (p_queue.deltas.is_empty()) {
+		p_queue.deltas.resize(TIMER_DELTA_WINDOW);
+	}
+	double &slot = p_queue.deltas[p_queue.frame % TIMER_DELTA_WINDOW];
+	if (p_queue.frame >= TIMER_DELTA_WINDOW) {
+		p_queue.window_clock += slot; // Same additions as the clock, so it matches it exactly.
+	}
+	slot = p_delta;
+	p_queue.frame++;
+	p_queue.clock += p_delta;
+}
+
+static void _schedule_timer(SceneTreeTimer *p_timer, ScheduledTimer &p_state, double p_time_left) {
+	TimerQueue &queue = tree_timers[p_state.tree].queues[p_state.queue];
+	p_state.expiry = queue.clock + p_time_left;
+	p_state.time = p_time_left;
+	p_state.frame = queue.frame;
+	p_state.version++;
+	_timer_heap_push(queue.heap, { p_state.expiry, p_state.order, p_timer, p_state.version });
+
+	// Drop the stale entries left by reschedules once they dominate the heap.
+	if (queue.heap.size() > queue.live * 2 + 64) {
+		LocalVector<TimerHeapEntry> entries = queue.heap;
+		queue.heap.clear();
+		for (const TimerHeapEntry &entry : entries) {
+			if (_is_timer_entry_live(entry)) {
+				_timer_heap_push(queue.heap, entry);
+			}
+		}
+	}
+}
+
+// Moves a scheduled timer to the queue matching its flags, keeping the time left.
+static void _requeue_timer(SceneTreeTimer *p_timer, uint8_t p_queue) {
+	MutexLock lock(timers_mutex);
+	ScheduledTimer *state = scheduled_timers.getptr(p_timer);
+	if (state == nullptr || state->queue == p_queue) {
+		return;
+	}
+	TreeTimers &timers = tree_timers[state->tree];
+	const double time_left = _timer_countdown(timers.queues[state->queue], *state);
+	timers.queues[state->queue].live--;
+	timers.queues[p_queue].live++;
+	state->queue = p_queue;
+	_schedule_timer(p_timer, *state, time_left);
+}
+
+static void _clear_tree_timers(const SceneTree *p_tree) {
+	MutexLock lock(timers_mutex);
+	LocalVector<const SceneTreeTimer *> removed;
+	for (const KeyValue<const SceneTreeTimer *, ScheduledTimer> &E : scheduled_timers) {
+		if (E.value.tree == p_tree) {
+			removed.push_back(E.key);
+		}
+	}
+	for (const SceneTreeTimer *timer : removed) {
+		scheduled_timers.erase(timer);
+	}
+	tree_timers.erase(p_tree);
+}
+
 void SceneTreeTimer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_time_left", "time"), &SceneTreeTimer::set_time_left);
 	ClassDB::bind_method(D_METHOD("get_time_left"), &SceneTreeTimer::get_time_left);
@@ -85,14 +275,26 @@ void SceneTreeTimer::_bind_methods() {
 
 void SceneTreeTimer::set_time_left(double p_time) {
 	time_left = p_time;
+
+	MutexLock lock(timers_mutex);
+	ScheduledTimer *state = scheduled_timers.getptr(this);
+	if (state != nullptr) {
+		_schedule_timer(this, *state, p_time);
+	}
 }
 
 double SceneTreeTimer::get_time_left() const {
+	MutexLock lock(timers_mutex);
+	const ScheduledTimer *state = scheduled_timers.getptr(this);
+	if (state != nullptr) {
+		return MAX(state->expiry - tree_timers[state->tree].queues[state->queue].clock, 0.0);
+	}
 	return MAX(time_left, 0.0);
 }
 
 void SceneTreeTimer::set_process_always(bool p_process_always) {
 	process_always = p_process_always;
+	_requeue_timer(this, _timer_queue_index(process_in_physics, process_always, ignore_time_scale));
 }
 
 bool SceneTreeTimer::is_process_always() {
@@ -101,6 +303,7 @@ bool SceneTreeTimer::is_process_always() {
 
 void SceneTreeTimer::set_process_in_physics(bool p_process_in_physics) {
 	process_in_physics = p_process_in_physics;
+	_requeue_timer(this, _timer_queue_index(process_in_physics, process_always, ignore_time_scale));
 }
 
 bool SceneTreeTimer::is_process_in_physics() {
@@ -109,6 +312,7 @@ bool SceneTreeTimer::is_process_in_physics() {
 
 void SceneTreeTimer::set_ignore_time_scale(bool p_ignore) {
 	ignore_time_scale = p_ignore;
+	_requeue_timer(this, _timer_queue_index(process_in_physics, process_always, ignore_time_scale));
 }
 
 bool SceneTreeTimer::is_ignoring_time_scale() {
@@ -173,17 +377,176 @@ void SceneTree::node_renamed(Node *p_node) {
 	emit_signal(node_renamed_name, p_node);
 }
 
+// Goblin Engine: fast scene tree (M-16) — O(1) group membership. Node's group
+// record lives in node.h, outside this mirror, so each group keeps a side index
+// of its members' slots in `nodes`: the duplicate check and removal no longer
+// scan the vector. Removals null-mark the slot (as the process groups do, T1)
+// and `_update_group_order()` compacts the tombstones before anyone reads the
+// vector. Compaction is stable, so the tree order stays valid.
+//
+// (M-17) Order is maintained incrementally: the first `sorted` slots are known
+// to be in tree order, and joins only append behind them. `changed` is left to
+// Node, which sets it when members move (`move_child()`), and only then is the
+// whole group re-sorted; appended members are sorted among themselves and
+// merged in at the position found by binary search.
+//
+// (M-23) Every removal bumps the group's removal count, which group cursors
+// read without locking. Cursors keep a reference to it, so it outlives the
+// group.
+struct SceneTreeGroupRemovals {
+	SafeRefCount refcount;
+	std::atomic<uint64_t> count = 0;
+};
+
+static SceneTreeGroupRemovals *_new_group_removals() {
+	SceneTreeGroupRemovals *removals = memnew(SceneTreeGroupRemovals);
+	removals->refcount.init();
+	return removals;
+}
+
+static void _unref_group_removals(SceneTreeGroupRemovals *p_removals) {
+	if (p_removals != nullptr && p_removals->refcount.unref()) {
+		memdelete(p_removals);
+	}
+}
+
+struct GroupSlots {
+	HashMap<Node *, uint32_t> slots;
+	uint32_t tombstones = 0;
+	uint32_t sorted = 0;
+	SceneTreeGroupRemovals *removals = nullptr; // Owns a reference.
+};
+
+//
+// The side index is per tree, created and deleted with it. The tree's own lock
+// covers its group methods, but cursors walk from any thread, so the index has
+// a lock of its own, which only work on the same tree contends for. Most calls
+// are on the main tree, whose index is found without the map lookup.
+//
+// (M-23) Group cursors (`SceneTreeGroupCursor`) find a tree's groups by name
+// here, as `group_map` is private, and take the fast path while no member has
+// left their group since their walk started.
+struct TreeGroupIndex {
+	Mutex mutex;
+	HashMap<const SceneTreeGroup *, GroupSlots> slots;
+	HashMap<StringName, SceneTreeGroup *> groups;
+
+	~TreeGroupIndex() {
+		for (const KeyValue<const SceneTreeGroup *, GroupSlots> &E : slots) {
+			_unref_group_removals(E.value.removals);
+		}
+	}
+};
+
+static HashMap<const SceneTree *, TreeGroupIndex *> tree_group_indexes;
+static RWLock tree_group_indexes_lock; // Written when a tree is created or deleted.
+static std::atomic<const SceneTree *> main_group_tree = nullptr;
+static TreeGroupIndex *main_tree_group_index = nullptr; // Published by `main_group_tree`.
+
+static TreeGroupIndex *_get_tree_group_index(const SceneTree *p_tree) {
+	if (likely(p_tree == main_group_tree.load(std::memory_order_acquire))) {
+		return main_tree_group_index;
+	}
+	RWLockRead lock(tree_group_indexes_lock);
+	TreeGroupIndex *const *index = tree_group_indexes.getptr(p_tree);
+	return index != nullptr ? *index : nullptr;
+}
+
+static void _compact_group(SceneTreeGroup &p_group, GroupSlots &p_slots) {
+	uint32_t count = p_group.nodes.size();
+	Node **ptr = p_group.nodes.ptrw();
+	uint32_t write = 0;
+	uint32_t sorted = 0;
+	for (uint32_t read = 0; read < count; read++) {
+		if (ptr[read] == nullptr) {
+			continue;
+		}
+		if (write != read) {
+			ptr[write] = ptr[read];
+			p_slots.slots[ptr[write]] = write;
+		}
+		write++;
+		if (read < p_slots.sorted) {
+			sorted = write;
+		}
+	}
+	p_group.nodes.resize(write);
+	p_slots.tombstones = 0;
+	p_slots.sorted = sorted;
+}
+
+static void _merge_group_tail(SceneTreeGroup &p_group, GroupSlots &p_slots) {
+	Node **ptr = p_group.nodes.ptrw();
+	const uint32_t count = p_group.nodes.size();
+	const uint32_t sorted = p_slots.sorted;
+	Node::Comparator compare;
+
+	SortArray<Node *, Node::Comparator> node_sort;
+	node_sort.sort(ptr + sorted, count - sorted);
+
+	// First sorted slot that comes after the earliest new member. Members that
+	// join behind the rest of the group in tree order (the usual spawn) leave
+	// the sorted range untouched.
+	uint32_t from = 0;
+	uint32_t to = sorted;
+	while (from < to) {
+		const uint32_t middle = (from + to) / 2;
+		if (compare(ptr[sorted], ptr[middle])) {
+			to = middle;
+		} else {
+			from = middle + 1;
+		}
+	}
+
+	if (from < sorted) {
+		// Merge forward: the write position never passes the tail read position.
+		LocalVector<Node *> moved;
+		moved.resize(sorted - from);
+		memcpy(moved.ptr(), ptr + from, moved.size() * sizeof(Node *));
+		uint32_t read_moved = 0;
+		uint32_t read_tail = sorted;
+		uint32_t write = from;
+		while (read_moved < moved.size()) {
+			if (read_tail < count && compare(ptr[read_tail], moved[read_moved])) {
+				ptr[write++] = ptr[read_tail++];
+			} else {
+				ptr[write++] = moved[read_moved++];
+			}
+		}
+	}
+
+	for (uint32_t i = from; i < count; i++) {
+		p_slots.slots[ptr[i]] = i;
+	}
+	p_slots.sorted = count;
+}
+
 SceneTreeGroup *SceneTree::add_to_group(const StringName &p_group, Node *p_node) {
 	_THREAD_SAFE_METHOD_
 
+	TreeGroupIndex *group_index = _get_tree_group_index(this);
+	MutexLock index_lock(group_index->mutex);
 	HashMap<StringName, SceneTreeGroup>::Iterator E = group_map.find(p_group);
 	if (!E) {
 		E = group_map.insert(p_group, SceneTreeGroup());
+		GroupSlots &new_slots = group_index->slots[&E->value];
+		new_slots = GroupSlots(); // The address may be a freed group's.
+		new_slots.removals = _new_group_removals();
+		group_index->groups[p_group] = &E->value;
 	}
 
-	ERR_FAIL_COND_V_MSG(E->value.nodes.has(p_node), &E->value, "Already in group: " + p_group + ".");
+	GroupSlots &gs = group_index->slots[&E->value];
+	ERR_FAIL_COND_V_MSG(gs.slots.has(p_node), &E->value, "Already in group: " + p_group + ".");
+	gs.slots.insert(p_node, E->value.nodes.size());
 	E->value.nodes.push_back(p_node);
-	E->value.changed = true;
+
+#ifndef _3D_DISABLED
+	// Goblin Engine: fast scene tree (M-25) — spatially indexed groups.
+	SpatialGroupIndex *spatial_index = SpatialGroupIndex::get_singleton();
+	if (unlikely(spatial_index != nullptr && spatial_index->is_active())) {
+		spatial_index->node_added(this, p_group, p_node);
+	}
+#endif // _3D_DISABLED
 	return &E->value;
 }
 
@@ -193,21 +556,64 @@ void SceneTree::remove_from_group(const StringName &p_group, Node *p_node) {
 	HashMap<StringName, SceneTreeGroup>::Iterator E = group_map.find(p_group);
 	ERR_FAIL_COND(!E);
 
-	E->value.nodes.erase(p_node);
-	if (E->value.nodes.is_empty()) {
+	TreeGroupIndex *group_index = _get_tree_group_index(this);
+	MutexLock index_lock(group_index->mutex);
+	GroupSlots *gs = group_index->slots.getptr(&E->value);
+	ERR_FAIL_NULL(gs);
+	HashMap<Node *, uint32_t>::Iterator S = gs->slots.find(p_node);
+	if (!S) {
+		return;
+	}
+	E->value.nodes.write[S->value] = nullptr;
+	gs->slots.remove(S);
+	gs->removals->count.fetch_add(1, std::memory_order_relaxed);
+
+#ifndef _3D_DISABLED
+	SpatialGroupIndex *spatial_index = SpatialGroupIndex::get_singleton();
+	if (unlikely(spatial_index != nullptr && spatial_index->is_active())) {
+		spatial_index->node_removed(this, p_group, p_node);
+	}
+#endif // _3D_DISABLED
+
+	if (gs->slots.is_empty()) {
+		_unref_group_removals(gs->removals);
+		group_index->slots.erase(&E->value);
+		group_index->groups.erase(p_group);
 		group_map.remove(E);
+		return;
+	}
+
+	// Compact eagerly once tombstones outnumber members, so groups that churn
+	// without being read stay bounded (amortized O(1) per removal).
+	gs->tombstones++;
+	if (gs->tombstones > gs->slots.size()) {
+		_compact_group(E->value, *gs);
 	}
 }
 
 void SceneTree::flush_transform_notifications() {
 	_THREAD_SAFE_METHOD_
 
+#ifndef _3D_DISABLED
+	// Goblin Engine: fast scene tree (M-25) — members of spatially indexed
+	// groups are placed again by the next query.
+	SpatialGroupIndex *spatial_index = SpatialGroupIndex::get_singleton();
+	if (spatial_index != nullptr && !spatial_index->is_active()) {
+		spatial_index = nullptr;
+	}
+#endif // _3D_DISABLED
+
 	SelfList<Node> *n = xform_change_list.first();
 	while (n) {
 		Node *node = n->self();
 		SelfList<Node> *nx = n->next();
 		xform_change_list.remove(n);
 		n = nx;
+#ifndef _3D_DISABLED
+		if (spatial_index != nullptr) {
+			spatial_index->transform_changed(node);
+		}
+#endif // _3D_DISABLED
 		node->notification(NOTIFICATION_TRANSFORM_CHANGED);
 	}
 }
@@ -339,8 +745,16 @@ void SceneTree::_flush_ugc() {
 	ugc_locked = false;
 }
 
-void SceneTree::_update_group_order(SceneTreeGroup &g) {
+// Called with the tree's `TreeGroupIndex::mutex` held.
+static void _order_group(SceneTreeGroup &g, GroupSlots *gs) {
+	if (gs && gs->tombstones > 0) {
+		_compact_group(g, *gs);
+	}
+
 	if (!g.changed) {
+		if (gs && gs->sorted < (uint32_t)g.nodes.size()) {
+			_merge_group_tail(g, *gs);
+		}
 		return;
 	}
 	if (g.nodes.is_empty()) {
@@ -353,14 +767,213 @@ void SceneTree::_update_group_order(SceneTreeGroup &g) {
 	SortArray<Node *, Node::Comparator> node_sort;
 	node_sort.sort(gr_nodes, gr_node_count);
 
+	if (gs) {
+		for (int i = 0; i < gr_node_count; i++) {
+			gs->slots[gr_nodes[i]] = i;
+		}
+		gs->sorted = gr_node_count;
+	}
+
 	g.changed = false;
 }
 
+void SceneTree::_update_group_order(SceneTreeGroup &g) {
+	TreeGroupIndex *group_index = _get_tree_group_index(this);
+	MutexLock index_lock(group_index->mutex);
+	_order_group(g, group_index->slots.getptr(&g));
+}
+
+// Goblin Engine: fast scene tree (M-23) — see scene_tree_group_iterator.h.
+// The walk shares the ordered, compacted storage; a removal null-marks the
+// live storage, which copies it first, so the shared one never changes under
+// the cursor.
+void SceneTreeGroupCursor::reset(SceneTree *p_tree, const StringName &p_group, bool p_reverse) {
+	tree = p_tree;
+	group = p_group;
+	index = 0;
+	reverse = p_reverse;
+	nodes = Vector<Node *>();
+	_release_removals();
+	ERR_FAIL_NULL(p_tree);
+
+	TreeGroupIndex *group_index = _get_tree_group_index(p_tree);
+	if (group_index == nullptr) {
+		return;
+	}
+	MutexLock index_lock(group_index->mutex);
+	SceneTreeGroup **g = group_index->groups.getptr(p_group);
+	if (g == nullptr) {
+		return;
+	}
+	GroupSlots *gs = group_index->slots.getptr(*g);
+	ERR_FAIL_NULL(gs);
+	_order_group(**g, gs);
+	nodes = (*g)->nodes;
+	group_removals = gs->removals;
+	group_removals->refcount.ref();
+	removals = group_removals->count.load(std::memory_order_relaxed);
+}
+
+void SceneTreeGroupCursor::_release_removals() {
+	_unref_group_removals(group_removals);
+	group_removals = nullptr;
+}
+
+Node *SceneTreeGroupCursor::next() {
+	const uint32_t count = nodes.size();
+	while (index < count) {
+		index++;
+		Node *node = nodes[reverse ? count - index : index - 1];
+		if (likely(group_removals->count.load(std::memory_order_relaxed) == removals)) {
+			return node;
+		}
+
+		// A member left a group during the walk: check this one is still in.
+		TreeGroupIndex *group_index = _get_tree_group_index(tree);
+		if (group_index == nullptr) {
+			break; // The tree is gone.
+		}
+		MutexLock index_lock(group_index->mutex);
+		SceneTreeGroup **g = group_index->groups.getptr(group);
+		if (g == nullptr) {
+			break; // The group is gone.
+		}
+		const GroupSlots *gs = group_index->slots.getptr(*g);
+		if (gs != nullptr && gs->slots.has(node)) {
+			return node;
+		}
+	}
+
+	// Done: stop sharing the storage, so the next change to the group doesn't copy it.
+	nodes = Vector<Node *>();
+	index = 0;
+	_release_removals();
+	return nullptr;
+}
+
+// Goblin Engine: fast scene tree (M-24) — a deferred group call, notification or
+// set is one message: the arguments are stored once, and the members it reaches
+// are resolved at flush time. By default they're the members at the time of the
+// call, kept as instance IDs so freed ones are skipped, like per-node messages
+// were. With `GROUP_CALL_DEFERRED_LIVE`, they're the members at flush time.
+class DeferredGroupCall : public CallableCustom {
+public:
+	enum Kind {
+		CALL,
+		NOTIFY,
+		SET,
+	};
+
+private:
+	ObjectID tree;
+	Kind kind = CALL;
+	bool reverse = false;
+	bool live = false;
+	StringName group;
+	StringName name; // Method or property.
+	int notification = 0;
+	Vector<Variant> args; // Call arguments, or the value to set.
+	LocalVector<ObjectID> members; // Unless live, in dispatch order.
+
+	static bool _compare_equal(const CallableCustom *p_a, const CallableCustom *p_b) { return p_a == p_b; }
+	static bool _compare_less(const CallableCustom *p_a, const CallableCustom *p_b) { return p_a < p_b; }
+
+	void _dispatch(Object *p_object, const Variant **p_args) const {
+		switch (kind) {
+			case CALL: {
+				Callable::CallError ce;
+				p_object->callp(name, p_args, args.size(), ce);
+			} break;
+			case NOTIFY: {
+				p_object->notification(notification);
+			} break;
+			case SET: {
+				p_object->set(name, args[0]);
+			} break;
+		}
+	}
+
+public:
+	uint32_t hash() const override { return hash_murmur3_one_64((uint64_t)this); }
+	String get_as_text() const override { return vformat("Deferred group call (%s::%s)", group, name); }
+	CompareEqualFunc get_compare_equal_func() const override { return _compare_equal; }
+	CompareLessFunc get_compare_less_func() const override { return _compare_less; }
+	ObjectID get_object() const override { return tree; }
+
+	void add_member(Node *p_node) { members.push_back(p_node->get_instance_id()); }
+
+	void call(const Variant **p_arguments, int p_argcount, Variant &r_return_value, Callable::CallError &r_call_error) const override {
+		r_call_error.error = Callable::CallError::CALL_OK;
+		const Variant **argptrs = (const Variant **)alloca(args.size() * sizeof(Variant *));
+		for (int i = 0; i < args.size(); i++) {
+			argptrs[i] = &args[i];
+		}
+
+		if (live) {
+			SceneTree *scene_tree = Object::cast_to<SceneTree>(ObjectDB::get_instance(tree));
+			if (scene_tree == nullptr) {
+				return;
+			}
+			SceneTreeGroupCursor cursor(scene_tree, group, reverse);
+			while (Node *node = cursor.next()) {
+				_dispatch(node, argptrs);
+			}
+			return;
+		}
+		for (const ObjectID &id : members) {
+			Object *object = ObjectDB::get_instance(id);
+			if (object != nullptr) {
+				_dispatch(object, argptrs);
+			}
+		}
+	}
+
+	DeferredGroupCall(SceneTree *p_tree, Kind p_kind, uint32_t p_call_flags, const StringName &p_group) :
+			tree(p_tree->get_instance_id()),
+			kind(p_kind),
+			reverse(p_call_flags & SceneTree::GROUP_CALL_REVERSE),
+			live(p_call_flags & GROUP_CALL_DEFERRED_LIVE),
+			group(p_group) {}
+
+	static DeferredGroupCall *create_call(SceneTree *p_tree, uint32_t p_call_flags, const StringName &p_group, const StringName &p_function, const Variant **p_args, int p_argcount) {
+		DeferredGroupCall *call = memnew(DeferredGroupCall(p_tree, CALL, p_call_flags, p_group));
+		call->name = p_function;
+		call->args.resize(p_argcount);
+		for (int i = 0; i < p_argcount; i++) {
+			call->args.write[i] = *p_args[i];
+		}
+		return call;
+	}
+
+	static DeferredGroupCall *create_notify(SceneTree *p_tree, uint32_t p_call_flags, const StringName &p_group, int p_notification) {
+		DeferredGroupCall *call = memnew(DeferredGroupCall(p_tree, NOTIFY, p_call_flags, p_group));
+		call->notification = p_notification;
+		return call;
+	}
+
+	static DeferredGroupCall *create_set(SceneTree *p_tree, uint32_t p_call_flags, const StringName &p_group, const StringName &p_name, const Variant &p_value) {
+		DeferredGroupCall *call = memnew(DeferredGroupCall(p_tree, SET, p_call_flags, p_group));
+		call->name = p_name;
+		call->args.push_back(p_value);
+		return call;
+	}
+
+	// Queues the call, or drops it if it reaches no one.
+	void push() {
+		if (!live && members.is_empty()) {
+			memdelete(this);
+			return;
+		}
+		MessageQueue::get_singleton()->push_callablep(Callable(this), nullptr, 0);
+	}
+};
+
 RequiredResult<Window> SceneTree::get_root() const {
 	return root;
 }
 
 void SceneTree::call_group_flagsp(uint32_t p_call_flags, const StringName &p_group, const StringName &p_function, const Variant **p_args, int p_argcount) {
+	FrameTimelineScope timeline_scope("SceneTree::call_group_flagsp", p_group, p_function); // Goblin: timeline capture.
 	Vector<Node *> nodes_copy;
 
 	{
@@ -395,6 +1008,11 @@ void SceneTree::call_group_flagsp(uint32_t p_call_flags, const StringName &p_gro
 			return;
 		}
 
+		if ((p_call_flags & GROUP_CALL_DEFERRED) && (p_call_flags & GROUP_CALL_DEFERRED_LIVE)) {
+			DeferredGroupCall::create_call(this, p_call_flags, p_group, p_function, p_args, p_argcount)->push();
+			return;
+		}
+
 		_update_group_order(g);
 
 		// Goblin Engine: fast scene tree (M-14, T6) — the handle is shared with
@@ -407,6 +1025,11 @@ void SceneTree::call_group_flagsp(uint32_t p_call_flags, const StringName &p_gro
 	Node *const *gr_nodes = nodes_copy.ptr();
 	int gr_node_count = nodes_copy.size();
 
+	DeferredGroupCall *deferred = nullptr;
+	if (p_call_flags & GROUP_CALL_DEFERRED) {
+		deferred = DeferredGroupCall::create_call(this, p_call_flags, p_group, p_function, p_args, p_argcount);
+	}
+
 	{
 		_THREAD_SAFE_METHOD_
 		nodes_removed_on_group_call_lock++;
@@ -426,7 +1049,7 @@ void SceneTree::call_group_flagsp(uint32_t p_call_flags, const StringName &p_gro
 					ERR_PRINT(vformat("Error calling group method on node \"%s\": %s.", node->get_name(), Variant::get_callable_error_text(Callable(node, p_function), p_args, p_argcount, ce)));
 				}
 			} else {
-				MessageQueue::get_singleton()->push_callp(node, p_function, p_args, p_argcount);
+				deferred->add_member(node);
 			}
 		}
 
@@ -444,7 +1067,7 @@ void SceneTree::call_group_flagsp(uint32_t p_call_flags, const StringName &p_gro
 					ERR_PRINT(vformat("Error calling group method on node \"%s\": %s.", node->get_name(), Variant::get_callable_error_text(Callable(node, p_function), p_args, p_argcount, ce)));
 				}
 			} else {
-				MessageQueue::get_singleton()->push_callp(node, p_function, p_args, p_argcount);
+				deferred->add_member(node);
 			}
 		}
 	}
@@ -456,6 +1079,10 @@ void SceneTree::call_group_flagsp(uint32_t p_call_flags, const StringName &p_gro
 			nodes_removed_on_group_call.clear();
 		}
 	}
+
+	if (deferred != nullptr) {
+		deferred->push();
+	}
 }
 
 void SceneTree::notify_group_flags(uint32_t p_call_flags, const StringName &p_group, int p_notification) {
@@ -471,6 +1098,11 @@ void SceneTree::notify_group_flags(uint32_t p_call_flags, const StringName &p_gr
 			return;
 		}
 
+		if ((p_call_flags & GROUP_CALL_DEFERRED) && (p_call_flags & GROUP_CALL_DEFERRED_LIVE)) {
+			DeferredGroupCall::create_notify(this, p_call_flags, p_group, p_notification)->push();
+			return;
+		}
+
 		_update_group_order(g);
 
 		// Goblin Engine: fast scene tree (M-14, T6) — see call_group_flagsp():
@@ -481,6 +1113,11 @@ void SceneTree::notify_group_flags(uint32_t p_call_flags, const StringName &p_gr
 	Node *const *gr_nodes = nodes_copy.ptr();
 	int gr_node_count = nodes_copy.size();
 
+	DeferredGroupCall *deferred = nullptr;
+	if (p_call_flags & GROUP_CALL_DEFERRED) {
+		deferred = DeferredGroupCall::create_notify(this, p_call_flags, p_group, p_notification);
+	}
+
 	{
 		_THREAD_SAFE_METHOD_
 		nodes_removed_on_group_call_lock++;
@@ -495,7 +1132,7 @@ void SceneTree::notify_group_flags(uint32_t p_call_flags, const StringName &p_gr
 			if (!(p_call_flags & GROUP_CALL_DEFERRED)) {
 				gr_nodes[i]->notification(p_notification, true);
 			} else {
-				MessageQueue::get_singleton()->push_notification(gr_nodes[i], p_notification);
+				deferred->add_member(gr_nodes[i]);
 			}
 		}
 
@@ -508,7 +1145,7 @@ void SceneTree::notify_group_flags(uint32_t p_call_flags, const StringName &p_gr
 			if (!(p_call_flags & GROUP_CALL_DEFERRED)) {
 				gr_nodes[i]->notification(p_notification);
 			} else {
-				MessageQueue::get_singleton()->push_notification(gr_nodes[i], p_notification);
+				deferred->add_member(gr_nodes[i]);
 			}
 		}
 	}
@@ -520,6 +1157,10 @@ void SceneTree::notify_group_flags(uint32_t p_call_flags, const StringName &p_gr
 			nodes_removed_on_group_call.clear();
 		}
 	}
+
+	if (deferred != nullptr) {
+		deferred->push();
+	}
 }
 
 void SceneTree::set_group_flags(uint32_t p_call_flags, const StringName &p_group, const String &p_name, const Variant &p_value) {
@@ -536,6 +1177,11 @@ void SceneTree::set_group_flags(uint32_t p_call_flags, const StringName &p_group
 			return;
 		}
 
+		if ((p_call_flags & GROUP_CALL_DEFERRED) && (p_call_flags & GROUP_CALL_DEFERRED_LIVE)) {
+			DeferredGroupCall::create_set(this, p_call_flags, p_group, p_name, p_value)->push();
+			return;
+		}
+
 		_update_group_order(g);
 
 		// Goblin Engine: fast scene tree (M-14, T6) — see call_group_flagsp():
@@ -545,6 +1191,11 @@ void SceneTree::set_group_flags(uint32_t p_call_flags, const StringName &p_group
 	Node *const *gr_nodes = nodes_copy.ptr();
 	int gr_node_count = nodes_copy.size();
 
+	DeferredGroupCall *deferred = nullptr;
+	if (p_call_flags & GROUP_CALL_DEFERRED) {
+		deferred = DeferredGroupCall::create_set(this, p_call_flags, p_group, p_name, p_value);
+	}
+
 	{
 		_THREAD_SAFE_METHOD_
 		nodes_removed_on_group_call_lock++;
@@ -559,7 +1210,7 @@ void SceneTree::set_group_flags(uint32_t p_call_flags, const StringName &p_group
 			if (!(p_call_flags & GROUP_CALL_DEFERRED)) {
 				gr_nodes[i]->set(p_name, p_value);
 			} else {
-				MessageQueue::get_singleton()->push_set(gr_nodes[i], p_name, p_value);
+				deferred->add_member(gr_nodes[i]);
 			}
 		}
 
@@ -572,7 +1223,7 @@ void SceneTree::set_group_flags(uint32_t p_call_flags, const StringName &p_group
 			if (!(p_call_flags & GROUP_CALL_DEFERRED)) {
 				gr_nodes[i]->set(p_name, p_value);
 			} else {
-				MessageQueue::get_singleton()->push_set(gr_nodes[i], p_name, p_value);
+				deferred->add_member(gr_nodes[i]);
 			}
 		}
 	}
@@ -584,6 +1235,10 @@ void SceneTree::set_group_flags(uint32_t p_call_flags, const StringName &p_group
 			nodes_removed_on_group_call.clear();
 		}
 	}
+
+	if (deferred != nullptr) {
+		deferred->push();
+	}
 }
 
 void SceneTree::notify_group(const StringName &p_group, int p_notification) {
@@ -648,6 +1303,7 @@ void SceneTree::iteration_prepare() {
 }
 
 bool SceneTree::physics_process(double p_time) {
+	FrameTimelineScope timeline_scope("SceneTree::physics_process"); // Goblin: timeline capture.
 	current_frame++;
 
 	flush_transform_notifications();
@@ -697,6 +1353,9 @@ void SceneTree::iteration_end() {
 }
 
 bool SceneTree::process(double p_time) {
+	FrameTimeline::frame_boundary(); // Goblin: timeline capture ranges are counted in idle frames.
+	FrameTimelineScope timeline_scope("SceneTree::process");
+
 	// First pass of scene tree fixed timestep interpolation.
 	if (get_scene_tree_fti().is_enabled()) {
 		// Special, we need to ensure RenderingServer is up to date
@@ -727,6 +1386,12 @@ bool SceneTree::process(double p_time) {
 
 	flush_transform_notifications();
 
+	// Goblin Engine: fast scene tree (M-20) — advance the cadence buckets
+	// before the idle pass that consults them.
+	if (ProcessCadence::get_singleton() != nullptr) {
+		ProcessCadence::get_singleton()->begin_frame();
+	}
+
 	_process(false);
 
 	_flush_ugc();
@@ -803,40 +1468,97 @@ bool SceneTree::process(double p_time) {
 
 void SceneTree::process_timers(double p_delta, bool p_physics_frame) {
 	_THREAD_SAFE_METHOD_
-	const List<Ref<SceneTreeTimer>>::Element *L = timers.back(); // Last element.
+	FRAME_TIMELINE_SCOPE("SceneTree::process_timers"); // Goblin: timeline capture.
 	const double unscaled_delta = Engine::get_singleton()->get_process_step();
 
-	for (List<Ref<SceneTreeTimer>>::Element *E = timers.front(); E;) {
-		List<Ref<SceneTreeTimer>>::Element *N = E->next();
-		// Goblin Engine: fast scene tree (M-14) — bind the stored Ref (no
-		// refcount churn per timer per frame; mirrors process_tweens()).
-		Ref<SceneTreeTimer> &timer = E->get();
+	// Goblin Engine: fast scene tree (M-18) — advance the clocks of the queues
+	// that run this frame and collect what expired, before any timeout fires.
+	// Timers created by timeout handlers are scheduled on the advanced clocks
+	// after the collection, so (as with the old "break on last" list walk) they
+	// are not processed until the next frame.
+	LocalVector<TimerHeapEntry> expired;
+	{
+		MutexLock lock(timers_mutex);
+		TreeTimers *timers_state = tree_timers.getptr(this);
+		if (timers_state == nullptr) {
+			return;
+		}
+		for (uint8_t i = 0; i < 8; i++) {
+			const bool physics = i & 1;
+			const bool process_always = i & 2;
+			const bool ignore_time_scale = i & 4;
+			if (physics != p_physics_frame || (paused && !process_always)) {
+				continue;
+			}
+			TimerQueue &queue = timers_state->queues[i];
+			if (queue.live == 0) {
+				// Restart an idle queue, so that expiry keeps the precision of the times it was given.
+				queue.clock = 0.0;
+				queue.heap.clear();
+				queue.frame = 0;
+				queue.window_clock = 0.0;
+				continue;
+			}
+			_advance_timer_queue(queue, ignore_time_scale ? unscaled_delta : p_delta);
 
-		if ((paused && !timer->is_process_always()) || (timer->is_process_in_physics() != p_physics_frame)) {
-			if (E == L) {
-				break; // Break on last, so if new timers were added during list traversal, ignore them.
+			const double tolerance = (queue.clock + 1.0) * 1e-9;
+			LocalVector<TimerHeapEntry> undecided;
+			while (!queue.heap.is_empty() && queue.heap[0].expiry <= queue.clock + tolerance) {
+				const TimerHeapEntry entry = _timer_heap_pop(queue.heap);
+				if (!_is_timer_entry_live(entry)) {
+					continue;
+				}
+				if (entry.expiry >= queue.clock - tolerance && _timer_countdown(queue, scheduled_timers[entry.timer]) > 0) {
+					undecided.push_back(entry); // Fires on a later frame, as upstream.
+					continue;
+				}
+				expired.push_back(entry);
+			}
+			for (const TimerHeapEntry &entry : undecided) {
+				_timer_heap_push(queue.heap, entry);
 			}
-			E = N;
-			continue;
 		}
+	}
+	if (expired.is_empty()) {
+		return;
+	}
 
-		double time_left = timer->get_time_left();
-		time_left -= timer->is_ignoring_time_scale() ? unscaled_delta : p_delta;
-		timer->set_time_left(time_left);
+	struct TimerOrder {
+		bool operator()(const TimerHeapEntry &p_a, const TimerHeapEntry &p_b) const { return p_a.order < p_b.order; }
+	};
+	expired.sort_custom<TimerOrder>();
 
-		if (time_left <= 0) {
-			timer->emit_signal(timer_timeout_name); // Goblin Engine: fast scene tree — cached name (was SNAME("timeout"))
-			timers.erase(E);
-		}
-		if (E == L) {
-			break; // Break on last, so if new timers were added during list traversal, ignore them.
+	for (const TimerHeapEntry &entry : expired) {
+		Ref<SceneTreeTimer> timer;
+		List<Ref<SceneTreeTimer>>::Element *element = nullptr;
+		double time_left = 0.0;
+		{
+			MutexLock lock(timers_mutex);
+			ScheduledTimer *state = scheduled_timers.getptr(entry.timer);
+			if (state == nullptr) {
+				continue;
+			}
+			TimerQueue &queue = tree_timers[this].queues[state->queue];
+			time_left = state->expiry - queue.clock;
+			if (state->version != entry.version && time_left > 0) {
+				continue; // Rescheduled by an earlier timeout handler.
+			}
+			time_left = MIN(time_left, 0.0);
+			element = state->element;
+			timer = element->get();
+			queue.live--;
+			scheduled_timers.erase(entry.timer);
 		}
-		E = N;
+
+		timer->set_time_left(time_left);
+		timer->emit_signal(timer_timeout_name); // Goblin Engine: fast scene tree — cached name (was SNAME("timeout"))
+		timers.erase(element);
 	}
 }
 
 void SceneTree::process_tweens(double p_delta, bool p_physics) {
 	_THREAD_SAFE_METHOD_
+	FRAME_TIMELINE_SCOPE("SceneTree::process_tweens"); // Goblin: timeline capture.
 	// This methods works similarly to how SceneTreeTimers are handled.
 	const List<Ref<Tween>>::Element *L = tweens.back();
 	const double unscaled_delta = Engine::get_singleton()->get_process_step();
@@ -863,6 +1585,12 @@ void SceneTree::process_tweens(double p_delta, bool p_physics) {
 		}
 		E = N;
 	}
+
+	// Goblin Engine: fast scene tree (M-19) — batched property tweens step
+	// after the Tweens, in the same process/pause/time-scale terms.
+	if (TweenBatch::get_singleton() != nullptr) {
+		TweenBatch::get_singleton()->process(p_delta, unscaled_delta, p_physics, paused);
+	}
 }
 
 void SceneTree::finalize() {
@@ -884,6 +1612,7 @@ void SceneTree::finalize() {
 	MainLoop::finalize();
 
 	// Cleanup timers.
+	_clear_tree_timers(this);
 	for (Ref<SceneTreeTimer> &timer : timers) {
 		timer->release_connections();
 	}
@@ -1204,62 +1933,180 @@ static void _compact_process_nodes(Vector<Node *> &p_nodes) {
 	}
 }
 
+// Goblin Engine: fast scene tree (M-21, T4) — `Node::_can_process()` for an
+// already resolved process mode.
+static _FORCE_INLINE_ bool _is_process_mode_enabled(Node::ProcessMode p_mode, bool p_paused) {
+	// The owner can't be set to inherit, must be a bug.
+	ERR_FAIL_COND_V(p_mode == Node::PROCESS_MODE_INHERIT, false);
+
+	switch (p_mode) {
+		case Node::PROCESS_MODE_DISABLED:
+			return false;
+		case Node::PROCESS_MODE_ALWAYS:
+			return true;
+		case Node::PROCESS_MODE_WHEN_PAUSED:
+			return p_paused;
+		default:
+			return !p_paused;
+	}
+}
+
+// Goblin Engine: fast scene tree (M-22) — split sub-thread groups. A group
+// with more processing nodes than `ProcessGroupScheduler::split_threshold` runs
+// in parts: the main thread flushes its messages and compacts/sorts its list
+// (PREPARE), workers process node ranges of a snapshot of that list (RANGE),
+// then the main thread flushes the messages again (FINISH). The snapshot shares
+// the list's storage, so a node appended during processing copies the live
+// list instead of moving the nodes under the other ranges.
+enum ProcessGroupPart {
+	PROCESS_GROUP_WHOLE,
+	PROCESS_GROUP_PREPARE,
+	PROCESS_GROUP_RANGE,
+	PROCESS_GROUP_FINISH,
+};
+
+struct ProcessGroupPass {
+	ProcessGroupPart part = PROCESS_GROUP_WHOLE;
+	Node *const *nodes = nullptr; // RANGE: the snapshot.
+	uint32_t begin = 0;
+	uint32_t end = 0;
+};
+
+// One worker task: a whole group, or a node range of a split group.
+struct ProcessGroupTask {
+	uint32_t group = 0; // Index in `local_process_group_cache`.
+	bool whole = true;
+	uint32_t begin = 0;
+	uint32_t end = 0;
+	uint64_t start_usec = 0; // Written by the worker.
+	uint64_t end_usec = 0;
+};
+
+static thread_local ProcessGroupPass process_group_pass;
+static LocalVector<ProcessGroupTask> process_group_tasks;
+static LocalVector<Vector<Node *>> process_group_snapshots; // Per cached group; empty unless split.
+
+// The sub-thread block the main thread is processing its own groups alongside
+// (overlap), until it is joined. Main thread only.
+static WorkerThreadPool::GroupID overlapped_thread_block = -1;
+
+static void _join_overlapped_thread_block() {
+	if (overlapped_thread_block != -1) {
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(overlapped_thread_block);
+		overlapped_thread_block = -1;
+	}
+}
+
 void SceneTree::_process_group(ProcessGroup *p_group, bool p_physics) {
 	// When reading this function, keep in mind that this code must work in a way where
 	// if any node is removed, this needs to continue working.
 
-	p_group->call_queue.flush(); // Flush messages before processing.
+	// Goblin: timeline capture, one span per group named after its owner.
+	FrameTimelineScope timeline_scope("ProcessGroup", (unlikely(FrameTimeline::is_recording()) && p_group->owner) ? StringName(p_group->owner->get_name()) : StringName());
 
-	Vector<Node *> &nodes = p_physics ? p_group->physics_nodes : p_group->nodes;
-	if (nodes.is_empty()) {
+	const ProcessGroupPass pass = process_group_pass; // Goblin Engine: fast scene tree (M-22).
+	if (pass.part == PROCESS_GROUP_FINISH) {
+		p_group->call_queue.flush();
 		return;
 	}
 
-	// Goblin Engine: fast scene tree (M-14, T1/T6) — compact null-marked
-	// removals first, then sort only when the order changed. Removals never
-	// shift the vector during iteration (they null the slot), so the per-frame
-	// node-list copy is gone. The group-call removal set is not consulted here:
-	// every set member encountered during processing was removed from the tree,
-	// which also null-marks its process-group slot (and nodes outside the list
-	// are never seen by this loop); the set stays in the group-call paths,
-	// where CoW copies still need it.
-	if (p_physics) {
-		if (p_group->physics_nodes_need_compaction) {
-			_compact_process_nodes(p_group->physics_nodes);
-			p_group->physics_nodes_need_compaction = false;
-		}
-		if (p_group->physics_node_order_dirty) {
-			nodes.sort_custom<Node::ComparatorWithPhysicsPriority>();
-			p_group->physics_node_order_dirty = false;
-		}
+	Vector<Node *> &nodes = p_physics ? p_group->physics_nodes : p_group->nodes;
+	uint32_t begin = 0;
+	uint32_t node_count = 0;
+
+	if (pass.part == PROCESS_GROUP_RANGE) {
+		begin = pass.begin;
+		node_count = pass.end;
 	} else {
-		if (p_group->nodes_need_compaction) {
-			_compact_process_nodes(p_group->nodes);
-			p_group->nodes_need_compaction = false;
+		p_group->call_queue.flush(); // Flush messages before processing.
+
+		if (nodes.is_empty()) {
+			return;
+		}
+
+		// Goblin Engine: fast scene tree (M-14, T1/T6) — compact null-marked
+		// removals first, then sort only when the order changed. Removals never
+		// shift the vector during iteration (they null the slot), so the per-frame
+		// node-list copy is gone. The group-call removal set is not consulted here:
+		// every set member encountered during processing was removed from the tree,
+		// which also null-marks its process-group slot (and nodes outside the list
+		// are never seen by this loop); the set stays in the group-call paths,
+		// where CoW copies still need it.
+		if (p_physics) {
+			if (p_group->physics_nodes_need_compaction) {
+				_compact_process_nodes(p_group->physics_nodes);
+				p_group->physics_nodes_need_compaction = false;
+			}
+			if (p_group->physics_node_order_dirty) {
+				nodes.sort_custom<Node::ComparatorWithPhysicsPriority>();
+				p_group->physics_node_order_dirty = false;
+			}
+		} else {
+			if (p_group->nodes_need_compaction) {
+				_compact_process_nodes(p_group->nodes);
+				p_group->nodes_need_compaction = false;
+			}
+			if (p_group->node_order_dirty) {
+				nodes.sort_custom<Node::ComparatorWithPriority>();
+				p_group->node_order_dirty = false;
+			}
 		}
-		if (p_group->node_order_dirty) {
-			nodes.sort_custom<Node::ComparatorWithPriority>();
-			p_group->node_order_dirty = false;
+		if (pass.part == PROCESS_GROUP_PREPARE) {
+			return;
 		}
+
+		// Iterate the live list directly; the count is captured so nodes appended
+		// during processing are ignored this pass (the vector may realloc on
+		// append — elements are re-read per iteration, so that is safe).
+		node_count = nodes.size();
 	}
 
-	// Iterate the live list directly; the count is captured so nodes appended
-	// during processing are ignored this pass (the vector may realloc on
-	// append — elements are re-read per iteration, so that is safe).
-	uint32_t node_count = nodes.size();
+	// Goblin Engine: fast scene tree (M-20) — nodes with a process cadence
+	// only run on their bucket's frames, with the delta accumulated since their
+	// last process swapped into `process_time` around the notifications. Main
+	// thread only, and not while an overlapped sub-thread block runs: sub-thread
+	// groups read `process_time` too.
+	ProcessCadence *cadence = ProcessCadence::get_singleton();
+	const bool use_cadence = !p_physics && cadence != nullptr && !cadence->is_empty() && Thread::is_main_thread() && overlapped_thread_block == -1;
+	const double frame_time = process_time;
 
-	for (uint32_t i = 0; i < node_count; i++) {
-		Node *n = nodes[i];
+	// Goblin Engine: fast scene tree (M-21, T4) — a suspended tree processes
+	// no node, so the whole pass is skipped. Otherwise `can_process()` is
+	// inlined: the process mode comes straight from the node or its process
+	// owner (the subtree root whose mode it inherits), with no call back into
+	// the tree. Nothing is cached across nodes, so pause or process mode changes
+	// made by an earlier node in the pass still apply to the next ones.
+	if (unlikely(suspended)) {
+		node_count = 0;
+	}
+
+	for (uint32_t i = begin; i < node_count; i++) {
+		Node *n = pass.nodes != nullptr ? pass.nodes[i] : nodes[i];
 		if (unlikely(n == nullptr)) {
 			// Node was removed during process, skip it.
 			// Keep in mind removals can only happen on the main thread.
 			continue;
 		}
 
-		if (!n->can_process() || !n->is_inside_tree()) {
+		if (!n->is_inside_tree()) {
+			continue;
+		}
+		Node::ProcessMode process_mode = n->data.process_mode;
+		if (process_mode == Node::PROCESS_MODE_INHERIT) {
+			process_mode = n->data.process_owner != nullptr ? n->data.process_owner->data.process_mode : Node::PROCESS_MODE_PAUSABLE;
+		}
+		if (unlikely(suspended) || !_is_process_mode_enabled(process_mode, paused)) {
 			continue;
 		}
 
+		if (use_cadence) {
+			double node_time = frame_time;
+			if (!cadence->should_process(n, frame_time, node_time)) {
+				continue;
+			}
+			process_time = node_time;
+		}
+
 		if (p_physics) {
 			if (n->is_physics_processing_internal()) {
 				n->notification(Node::NOTIFICATION_INTERNAL_PHYSICS_PROCESS);
@@ -1274,19 +2121,41 @@ void SceneTree::_process_group(ProcessGroup *p_group, bool p_physics) {
 			if (n->is_processing()) {
 				n->notification(Node::NOTIFICATION_PROCESS);
 			}
+			if (use_cadence) {
+				process_time = frame_time;
+			}
 		}
 	}
 
+	if (pass.part == PROCESS_GROUP_RANGE) {
+		return; // The main thread flushes once all ranges are done.
+	}
 	p_group->call_queue.flush(); // Flush messages also after processing (for potential deferred calls).
 }
 
 void SceneTree::_process_groups_thread(uint32_t p_index, bool p_physics) {
-	Node::current_process_thread_group = local_process_group_cache[p_index]->owner;
-	_process_group(local_process_group_cache[p_index], p_physics);
+	// Goblin Engine: fast scene tree (M-22) — one task per group, or per node
+	// range of a split group.
+	ProcessGroupTask &task = process_group_tasks[p_index];
+	ProcessGroup *group = local_process_group_cache[task.group];
+	task.start_usec = OS::get_singleton()->get_ticks_usec();
+	Node::current_process_thread_group = group->owner;
+	if (task.whole) {
+		_process_group(group, p_physics);
+	} else {
+		process_group_pass.part = PROCESS_GROUP_RANGE;
+		process_group_pass.nodes = process_group_snapshots[task.group].ptr();
+		process_group_pass.begin = task.begin;
+		process_group_pass.end = task.end;
+		_process_group(group, p_physics);
+		process_group_pass = ProcessGroupPass();
+	}
 	Node::current_process_thread_group = nullptr;
+	task.end_usec = OS::get_singleton()->get_ticks_usec();
 }
 
 void SceneTree::_process(bool p_physics) {
+	FrameTimelineScope timeline_scope("SceneTree::_process"); // Goblin: timeline capture.
 	if (process_groups_dirty) {
 		{
 			// First, remove dirty groups.
@@ -1320,6 +2189,10 @@ void SceneTree::_process(bool p_physics) {
 	// No group will be removed from the array during processing (this is done earlier in this function by marking the groups dirty).
 	uint32_t group_count = process_groups.size();
 
+	if (ProcessGroupScheduler::get_singleton() != nullptr) {
+		ProcessGroupScheduler::get_singleton()->begin_pass(p_physics); // Goblin Engine: fast scene tree (M-22).
+	}
+
 	if (group_count == 0) {
 		return;
 	}
@@ -1332,6 +2205,104 @@ void SceneTree::_process(bool p_physics) {
 	int current_order = process_groups[0]->owner ? process_groups[0]->owner->data.process_thread_group_order : 0;
 	bool current_threaded = process_groups[0]->owner ? process_groups[0]->owner->data.process_thread_group == Node::PROCESS_THREAD_GROUP_SUB_THREAD : false;
 
+	// Goblin Engine: fast scene tree (M-22) — sub-thread blocks run as one
+	// worker task per group, or per node range of groups above the split
+	// threshold. With overlap enabled, the block is only waited for before the
+	// next block that can't run alongside it: the main-thread groups of the same
+	// order (sorted right after it) are processed in the meantime, without
+	// process cadences; a main-thread node that adds or removes a processing
+	// node of the block joins it first. Per-group wall/busy time goes to the
+	// scheduler singleton.
+	ProcessGroupScheduler *scheduler = ProcessGroupScheduler::get_singleton();
+	const bool overlap_main_thread = scheduler != nullptr && scheduler->is_overlapping_main_thread();
+	const uint32_t split_threshold = scheduler != nullptr ? scheduler->get_split_threshold() : 0;
+	bool thread_block_pending = false;
+	int thread_block_order = 0;
+	WorkerThreadPool::GroupID thread_block_id = -1;
+
+	auto start_thread_block = [&]() {
+		process_group_tasks.clear();
+		process_group_snapshots.clear();
+		process_group_snapshots.resize(local_process_group_cache.size());
+		for (uint32_t g = 0; g < local_process_group_cache.size(); g++) {
+			ProcessGroup *pg = local_process_group_cache[g];
+			const Vector<Node *> &nodes = p_physics ? pg->physics_nodes : pg->nodes;
+			if (split_threshold == 0 || (uint32_t)nodes.size() <= split_threshold) {
+				ProcessGroupTask task;
+				task.group = g;
+				process_group_tasks.push_back(task);
+				continue;
+			}
+			Node::current_process_thread_group = pg->owner;
+			process_group_pass.part = PROCESS_GROUP_PREPARE;
+			_process_group(pg, p_physics);
+			process_group_pass = ProcessGroupPass();
+			Node::current_process_thread_group = nullptr;
+
+			process_group_snapshots[g] = nodes;
+			const uint32_t count = process_group_snapshots[g].size();
+			for (uint32_t begin = 0; begin < count; begin += split_threshold) {
+				ProcessGroupTask task;
+				task.group = g;
+				task.whole = false;
+				task.begin = begin;
+				task.end = MIN(begin + split_threshold, count);
+				process_group_tasks.push_back(task);
+			}
+		}
+		thread_block_id = -1;
+		if (!process_group_tasks.is_empty()) {
+			thread_block_id = WorkerThreadPool::get_singleton()->add_template_group_task(this, &SceneTree::_process_groups_thread, p_physics, process_group_tasks.size(), -1, true);
+		}
+		if (overlap_main_thread) {
+			overlapped_thread_block = thread_block_id;
+		}
+		thread_block_pending = true;
+		thread_block_order = current_order;
+	};
+
+	auto finish_thread_block = [&]() {
+		if (!thread_block_pending) {
+			return;
+		}
+		if (overlap_main_thread) {
+			_join_overlapped_thread_block(); // Unless a main-thread node already needed it joined.
+		} else if (thread_block_id != -1) {
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(thread_block_id);
+		}
+		thread_block_pending = false;
+
+		for (uint32_t g = 0; g < local_process_group_cache.size(); g++) {
+			ProcessGroup *pg = local_process_group_cache[g];
+			const bool split = !process_group_snapshots[g].is_empty();
+			if (split) {
+				Node::current_process_thread_group = pg->owner;
+				process_group_pass.part = PROCESS_GROUP_FINISH;
+				_process_group(pg, p_physics);
+				process_group_pass = ProcessGroupPass();
+				Node::current_process_thread_group = nullptr;
+			}
+			if (scheduler == nullptr) {
+				continue;
+			}
+			uint64_t start_usec = UINT64_MAX;
+			uint64_t end_usec = 0;
+			uint64_t busy_usec = 0;
+			uint32_t tasks = 0;
+			for (const ProcessGroupTask &task : process_group_tasks) {
+				if (task.group == g) {
+					start_usec = MIN(start_usec, task.start_usec);
+					end_usec = MAX(end_usec, task.end_usec);
+					busy_usec += task.end_usec - task.start_usec;
+					tasks++;
+				}
+			}
+			const uint32_t node_count = split ? process_group_snapshots[g].size() : (p_physics ? pg->physics_nodes.size() : pg->nodes.size());
+			scheduler->record_group(p_physics, pg->owner, thread_block_order, true, node_count, tasks, tasks > 0 ? end_usec - start_usec : 0, busy_usec);
+		}
+		process_group_snapshots.clear();
+	};
+
 	for (uint32_t i = 0; i <= group_count; i++) {
 		int order = i < group_count && process_groups[i]->owner ? process_groups[i]->owner->data.process_thread_group_order : 0;
 		bool threaded = i < group_count && process_groups[i]->owner ? process_groups[i]->owner->data.process_thread_group == Node::PROCESS_THREAD_GROUP_SUB_THREAD : false;
@@ -1342,12 +2313,21 @@ void SceneTree::_process(bool p_physics) {
 				bool using_threads = process_groups[from]->owner && process_groups[from]->owner->data.process_thread_group == Node::PROCESS_THREAD_GROUP_SUB_THREAD && !node_threading_disabled;
 
 				if (using_threads) {
+					finish_thread_block(); // A sub-thread block of a lesser order.
 					local_process_group_cache.clear();
+				} else if (thread_block_pending && thread_block_order != current_order) {
+					finish_thread_block();
 				}
 				for (uint32_t j = from; j < i; j++) {
 					if (process_groups[j]->last_pass == process_last_pass) {
 						if (using_threads) {
 							local_process_group_cache.push_back(process_groups[j]);
+						} else if (scheduler != nullptr) {
+							const uint64_t start_usec = OS::get_singleton()->get_ticks_usec();
+							_process_group(process_groups[j], p_physics);
+							const uint64_t usec = OS::get_singleton()->get_ticks_usec() - start_usec;
+							ProcessGroup *pg = process_groups[j];
+							scheduler->record_group(p_physics, pg->owner, current_order, false, p_physics ? pg->physics_nodes.size() : pg->nodes.size(), 1, usec, usec);
 						} else {
 							_process_group(process_groups[j], p_physics);
 						}
@@ -1355,13 +2335,18 @@ void SceneTree::_process(bool p_physics) {
 				}
 
 				if (using_threads) {
-					WorkerThreadPool::GroupID id = WorkerThreadPool::get_singleton()->add_template_group_task(this, &SceneTree::_process_groups_thread, p_physics, local_process_group_cache.size(), -1, true);
-					WorkerThreadPool::get_singleton()->wait_for_group_task_completion(id);
+					start_thread_block();
+					if (!overlap_main_thread) {
+						finish_thread_block();
+					}
+				} else {
+					finish_thread_block(); // The overlapped sub-thread block of this order.
 				}
 			}
 
 			if (i == group_count) {
 				// This one is invalid, no longer process
+				finish_thread_block();
 				break;
 			}
 
@@ -1443,9 +2428,16 @@ void SceneTree::_add_process_group(Node *p_node) {
 }
 
 void SceneTree::_remove_node_from_process_group(Node *p_node, Node *p_owner) {
-	_THREAD_SAFE_METHOD_
 	ProcessGroup *pg = p_owner ? (ProcessGroup *)p_owner->data.process_group : &default_process_group;
 
+	// Goblin Engine: fast scene tree (M-22) — the workers of an overlapped
+	// block iterate the lists of its groups, so the main thread joins them
+	// before changing one (and before locking, which the workers may need).
+	if (unlikely(overlapped_thread_block != -1) && Thread::is_main_thread() && Node::current_process_thread_group == nullptr && local_process_group_cache.has(pg)) {
+		_join_overlapped_thread_block();
+	}
+
+	_THREAD_SAFE_METHOD_
 	// Goblin Engine: fast scene tree (M-14, T1/T6) — removals null-mark the
 	// slot instead of erasing (no O(n) shift, no iterator invalidation), so
 	// `_process_group()` iterates the live list without a per-frame copy.
@@ -1466,9 +2458,14 @@ void SceneTree::_remove_node_from_process_group(Node *p_node, Node *p_owner) {
 }
 
 void SceneTree::_add_node_to_process_group(Node *p_node, Node *p_owner) {
-	_THREAD_SAFE_METHOD_
 	ProcessGroup *pg = p_owner ? (ProcessGroup *)p_owner->data.process_group : &default_process_group;
 
+	// Goblin Engine: fast scene tree (M-22) — see `_remove_node_from_process_group()`.
+	if (unlikely(overlapped_thread_block != -1) && Thread::is_main_thread() && Node::current_process_thread_group == nullptr && local_process_group_cache.has(pg)) {
+		_join_overlapped_thread_block();
+	}
+
+	_THREAD_SAFE_METHOD_
 	if (p_node->is_processing() || p_node->is_processing_internal()) {
 		pg->nodes.push_back(p_node);
 		pg->node_order_dirty = true;
@@ -1641,7 +2638,11 @@ int SceneTree::get_node_count_in_group(const StringName &p_group) const {
 		return 0;
 	}
 
-	return E->value.nodes.size();
+	// Removed members may still hold a null slot until the next compaction.
+	TreeGroupIndex *group_index = _get_tree_group_index(this);
+	MutexLock index_lock(group_index->mutex);
+	const GroupSlots *gs = group_index->slots.getptr(&E->value);
+	return gs ? (int)gs->slots.size() : E->value.nodes.size();
 }
 
 Node *SceneTree::get_first_node_in_group(const StringName &p_group) {
@@ -1827,6 +2828,16 @@ RequiredResult<SceneTreeTimer> SceneTree::create_timer(double p_delay_sec, bool
 	stt->set_process_in_physics(p_process_in_physics);
 	stt->set_ignore_time_scale(p_ignore_time_scale);
 	timers.push_back(stt);
+
+	MutexLock lock(timers_mutex);
+	TreeTimers &timers_state = tree_timers[this];
+	ScheduledTimer &state = scheduled_timers[stt.ptr()];
+	state.tree = this;
+	state.element = timers.back();
+	state.order = timers_state.next_order++;
+	state.queue = _timer_queue_index(p_process_in_physics, p_process_always, p_ignore_time_scale);
+	timers_state.queues[state.queue].live++;
+	_schedule_timer(stt.ptr(), state, p_delay_sec);
 	return stt;
 }
 
@@ -2104,6 +3115,16 @@ SceneTree::SceneTree() {
 	if (singleton == nullptr) {
 		singleton = this;
 	}
+	{
+		// Goblin Engine: fast scene tree (M-16).
+		TreeGroupIndex *group_index = memnew(TreeGroupIndex);
+		RWLockWrite lock(tree_group_indexes_lock);
+		tree_group_indexes.insert(this, group_index);
+		if (main_group_tree.load() == nullptr) {
+			main_tree_group_index = group_index;
+			main_group_tree.store(this, std::memory_order_release);
+		}
+	}
 	debug_collisions_color = GLOBAL_DEF("debug/shapes/collision/shape_color", Color(0.0, 0.6, 0.7, 0.42));
 	debug_collision_contact_color = GLOBAL_DEF("debug/shapes/collision/contact_color", Color(1.0, 0.2, 0.1, 0.8));
 	debug_paths_color = GLOBAL_DEF("debug/shapes/paths/geometry_color", Color(0.1, 1.0, 0.7, 0.4));
@@ -2309,6 +3330,24 @@ SceneTree::~SceneTree() {
 
 	memdelete(process_group_call_queue_allocator);
 
+	_clear_tree_timers(this);
+
+	{
+		// Goblin Engine: fast scene tree (M-16).
+		RWLockWrite lock(tree_group_indexes_lock);
+		if (main_group_tree.load() == this) {
+			main_group_tree.store(nullptr);
+			main_tree_group_index = nullptr;
+		}
+		memdelete(tree_group_indexes[this]);
+		tree_group_indexes.erase(this);
+	}
+#ifndef _3D_DISABLED
+	if (SpatialGroupIndex::get_singleton() != nullptr) {
+		SpatialGroupIndex::get_singleton()->tree_deleted(this); // Goblin Engine: fast scene tree (M-25).
+	}
+#endif // _3D_DISABLED
+
 	if (singleton == this) {
 		singleton = nullptr;
 	}
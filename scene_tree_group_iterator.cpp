@@ -0,0 +1,62 @@
+/**************************************************************************/
+/*  scene_tree_group_iterator.cpp                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                            GOBLIN ENGINE                               */
+/**************************************************************************/
+
+#include "scene_tree_group_iterator.h"
+
+#include "core/object/class_db.h"
+#include "scene/main/node.h"
+#include "scene/main/scene_tree.h"
+
+Ref<SceneTreeGroupIterator> SceneTreeGroupIterator::iterate(const StringName &p_group) {
+	SceneTree *tree = SceneTree::get_singleton();
+	ERR_FAIL_NULL_V(tree, Ref<SceneTreeGroupIterator>());
+
+	Ref<SceneTreeGroupIterator> iterator;
+	for (const Ref<SceneTreeGroupIterator> &pooled : pool) {
+		if (pooled->get_reference_count() == 1) {
+			iterator = pooled;
+			break;
+		}
+	}
+	if (iterator.is_null()) {
+		iterator.instantiate();
+		if (pool.size() < POOL_SIZE) {
+			pool.push_back(iterator);
+		}
+	}
+	iterator->tree = tree;
+	iterator->group = p_group;
+	return iterator;
+}
+
+void SceneTreeGroupIterator::clear_pool() {
+	pool.clear();
+}
+
+// The walk starts in `_iter_init()`, so one iterator can be looped over again.
+bool SceneTreeGroupIterator::_iter_init(const Variant &p_state) {
+	ERR_FAIL_NULL_V(tree, false);
+	cursor.reset(tree, group);
+	return cursor.next() != nullptr;
+}
+
+bool SceneTreeGroupIterator::_iter_next(const Variant &p_state) {
+	return cursor.next() != nullptr;
+}
+
+Node *SceneTreeGroupIterator::_iter_get(const Variant &p_state) const {
+	return cursor.get_current();
+}
+
+void SceneTreeGroupIterator::_bind_methods() {
+	ClassDB::bind_static_method("SceneTreeGroupIterator", D_METHOD("iterate", "group"), &SceneTreeGroupIterator::iterate);
+	ClassDB::bind_method(D_METHOD("_iter_init", "state"), &SceneTreeGroupIterator::_iter_init);
+	ClassDB::bind_method(D_METHOD("_iter_next", "state"), &SceneTreeGroupIterator::_iter_next);
+	ClassDB::bind_method(D_METHOD("_iter_get", "state"), &SceneTreeGroupIterator::_iter_get);
+
+	BIND_CONSTANT(GROUP_CALL_DEFERRED_LIVE);
+}
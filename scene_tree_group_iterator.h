@@ -0,0 +1,96 @@
+/**************************************************************************/
+/*  scene_tree_group_iterator.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                            GOBLIN ENGINE                               */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/ref_counted.h"
+#include "core/string/string_name.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/vector.h"
+
+class Node;
+class SceneTree;
+struct SceneTreeGroupRemovals;
+
+// Extra `SceneTree::GroupCallFlags` bit, with `GROUP_CALL_DEFERRED`: the deferred group
+// call reaches the members of the group when the message queue is flushed, instead of the
+// members at the time of the call. Bound for scripts as
+// `SceneTreeGroupIterator.GROUP_CALL_DEFERRED_LIVE`.
+static constexpr uint32_t GROUP_CALL_DEFERRED_LIVE = 1 << 4;
+
+// Walks the members of a scene tree group in tree order, without copying them:
+// `SceneTree::get_nodes_in_group()` returns a `Vector` copy and the scripting binding a
+// `TypedArray<Node>` with a reference per element. The cursor shares the group's storage
+// (copy-on-write), so members removed during the walk are detected and skipped: removals
+// null-mark the live storage, which is then copied, and the cursor checks membership
+// again only once a member has left the group. Members added during the walk are not
+// visited. Implemented in `scene/main/scene_tree.cpp`, next to the group storage.
+//
+//     SceneTreeGroupCursor cursor(tree, SNAME("enemies"));
+//     while (Node *enemy = cursor.next()) { ... }
+class SceneTreeGroupCursor {
+	SceneTree *tree = nullptr;
+	StringName group;
+	Vector<Node *> nodes; // The group's storage at the start of the walk.
+	uint32_t index = 0; // Members walked so far.
+	SceneTreeGroupRemovals *group_removals = nullptr; // The group's removal count, referenced during the walk.
+	uint64_t removals = 0; // Its value at the start of the walk.
+	bool reverse = false;
+
+	void _release_removals();
+
+public:
+	// Restarts the walk, on the group as it is now. `p_reverse` walks it in reverse tree order.
+	void reset(SceneTree *p_tree, const StringName &p_group, bool p_reverse = false);
+	// Returns the next member still in the group, or `nullptr` at the end.
+	Node *next();
+	Node *get_current() const {
+		if (index == 0 || index > (uint32_t)nodes.size()) {
+			return nullptr;
+		}
+		return nodes[reverse ? nodes.size() - index : index - 1];
+	}
+
+	SceneTreeGroupCursor() {}
+	SceneTreeGroupCursor(SceneTree *p_tree, const StringName &p_group, bool p_reverse = false) { reset(p_tree, p_group, p_reverse); }
+	SceneTreeGroupCursor(const SceneTreeGroupCursor &) = delete;
+	SceneTreeGroupCursor &operator=(const SceneTreeGroupCursor &) = delete;
+	~SceneTreeGroupCursor() { _release_removals(); }
+};
+
+// Calls `p_function(Node *)` for each member of the group, in tree order.
+template <typename F>
+void for_each_node_in_group(SceneTree *p_tree, const StringName &p_group, F &&p_function) {
+	SceneTreeGroupCursor cursor(p_tree, p_group);
+	while (Node *node = cursor.next()) {
+		p_function(node);
+	}
+}
+
+// Script-facing cursor, for `for enemy in SceneTreeGroupIterator.iterate(&"enemies"):`.
+// Iterators are pooled: one that is no longer referenced is reused by the next `iterate()`.
+class SceneTreeGroupIterator : public RefCounted {
+	GDCLASS(SceneTreeGroupIterator, RefCounted);
+
+	static constexpr uint32_t POOL_SIZE = 8;
+	static inline LocalVector<Ref<SceneTreeGroupIterator>> pool;
+
+	SceneTreeGroupCursor cursor;
+	SceneTree *tree = nullptr;
+	StringName group;
+
+protected:
+	static void _bind_methods();
+
+public:
+	static Ref<SceneTreeGroupIterator> iterate(const StringName &p_group);
+	static void clear_pool();
+
+	bool _iter_init(const Variant &p_state);
+	bool _iter_next(const Variant &p_state);
+	Node *_iter_get(const Variant &p_state) const;
+};
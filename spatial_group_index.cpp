@@ -0,0 +1,430 @@
+/**************************************************************************/
+/*  spatial_group_index.cpp                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                            GOBLIN ENGINE                               */
+/**************************************************************************/
+
+#include "spatial_group_index.h"
+
+#ifndef _3D_DISABLED
+
+#include "scene_tree_group_iterator.h"
+
+#include "core/object/class_db.h"
+#include "scene/3d/node_3d.h"
+#include "scene/main/scene_tree.h"
+
+// Positions beyond the grid limit share its border cells, non-finite ones the middle cell,
+// so that cell coordinates (and cell counts of infinite query ranges) fit their integers.
+// Queries still compare the actual positions.
+Vector3i SpatialGroupIndex::_get_cell(const Index &p_index, const Vector3 &p_position) {
+	const real_t limit = 1 << 20;
+	const Vector3 cell = (p_position / p_index.cell_size).floor();
+	Vector3i result;
+	for (int axis = 0; axis < 3; axis++) {
+		result[axis] = Math::is_nan(cell[axis]) ? 0 : int(CLAMP(cell[axis], -limit, limit));
+	}
+	return result;
+}
+
+void SpatialGroupIndex::_add_member(Index &r_index, Node *p_node) {
+	Node3D *node = Object::cast_to<Node3D>(p_node);
+	if (node == nullptr || r_index.slots.has(p_node)) {
+		return;
+	}
+	Member member;
+	member.node = node;
+	uint32_t *owners = notify_owners.getptr(p_node);
+	if (owners != nullptr) {
+		(*owners)++;
+		member.notify_set = true;
+	} else if (!node->is_transform_notification_enabled()) {
+		node->set_notify_transform(true);
+		notify_owners.insert(p_node, 1);
+		member.notify_set = true;
+	}
+	r_index.slots.insert(p_node, r_index.members.size());
+	r_index.members.push_back(member);
+	r_index.dirty.push_back(p_node);
+}
+
+// Turns transform notifications off when the last index relying on them lets go, unless
+// `p_restore` is false (the node is going away with its tree).
+void SpatialGroupIndex::_release_notify(Node3D *p_node, bool p_restore) {
+	HashMap<Node *, uint32_t>::Iterator E = notify_owners.find(p_node);
+	ERR_FAIL_COND(!E);
+	if (--E->value > 0) {
+		return;
+	}
+	notify_owners.remove(E);
+	if (p_restore) {
+		p_node->set_notify_transform(false);
+	}
+}
+
+void SpatialGroupIndex::_unlink_member(Index &r_index, uint32_t p_slot) {
+	Member &member = r_index.members[p_slot];
+	HashMap<Vector3i, LocalVector<uint32_t>>::Iterator E = r_index.cells.find(member.cell);
+	ERR_FAIL_COND(!E);
+	const int64_t position = E->value.find(p_slot);
+	ERR_FAIL_COND(position < 0);
+	E->value.remove_at_unordered(position);
+	if (E->value.is_empty()) {
+		r_index.cells.remove(E);
+	}
+	member.placed = false;
+}
+
+void SpatialGroupIndex::_remove_member(Index &r_index, Node *p_node) {
+	HashMap<Node *, uint32_t>::Iterator S = r_index.slots.find(p_node);
+	if (!S) {
+		return;
+	}
+	const uint32_t slot = S->value;
+	r_index.slots.remove(S);
+	if (r_index.members[slot].notify_set) {
+		_release_notify(r_index.members[slot].node);
+	}
+	if (r_index.members[slot].placed) {
+		_unlink_member(r_index, slot);
+	}
+
+	// Move the last member into the freed slot.
+	const uint32_t last = r_index.members.size() - 1;
+	if (slot != last) {
+		Member &moved = r_index.members[last];
+		if (moved.placed) {
+			LocalVector<uint32_t> &cell = r_index.cells[moved.cell];
+			cell[cell.find(last)] = slot;
+		}
+		r_index.slots[moved.node] = slot;
+		r_index.members[slot] = moved;
+	}
+	r_index.members.resize(last);
+}
+
+// Places the members that moved or joined since the last query.
+void SpatialGroupIndex::_update(Index &r_index) {
+	for (Node *node : r_index.dirty) {
+		const uint32_t *slot = r_index.slots.getptr(node);
+		if (slot == nullptr || !r_index.members[*slot].dirty) {
+			continue;
+		}
+		Member &member = r_index.members[*slot];
+		member.dirty = false;
+		member.position = member.node->get_global_position();
+		const Vector3i cell = _get_cell(r_index, member.position);
+		if (member.placed && member.cell == cell) {
+			continue;
+		}
+		if (member.placed) {
+			_unlink_member(r_index, *slot);
+		}
+		member.cell = cell;
+		member.placed = true;
+		r_index.cells[cell].push_back(*slot);
+	}
+	r_index.dirty.clear();
+}
+
+SpatialGroupIndex::Index *SpatialGroupIndex::_get_index(const StringName &p_group) {
+	Index *index = indexes.getptr(p_group);
+	ERR_FAIL_NULL_V_MSG(index, nullptr, vformat("Group \"%s\" is not spatially indexed. Call enable_group() first.", p_group));
+	_update(*index);
+	return index;
+}
+
+void SpatialGroupIndex::enable_group(const StringName &p_group, real_t p_cell_size) {
+	ERR_FAIL_COND_MSG(p_cell_size <= 0.0, "Spatial group index cell size must be positive.");
+	SceneTree *tree = SceneTree::get_singleton();
+	ERR_FAIL_NULL(tree);
+
+	Index *index = indexes.getptr(p_group);
+	if (index != nullptr) {
+		if (index->cell_size != p_cell_size) {
+			// Place everything again with the new cell size.
+			index->cell_size = p_cell_size;
+			index->cells.clear();
+			index->dirty.clear();
+			for (Member &member : index->members) {
+				member.placed = false;
+				member.dirty = true;
+				index->dirty.push_back(member.node);
+			}
+		}
+		return;
+	}
+
+	index = &indexes.insert(p_group, Index())->value;
+	index->tree = tree;
+	index->cell_size = p_cell_size;
+	for_each_node_in_group(tree, p_group, [&](Node *p_node) { _add_member(*index, p_node); });
+}
+
+void SpatialGroupIndex::disable_group(const StringName &p_group) {
+	HashMap<StringName, Index>::Iterator E = indexes.find(p_group);
+	if (!E) {
+		return;
+	}
+	for (const Member &member : E->value.members) {
+		if (member.notify_set) {
+			_release_notify(member.node);
+		}
+	}
+	indexes.remove(E);
+}
+
+bool SpatialGroupIndex::is_group_enabled(const StringName &p_group) const {
+	return indexes.has(p_group);
+}
+
+int SpatialGroupIndex::get_indexed_count(const StringName &p_group) const {
+	const Index *index = indexes.getptr(p_group);
+	return index != nullptr ? index->members.size() : 0;
+}
+
+void SpatialGroupIndex::query_radius(const StringName &p_group, const Vector3 &p_center, real_t p_radius, LocalVector<Node3D *> &r_nodes) {
+	Index *index = _get_index(p_group);
+	if (index == nullptr || p_radius < 0.0) {
+		return;
+	}
+	const real_t radius_squared = p_radius * p_radius;
+	const Vector3i from = _get_cell(*index, p_center - Vector3(p_radius, p_radius, p_radius));
+	const Vector3i to = _get_cell(*index, p_center + Vector3(p_radius, p_radius, p_radius));
+	const uint64_t cell_count = uint64_t(to.x - from.x + 1) * uint64_t(to.y - from.y + 1) * uint64_t(to.z - from.z + 1);
+
+	// Large radii look at every member rather than at mostly empty cells.
+	if (cell_count > index->members.size()) {
+		for (const Member &member : index->members) {
+			if (member.position.distance_squared_to(p_center) <= radius_squared) {
+				r_nodes.push_back(member.node);
+			}
+		}
+		return;
+	}
+	for (int x = from.x; x <= to.x; x++) {
+		for (int y = from.y; y <= to.y; y++) {
+			for (int z = from.z; z <= to.z; z++) {
+				const LocalVector<uint32_t> *cell = index->cells.getptr(Vector3i(x, y, z));
+				if (cell == nullptr) {
+					continue;
+				}
+				for (const uint32_t slot : *cell) {
+					const Member &member = index->members[slot];
+					if (member.position.distance_squared_to(p_center) <= radius_squared) {
+						r_nodes.push_back(member.node);
+					}
+				}
+			}
+		}
+	}
+}
+
+void SpatialGroupIndex::query_aabb(const StringName &p_group, const AABB &p_aabb, LocalVector<Node3D *> &r_nodes) {
+	Index *index = _get_index(p_group);
+	if (index == nullptr) {
+		return;
+	}
+	const AABB aabb = p_aabb.abs();
+	const Vector3i from = _get_cell(*index, aabb.position);
+	const Vector3i to = _get_cell(*index, aabb.get_end());
+	const uint64_t cell_count = uint64_t(to.x - from.x + 1) * uint64_t(to.y - from.y + 1) * uint64_t(to.z - from.z + 1);
+
+	if (cell_count > index->members.size()) {
+		for (const Member &member : index->members) {
+			if (aabb.has_point(member.position)) {
+				r_nodes.push_back(member.node);
+			}
+		}
+		return;
+	}
+	for (int x = from.x; x <= to.x; x++) {
+		for (int y = from.y; y <= to.y; y++) {
+			for (int z = from.z; z <= to.z; z++) {
+				const LocalVector<uint32_t> *cell = index->cells.getptr(Vector3i(x, y, z));
+				if (cell == nullptr) {
+					continue;
+				}
+				for (const uint32_t slot : *cell) {
+					const Member &member = index->members[slot];
+					if (aabb.has_point(member.position)) {
+						r_nodes.push_back(member.node);
+					}
+				}
+			}
+		}
+	}
+}
+
+// Searches shells of cells around the point's cell, nearest first, until the
+// closest `p_count` members found can't be beaten by the next shell.
+void SpatialGroupIndex::query_nearest(const StringName &p_group, const Vector3 &p_point, int p_count, real_t p_max_distance, LocalVector<Node3D *> &r_nodes) {
+	Index *index = _get_index(p_group);
+	if (index == nullptr || p_count <= 0 || index->members.is_empty()) {
+		return;
+	}
+
+	struct Candidate {
+		real_t distance_squared;
+		uint32_t slot;
+	};
+	const uint32_t count = p_count;
+	const real_t max_distance_squared = p_max_distance * p_max_distance;
+	LocalVector<Candidate> best; // Sorted, closest first.
+
+	auto consider = [&](uint32_t p_slot) {
+		const real_t distance_squared = index->members[p_slot].position.distance_squared_to(p_point);
+		if (distance_squared > max_distance_squared || (best.size() == count && distance_squared >= best[count - 1].distance_squared)) {
+			return;
+		}
+		if (best.size() < count) {
+			best.push_back(Candidate());
+		}
+		uint32_t i = best.size() - 1;
+		for (; i > 0 && best[i - 1].distance_squared > distance_squared; i--) {
+			best[i] = best[i - 1];
+		}
+		best[i] = { distance_squared, p_slot };
+	};
+
+	const Vector3i origin = _get_cell(*index, p_point);
+	uint32_t visited = 0;
+	for (int ring = 0;; ring++) {
+		// A shell with more cells than there are members: finish with a scan.
+		const uint64_t shell_cells = ring == 0 ? 1 : uint64_t(24) * ring * ring + 2;
+		if (shell_cells > index->members.size()) {
+			best.clear();
+			for (uint32_t slot = 0; slot < index->members.size(); slot++) {
+				consider(slot);
+			}
+			break;
+		}
+
+		for (int x = -ring; x <= ring; x++) {
+			for (int y = -ring; y <= ring; y++) {
+				// Inside the shell, only its two z faces.
+				const bool inner = Math::abs(x) < ring && Math::abs(y) < ring;
+				for (int z = -ring; z <= ring; z += inner ? 2 * ring : 1) {
+					const LocalVector<uint32_t> *cell = index->cells.getptr(origin + Vector3i(x, y, z));
+					if (cell == nullptr) {
+						continue;
+					}
+					visited += cell->size();
+					for (const uint32_t slot : *cell) {
+						consider(slot);
+					}
+				}
+			}
+		}
+
+		// Anything in the next shell is at least `ring` cells away.
+		const real_t next_distance = ring * index->cell_size;
+		if (visited == index->members.size() || next_distance > p_max_distance || (best.size() == count && best[count - 1].distance_squared <= next_distance * next_distance)) {
+			break;
+		}
+	}
+
+	for (const Candidate &candidate : best) {
+		r_nodes.push_back(index->members[candidate.slot].node);
+	}
+}
+
+TypedArray<Node3D> SpatialGroupIndex::_get_nodes_in_radius(const StringName &p_group, const Vector3 &p_center, real_t p_radius) {
+	LocalVector<Node3D *> nodes;
+	query_radius(p_group, p_center, p_radius, nodes);
+	TypedArray<Node3D> result;
+	result.resize(nodes.size());
+	for (uint32_t i = 0; i < nodes.size(); i++) {
+		result[i] = nodes[i];
+	}
+	return result;
+}
+
+TypedArray<Node3D> SpatialGroupIndex::_get_nodes_in_aabb(const StringName &p_group, const AABB &p_aabb) {
+	LocalVector<Node3D *> nodes;
+	query_aabb(p_group, p_aabb, nodes);
+	TypedArray<Node3D> result;
+	result.resize(nodes.size());
+	for (uint32_t i = 0; i < nodes.size(); i++) {
+		result[i] = nodes[i];
+	}
+	return result;
+}
+
+TypedArray<Node3D> SpatialGroupIndex::_get_nearest_nodes(const StringName &p_group, const Vector3 &p_point, int p_count, real_t p_max_distance) {
+	LocalVector<Node3D *> nodes;
+	query_nearest(p_group, p_point, p_count, p_max_distance, nodes);
+	TypedArray<Node3D> result;
+	result.resize(nodes.size());
+	for (uint32_t i = 0; i < nodes.size(); i++) {
+		result[i] = nodes[i];
+	}
+	return result;
+}
+
+void SpatialGroupIndex::node_added(SceneTree *p_tree, const StringName &p_group, Node *p_node) {
+	Index *index = indexes.getptr(p_group);
+	if (index != nullptr && index->tree == p_tree) {
+		_add_member(*index, p_node);
+	}
+}
+
+void SpatialGroupIndex::node_removed(SceneTree *p_tree, const StringName &p_group, Node *p_node) {
+	Index *index = indexes.getptr(p_group);
+	if (index != nullptr && index->tree == p_tree) {
+		_remove_member(*index, p_node);
+	}
+}
+
+void SpatialGroupIndex::transform_changed(Node *p_node) {
+	for (KeyValue<StringName, Index> &E : indexes) {
+		const uint32_t *slot = E.value.slots.getptr(p_node);
+		if (slot != nullptr && !E.value.members[*slot].dirty) {
+			E.value.members[*slot].dirty = true;
+			E.value.dirty.push_back(p_node);
+		}
+	}
+}
+
+// Groups stay enabled, empty; they don't follow a new tree.
+void SpatialGroupIndex::tree_deleted(SceneTree *p_tree) {
+	for (KeyValue<StringName, Index> &E : indexes) {
+		if (E.value.tree == p_tree) {
+			for (const Member &member : E.value.members) {
+				if (member.notify_set) {
+					_release_notify(member.node, false);
+				}
+			}
+			E.value.tree = nullptr;
+			E.value.members.clear();
+			E.value.slots.clear();
+			E.value.cells.clear();
+			E.value.dirty.clear();
+		}
+	}
+}
+
+void SpatialGroupIndex::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("enable_group", "group", "cell_size"), &SpatialGroupIndex::enable_group, DEFVAL(8.0));
+	ClassDB::bind_method(D_METHOD("disable_group", "group"), &SpatialGroupIndex::disable_group);
+	ClassDB::bind_method(D_METHOD("is_group_enabled", "group"), &SpatialGroupIndex::is_group_enabled);
+	ClassDB::bind_method(D_METHOD("get_indexed_count", "group"), &SpatialGroupIndex::get_indexed_count);
+	ClassDB::bind_method(D_METHOD("get_nodes_in_radius", "group", "center", "radius"), &SpatialGroupIndex::_get_nodes_in_radius);
+	ClassDB::bind_method(D_METHOD("get_nodes_in_aabb", "group", "aabb"), &SpatialGroupIndex::_get_nodes_in_aabb);
+	ClassDB::bind_method(D_METHOD("get_nearest_nodes", "group", "point", "count", "max_distance"), &SpatialGroupIndex::_get_nearest_nodes, DEFVAL(Math::INF));
+}
+
+SpatialGroupIndex::SpatialGroupIndex() {
+	if (singleton == nullptr) {
+		singleton = this;
+	}
+}
+
+SpatialGroupIndex::~SpatialGroupIndex() {
+	if (singleton == this) {
+		singleton = nullptr;
+	}
+}
+
+#endif // _3D_DISABLED
@@ -0,0 +1,104 @@
+/**************************************************************************/
+/*  spatial_group_index.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                            GOBLIN ENGINE                               */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/aabb.h"
+#include "core/math/vector3i.h"
+#include "core/object/object.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/typed_array.h"
+
+class Node;
+class Node3D;
+class SceneTree;
+
+// Spatial queries over scene tree groups (`SpatialGroupIndex` singleton), kept up to date
+// by `SceneTree`.
+//
+// "Which members of a group are within R of P" was `get_nodes_in_group()` plus a distance
+// filter, O(group) per query. An indexed group keeps the global positions of its `Node3D`
+// members in a uniform hash grid, so radius, AABB and nearest-member queries only look at
+// the cells around the query. Members joining or leaving the group are picked up by
+// `SceneTree::add_to_group()`/`remove_from_group()`. Movement comes from transform
+// notifications: indexed members get `set_notify_transform(true)` unless they had it already
+// (turned off again once no index needs it), and
+// `SceneTree::flush_transform_notifications()` marks the ones it notifies; their cells
+// are updated by the next query. A member that moved since the last flush is found where
+// it was at that flush. Members are points (their origin), other members of the group are
+// ignored. Pure scene tree data: no rendering or physics server is involved.
+//
+// Main thread only, for groups of the main `SceneTree`.
+class SpatialGroupIndex : public Object {
+	GDCLASS(SpatialGroupIndex, Object);
+
+	static inline SpatialGroupIndex *singleton = nullptr;
+
+	struct Member {
+		Node3D *node = nullptr;
+		Vector3 position; // Global origin when last placed.
+		Vector3i cell;
+		bool placed = false; // In `cells`.
+		bool dirty = true; // Moved, or new: position to read again before the next query.
+		bool notify_set = false; // Holds a count in `notify_owners`.
+	};
+
+	struct Index {
+		SceneTree *tree = nullptr;
+		real_t cell_size = 8.0;
+		LocalVector<Member> members;
+		HashMap<Node *, uint32_t> slots; // Member -> index in `members`.
+		HashMap<Vector3i, LocalVector<uint32_t>> cells;
+		LocalVector<Node *> dirty; // Looked up in `slots`, so members removed since are skipped.
+	};
+
+	HashMap<StringName, Index> indexes;
+	// Members whose transform notifications were turned on by an index -> members of indexes
+	// relying on it. Shared by all groups: a node in two indexed groups keeps them on until
+	// it leaves both.
+	HashMap<Node *, uint32_t> notify_owners;
+
+	static Vector3i _get_cell(const Index &p_index, const Vector3 &p_position);
+	void _add_member(Index &r_index, Node *p_node);
+	void _remove_member(Index &r_index, Node *p_node);
+	void _release_notify(Node3D *p_node, bool p_restore = true);
+	static void _unlink_member(Index &r_index, uint32_t p_slot);
+	static void _update(Index &r_index);
+	Index *_get_index(const StringName &p_group);
+
+	TypedArray<Node3D> _get_nodes_in_radius(const StringName &p_group, const Vector3 &p_center, real_t p_radius);
+	TypedArray<Node3D> _get_nodes_in_aabb(const StringName &p_group, const AABB &p_aabb);
+	TypedArray<Node3D> _get_nearest_nodes(const StringName &p_group, const Vector3 &p_point, int p_count, real_t p_max_distance);
+
+protected:
+	static void _bind_methods();
+
+public:
+	static SpatialGroupIndex *get_singleton() { return singleton; }
+
+	void enable_group(const StringName &p_group, real_t p_cell_size = 8.0);
+	void disable_group(const StringName &p_group);
+	bool is_group_enabled(const StringName &p_group) const;
+	int get_indexed_count(const StringName &p_group) const;
+
+	// Queries appending to `r_nodes`, without allocating a `TypedArray`.
+	void query_radius(const StringName &p_group, const Vector3 &p_center, real_t p_radius, LocalVector<Node3D *> &r_nodes);
+	void query_aabb(const StringName &p_group, const AABB &p_aabb, LocalVector<Node3D *> &r_nodes);
+	// Closest first.
+	void query_nearest(const StringName &p_group, const Vector3 &p_point, int p_count, real_t p_max_distance, LocalVector<Node3D *> &r_nodes);
+
+	// Called by `SceneTree`.
+	bool is_active() const { return !indexes.is_empty(); }
+	void node_added(SceneTree *p_tree, const StringName &p_group, Node *p_node);
+	void node_removed(SceneTree *p_tree, const StringName &p_group, Node *p_node);
+	void transform_changed(Node *p_node);
+	void tree_deleted(SceneTree *p_tree);
+
+	SpatialGroupIndex();
+	~SpatialGroupIndex();
+};
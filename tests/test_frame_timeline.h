@@ -0,0 +1,161 @@
+/**************************************************************************/
+/*  test_frame_timeline.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                            GOBLIN ENGINE                               */
+/**************************************************************************/
+
+#pragma once
+
+#include "modules/goblin/frame_timeline.h"
+
+#include "core/config/project_settings.h"
+#include "core/io/file_access.h"
+#include "core/io/json.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+// Timeline capture (C-18): spans recorded on several threads, written by `finish()`, and
+// read back as trace-event JSON.
+namespace TestFrameTimeline {
+
+static void start_capture(const String &p_path) {
+	ProjectSettings *settings = ProjectSettings::get_singleton();
+	settings->set_setting("debug/settings/timeline/enabled", true);
+	settings->set_setting("debug/settings/timeline/output_path", p_path);
+	settings->set_setting("debug/settings/timeline/first_frame", 0);
+	settings->set_setting("debug/settings/timeline/frame_count", 0);
+	FrameTimeline::configure();
+}
+
+static void stop_capture() {
+	FrameTimeline::finish();
+	ProjectSettings::get_singleton()->set_setting("debug/settings/timeline/enabled", false);
+}
+
+// Events of the trace other than metadata.
+static Array read_events(const String &p_path) {
+	const Dictionary trace = JSON::parse_string(FileAccess::get_file_as_string(p_path));
+	Array events;
+	for (const Variant &event : Array(trace.get("traceEvents", Array()))) {
+		const Dictionary dict = event;
+		if (dict["ph"] != "M") {
+			events.push_back(dict);
+		}
+	}
+	return events;
+}
+
+static int count_events(const Array &p_events, const String &p_name, const String &p_phase) {
+	int count = 0;
+	for (const Variant &event : p_events) {
+		const Dictionary dict = event;
+		count += dict.get("name", "") == p_name && dict["ph"] == p_phase;
+	}
+	return count;
+}
+
+struct SpanThread {
+	Semaphore opened;
+	Semaphore close;
+	const char *label = nullptr;
+
+	static void run(void *p_userdata) {
+		SpanThread *self = static_cast<SpanThread *>(p_userdata);
+		{
+			FrameTimelineScope scope(self->label);
+			self->opened.post();
+			self->close.wait();
+		}
+		// Recorded only if a capture is running again.
+		FrameTimelineScope scope("Worker after");
+	}
+};
+
+TEST_CASE("[Goblin][Timeline] Spans from several threads are written as trace events") {
+	const String path = TestUtils::get_temp_path("frame_timeline.json");
+	start_capture(path);
+	REQUIRE(FrameTimeline::is_recording());
+
+	{
+		FRAME_TIMELINE_SCOPE("Outer");
+		FrameTimelineScope inner("Inner", "inner_name", "inner detail");
+	}
+	SpanThread worker;
+	worker.label = "Worker";
+	Thread thread;
+	thread.start(&SpanThread::run, &worker);
+	worker.opened.wait();
+	worker.close.post();
+	thread.wait_to_finish();
+	FrameTimeline::begin("Open at the end");
+
+	stop_capture();
+	CHECK_FALSE(FrameTimeline::is_recording());
+
+	const Array events = read_events(path);
+	CHECK(count_events(events, "Outer", "B") == 1);
+	CHECK(count_events(events, "inner_name", "B") == 1);
+	CHECK(count_events(events, "Worker", "B") == 1);
+	CHECK(count_events(events, "Worker after", "B") == 1);
+	CHECK(count_events(events, "Open at the end", "B") == 1);
+
+	// Every begin has an end on its thread, including the span still open at `finish()`.
+	HashMap<int, int> depth;
+	for (const Variant &event : events) {
+		const Dictionary dict = event;
+		const int tid = dict["tid"];
+		if (dict["ph"] == "B") {
+			depth[tid]++;
+		} else if (dict["ph"] == "E") {
+			REQUIRE(depth.has(tid));
+			CHECK(depth[tid] > 0);
+			depth[tid]--;
+		}
+	}
+	for (const KeyValue<int, int> &E : depth) {
+		CHECK(E.value == 0);
+	}
+}
+
+TEST_CASE("[Goblin][Timeline] A span open on another thread can end after finish()") {
+	const String first_path = TestUtils::get_temp_path("frame_timeline_first.json");
+	start_capture(first_path);
+
+	SpanThread worker;
+	worker.label = "Across finish";
+	Thread thread;
+	thread.start(&SpanThread::run, &worker);
+	worker.opened.wait();
+
+	// The worker still has its buffer of the first capture when that capture is released,
+	// and keeps recording into a new one for the second capture.
+	stop_capture();
+	const String second_path = TestUtils::get_temp_path("frame_timeline_second.json");
+	start_capture(second_path);
+	worker.close.post();
+	thread.wait_to_finish();
+	stop_capture();
+
+	const Array first = read_events(first_path);
+	CHECK(count_events(first, "Across finish", "B") == 1);
+	CHECK(count_events(first, "Worker after", "B") == 0);
+	const Array second = read_events(second_path);
+	CHECK(count_events(second, "Across finish", "B") == 0);
+	CHECK(count_events(second, "Worker after", "B") == 1);
+}
+
+TEST_CASE("[Goblin][Timeline] Nothing is recorded while the timeline is off") {
+	CHECK_FALSE(FrameTimeline::is_recording());
+	{
+		FRAME_TIMELINE_SCOPE("Off");
+	}
+	const String path = TestUtils::get_temp_path("frame_timeline_off.json");
+	CHECK(FrameTimeline::save(path) == OK);
+	CHECK(count_events(read_events(path), "Off", "B") == 0);
+}
+
+} // namespace TestFrameTimeline
@@ -0,0 +1,697 @@
+/**************************************************************************/
+/*  test_scene_tree.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                            GOBLIN ENGINE                               */
+/**************************************************************************/
+
+#pragma once
+
+#include "modules/goblin/process_cadence.h"
+#include "modules/goblin/process_group_scheduler.h"
+#include "modules/goblin/scene_tree_group_iterator.h"
+
+#include "core/object/message_queue.h"
+#include "core/os/os.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/window.h"
+
+#include "tests/test_macros.h"
+
+// Behavior checks for the fast scene tree (M-14 and later) run with the suite. The
+// "[Benchmark]" cases are skipped by default; run them with
+// `godot --test --test-case="*Benchmark*" --no-skip`.
+namespace TestGoblinSceneTree {
+
+static Node *make_children(Node *p_parent, int p_count) {
+	for (int i = 0; i < p_count; i++) {
+		Node *child = memnew(Node);
+		child->set_name(vformat("Child%d", i));
+		p_parent->add_child(child);
+	}
+	return p_parent;
+}
+
+class TimerRecorder : public Object {
+public:
+	Vector<int> fired;
+
+	void record(int p_id) { fired.push_back(p_id); }
+	void record_and_spawn(int p_id) {
+		fired.push_back(p_id);
+		Ref<SceneTreeTimer> timer = SceneTree::get_singleton()->create_timer(0.0);
+		timer->connect("timeout", callable_mp(this, &TimerRecorder::record).bind(p_id + 100));
+	}
+};
+
+class ProcessCounter : public Node {
+	GDCLASS(ProcessCounter, Node);
+
+protected:
+	void _notification(int p_what) {
+		if (p_what == NOTIFICATION_PROCESS) {
+			deltas.push_back(get_process_delta_time());
+		}
+	}
+
+public:
+	Vector<double> deltas;
+};
+
+// Stops and starts the processing of other nodes on its second process.
+class ProcessToggler : public Node {
+	GDCLASS(ProcessToggler, Node);
+
+protected:
+	void _notification(int p_what) {
+		if (p_what == NOTIFICATION_PROCESS && frame++ == 1) {
+			for (Node *node : stopped) {
+				node->set_process(false);
+			}
+			for (Node *node : started) {
+				node->set_process(true);
+			}
+		}
+	}
+
+public:
+	int frame = 0;
+	Vector<Node *> stopped;
+	Vector<Node *> started;
+};
+
+static bool is_in_tree_order(const Vector<Node *> &p_nodes) {
+	for (int i = 1; i < p_nodes.size(); i++) {
+		if (!p_nodes[i]->is_greater_than(p_nodes[i - 1])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+TEST_CASE("[SceneTree][Goblin] Group membership stays exact and ordered under churn") {
+	SceneTree *tree = SceneTree::get_singleton();
+	Node *parent = make_children(memnew(Node), 64);
+	tree->get_root()->add_child(parent);
+
+	// Join in reverse tree order, so the group has to be sorted.
+	for (int i = 63; i >= 0; i--) {
+		parent->get_child(i)->add_to_group("goblin_churn");
+	}
+	CHECK(tree->get_node_count_in_group("goblin_churn") == 64);
+
+	// Leave from the middle and the ends, then rejoin some.
+	for (int i = 0; i < 64; i += 3) {
+		parent->get_child(i)->remove_from_group("goblin_churn");
+	}
+	CHECK(tree->get_node_count_in_group("goblin_churn") == 64 - 22);
+	for (int i = 0; i < 64; i += 6) {
+		parent->get_child(i)->add_to_group("goblin_churn");
+	}
+	CHECK(tree->get_node_count_in_group("goblin_churn") == 64 - 22 + 11);
+
+	Vector<Node *> nodes = tree->get_nodes_in_group("goblin_churn");
+	CHECK(nodes.size() == 64 - 22 + 11);
+	CHECK(is_in_tree_order(nodes));
+	CHECK(tree->get_first_node_in_group("goblin_churn") == parent->get_child(0));
+	for (int i = 0; i < 64; i++) {
+		CHECK(parent->get_child(i)->is_in_group("goblin_churn") == (i % 3 != 0 || i % 6 == 0));
+	}
+
+	// Removing every member drops the group.
+	for (int i = 0; i < 64; i++) {
+		if (parent->get_child(i)->is_in_group("goblin_churn")) {
+			parent->get_child(i)->remove_from_group("goblin_churn");
+		}
+	}
+	CHECK_FALSE(tree->has_group("goblin_churn"));
+
+	// A group can be reused after it was dropped.
+	parent->get_child(5)->add_to_group("goblin_churn");
+	CHECK(tree->get_node_count_in_group("goblin_churn") == 1);
+
+	memdelete(parent);
+	CHECK_FALSE(tree->has_group("goblin_churn"));
+}
+
+TEST_CASE("[SceneTree][Goblin] Group calls reach the members left after removals") {
+	SceneTree *tree = SceneTree::get_singleton();
+	Node *parent = make_children(memnew(Node), 8);
+	tree->get_root()->add_child(parent);
+	for (int i = 0; i < 8; i++) {
+		parent->get_child(i)->add_to_group("goblin_call");
+	}
+
+	Node *removed = parent->get_child(6);
+	parent->remove_child(removed);
+	parent->get_child(2)->remove_from_group("goblin_call");
+	tree->call_group("goblin_call", "set_meta", "visited", true);
+
+	CHECK(tree->get_node_count_in_group("goblin_call") == 6);
+	CHECK_FALSE(removed->has_meta("visited"));
+	CHECK_FALSE(parent->get_child(2)->has_meta("visited"));
+	for (Node *node : tree->get_nodes_in_group("goblin_call")) {
+		CHECK(node->has_meta("visited"));
+	}
+
+	memdelete(removed);
+	memdelete(parent);
+}
+
+TEST_CASE("[SceneTree][Goblin] Group order follows late joins and moves") {
+	SceneTree *tree = SceneTree::get_singleton();
+	Node *parent = make_children(memnew(Node), 16);
+	tree->get_root()->add_child(parent);
+	for (int i = 0; i < 16; i += 2) {
+		parent->get_child(i)->add_to_group("goblin_order");
+	}
+	CHECK(is_in_tree_order(tree->get_nodes_in_group("goblin_order")));
+
+	// Joins in the middle, at the front and at the back of the sorted range.
+	parent->get_child(7)->add_to_group("goblin_order");
+	parent->get_child(15)->add_to_group("goblin_order");
+	parent->get_child(1)->add_to_group("goblin_order");
+	Vector<Node *> nodes = tree->get_nodes_in_group("goblin_order");
+	CHECK(nodes.size() == 11);
+	CHECK(is_in_tree_order(nodes));
+	CHECK(nodes[1] == parent->get_child(1));
+
+	// A spawn behind every member, and one inserted before all of them.
+	Node *last = memnew(Node);
+	parent->add_child(last);
+	last->add_to_group("goblin_order");
+	Node *first = memnew(Node);
+	parent->add_child(first);
+	parent->move_child(first, 0);
+	first->add_to_group("goblin_order");
+	nodes = tree->get_nodes_in_group("goblin_order");
+	CHECK(is_in_tree_order(nodes));
+	CHECK(nodes[0] == first);
+	CHECK(nodes[nodes.size() - 1] == last);
+
+	// Moving members reorders the group; removals keep the rest in order.
+	parent->move_child(last, 0);
+	parent->get_child(8)->remove_from_group("goblin_order");
+	nodes = tree->get_nodes_in_group("goblin_order");
+	CHECK(is_in_tree_order(nodes));
+	CHECK(nodes[0] == last);
+
+	memdelete(parent);
+}
+
+TEST_CASE("[SceneTree][Goblin] Group cursors skip members removed during the walk") {
+	SceneTree *tree = SceneTree::get_singleton();
+	Node *parent = make_children(memnew(Node), 6);
+	tree->get_root()->add_child(parent);
+	for (int i = 5; i >= 0; i--) {
+		parent->get_child(i)->add_to_group("goblin_walk");
+	}
+
+	// Tree order, without a copy.
+	Vector<Node *> walked;
+	for_each_node_in_group(tree, "goblin_walk", [&](Node *p_node) { walked.push_back(p_node); });
+	CHECK(walked.size() == 6);
+	CHECK(is_in_tree_order(walked));
+
+	// Removals during the walk are skipped, joins wait for the next walk.
+	Node *late = memnew(Node);
+	parent->add_child(late);
+	walked.clear();
+	SceneTreeGroupCursor cursor(tree, "goblin_walk");
+	while (Node *node = cursor.next()) {
+		walked.push_back(node);
+		if (node == parent->get_child(1)) {
+			parent->get_child(1)->remove_from_group("goblin_walk");
+			parent->get_child(3)->remove_from_group("goblin_walk");
+			late->add_to_group("goblin_walk");
+		}
+	}
+	CHECK(walked == Vector<Node *>({ parent->get_child(0), parent->get_child(1), parent->get_child(2), parent->get_child(4), parent->get_child(5) }));
+	CHECK(tree->get_node_count_in_group("goblin_walk") == 5);
+
+	// Members leaving another group don't concern the walk.
+	parent->get_child(0)->add_to_group("goblin_other");
+	walked.clear();
+	cursor.reset(tree, "goblin_walk");
+	while (Node *node = cursor.next()) {
+		walked.push_back(node);
+		if (walked.size() == 1) {
+			parent->get_child(0)->remove_from_group("goblin_other");
+		}
+	}
+	CHECK(walked.size() == 5);
+
+	// The group going away ends the walk.
+	walked.clear();
+	cursor.reset(tree, "goblin_walk");
+	while (Node *node = cursor.next()) {
+		walked.push_back(node);
+		for (Node *member : tree->get_nodes_in_group("goblin_walk")) {
+			member->remove_from_group("goblin_walk");
+		}
+	}
+	CHECK(walked.size() == 1);
+	CHECK_FALSE(tree->has_group("goblin_walk"));
+
+	// Script-facing iterator.
+	for (int i = 0; i < 3; i++) {
+		parent->get_child(i)->add_to_group("goblin_walk");
+	}
+	Ref<SceneTreeGroupIterator> iterator = SceneTreeGroupIterator::iterate("goblin_walk");
+	REQUIRE(iterator.is_valid());
+	walked.clear();
+	for (bool more = iterator->_iter_init(Variant()); more; more = iterator->_iter_next(Variant())) {
+		walked.push_back(iterator->_iter_get(Variant()));
+	}
+	CHECK(walked == Vector<Node *>({ parent->get_child(0), parent->get_child(1), parent->get_child(2) }));
+	CHECK_FALSE(SceneTreeGroupIterator::iterate("goblin_no_such_group")->_iter_init(Variant()));
+
+	memdelete(parent);
+}
+
+TEST_CASE("[SceneTree][Goblin] Deferred group calls reach call-time or flush-time members") {
+	SceneTree *tree = SceneTree::get_singleton();
+	Node *parent = make_children(memnew(Node), 4);
+	tree->get_root()->add_child(parent);
+	for (int i = 0; i < 3; i++) {
+		parent->get_child(i)->add_to_group("goblin_deferred");
+	}
+	Node *left = parent->get_child(1);
+	Node *freed = parent->get_child(2);
+	Node *late = parent->get_child(3);
+
+	CHECK(ClassDB::get_integer_constant("SceneTreeGroupIterator", "GROUP_CALL_DEFERRED_LIVE") == GROUP_CALL_DEFERRED_LIVE);
+	tree->call_group_flags(SceneTree::GROUP_CALL_DEFERRED, "goblin_deferred", "set_meta", "call_time", true);
+	tree->call_group_flags(SceneTree::GROUP_CALL_DEFERRED | GROUP_CALL_DEFERRED_LIVE, "goblin_deferred", "set_meta", "flush_time", true);
+	tree->set_group_flags(SceneTree::GROUP_CALL_DEFERRED | GROUP_CALL_DEFERRED_LIVE, "goblin_deferred", "editor_description", "flushed");
+	left->remove_from_group("goblin_deferred");
+	memdelete(freed);
+	late->add_to_group("goblin_deferred");
+	CHECK_FALSE(parent->get_child(0)->has_meta("call_time"));
+
+	MessageQueue::get_singleton()->flush();
+	// Members at the time of the call, skipping the freed one.
+	CHECK(parent->get_child(0)->has_meta("call_time"));
+	CHECK(left->has_meta("call_time"));
+	CHECK_FALSE(late->has_meta("call_time"));
+	// Members at flush time.
+	CHECK(parent->get_child(0)->has_meta("flush_time"));
+	CHECK_FALSE(left->has_meta("flush_time"));
+	CHECK(late->has_meta("flush_time"));
+	CHECK(late->get_editor_description() == "flushed");
+	CHECK(left->get_editor_description().is_empty());
+
+	memdelete(parent);
+}
+
+TEST_CASE("[SceneTree][Goblin] Timers fire in creation order and follow changes") {
+	SceneTree *tree = SceneTree::get_singleton();
+	TimerRecorder recorder;
+
+	Ref<SceneTreeTimer> slow = tree->create_timer(0.3);
+	Ref<SceneTreeTimer> fast = tree->create_timer(0.1);
+	Ref<SceneTreeTimer> always = tree->create_timer(0.05, true);
+	slow->connect("timeout", callable_mp(&recorder, &TimerRecorder::record).bind(0));
+	fast->connect("timeout", callable_mp(&recorder, &TimerRecorder::record).bind(1));
+	always->connect("timeout", callable_mp(&recorder, &TimerRecorder::record).bind(2));
+
+	tree->process(0.15);
+	CHECK(recorder.fired == Vector<int>({ 1, 2 }));
+	CHECK(slow->get_time_left() == doctest::Approx(0.15));
+	CHECK(fast->get_time_left() == 0.0);
+
+	// Changing the time left reschedules the timer.
+	slow->set_time_left(1.0);
+	tree->process(0.2);
+	CHECK(recorder.fired.size() == 2);
+	CHECK(slow->get_time_left() == doctest::Approx(0.8));
+
+	// Pausable timers stop while paused, the others keep running.
+	Ref<SceneTreeTimer> during_pause = tree->create_timer(0.1, true);
+	during_pause->connect("timeout", callable_mp(&recorder, &TimerRecorder::record).bind(3));
+	tree->set_pause(true);
+	tree->process(0.5);
+	tree->set_pause(false);
+	CHECK(recorder.fired == Vector<int>({ 1, 2, 3 }));
+	CHECK(slow->get_time_left() == doctest::Approx(0.8));
+
+	// Physics timers only advance on physics frames.
+	Ref<SceneTreeTimer> physics = tree->create_timer(0.1, false, true);
+	physics->connect("timeout", callable_mp(&recorder, &TimerRecorder::record).bind(4));
+	tree->process(0.2);
+	CHECK(recorder.fired.size() == 3);
+	tree->physics_process(0.2);
+	CHECK(recorder.fired == Vector<int>({ 1, 2, 3, 4 }));
+
+	tree->process(1.0);
+	CHECK(recorder.fired == Vector<int>({ 1, 2, 3, 4, 0 }));
+}
+
+TEST_CASE("[SceneTree][Goblin] Timers created by a timeout wait for the next frame") {
+	SceneTree *tree = SceneTree::get_singleton();
+	TimerRecorder recorder;
+
+	Ref<SceneTreeTimer> timer = tree->create_timer(0.1);
+	timer->connect("timeout", callable_mp(&recorder, &TimerRecorder::record_and_spawn).bind(1));
+	timer.unref();
+
+	tree->process(0.2);
+	CHECK(recorder.fired == Vector<int>({ 1 }));
+	tree->process(0.0);
+	CHECK(recorder.fired == Vector<int>({ 1, 101 }));
+
+	// Fired timers are not reused: a `timeout` signal kept past the timeout doesn't
+	// reach a newer timer.
+	Ref<SceneTreeTimer> held = tree->create_timer(0.1);
+	const Signal timeout(held.ptr(), "timeout");
+	held.unref();
+	tree->process(0.2);
+	Ref<SceneTreeTimer> next = tree->create_timer(0.5);
+	CHECK(timeout.get_object() == nullptr);
+	CHECK(next->get_instance_id() != timeout.get_object_id());
+	tree->process(0.5);
+}
+
+TEST_CASE("[SceneTree][Goblin] Timers fire on the frame their countdown reaches zero") {
+	SceneTree *tree = SceneTree::get_singleton();
+
+	// Upstream subtracts each frame's delta from the time left. Where the deltas add up
+	// to the time exactly, rounding decides the frame (0.3 at 1/60 fires on frame 19).
+	const double times[4] = { 0.1, 0.3, 0.5, 1.0 };
+	for (const double delta : { 1.0 / 60.0, 1.0 / 30.0, 0.1 }) {
+		TimerRecorder recorder;
+		Vector<int> expected;
+		for (int i = 0; i < 4; i++) {
+			double time_left = times[i];
+			int frames = 0;
+			do {
+				time_left -= delta;
+				frames++;
+			} while (time_left > 0);
+			expected.push_back(frames);
+			tree->create_timer(times[i])->connect("timeout", callable_mp(&recorder, &TimerRecorder::record).bind(i));
+		}
+
+		Vector<int> fired_on;
+		fired_on.resize(4);
+		for (int frame = 1; recorder.fired.size() < 4 && frame <= 100; frame++) {
+			const int fired = recorder.fired.size();
+			tree->process(delta);
+			for (int i = fired; i < recorder.fired.size(); i++) {
+				fired_on.write[recorder.fired[i]] = frame;
+			}
+		}
+		CHECK(fired_on == expected);
+	}
+}
+
+TEST_CASE("[SceneTree][Goblin] Timer countdowns stay exact past the delta window") {
+	SceneTree *tree = SceneTree::get_singleton();
+	const double delta = 1.0 / 60.0;
+	TimerRecorder recorder;
+
+	// The long timer keeps the queue running past the logged window, so the
+	// short one is scheduled after the ring of deltas has wrapped.
+	tree->create_timer(5.005)->connect("timeout", callable_mp(&recorder, &TimerRecorder::record).bind(0));
+	int fired_on[2] = { 0, 0 };
+	for (int frame = 1; recorder.fired.size() < 2 && frame <= 400; frame++) {
+		if (frame == 291) {
+			tree->create_timer(0.3)->connect("timeout", callable_mp(&recorder, &TimerRecorder::record).bind(1));
+		}
+		const int fired = recorder.fired.size();
+		tree->process(delta);
+		for (int i = fired; i < recorder.fired.size(); i++) {
+			fired_on[recorder.fired[i]] = frame;
+		}
+	}
+	CHECK(fired_on[0] == 301);
+	CHECK(fired_on[1] == 309); // 0.3 at 1/60 takes 19 frames, as in the test above.
+}
+
+TEST_CASE("[SceneTree][Goblin] Process cadence spreads nodes over buckets") {
+	SceneTree *tree = SceneTree::get_singleton();
+	ProcessCadence *cadence = ProcessCadence::get_singleton();
+	REQUIRE(cadence != nullptr);
+
+	Node *parent = memnew(Node);
+	tree->get_root()->add_child(parent);
+	Vector<ProcessCounter *> counters;
+	for (int i = 0; i < 6; i++) {
+		ProcessCounter *counter = memnew(ProcessCounter);
+		parent->add_child(counter);
+		counter->set_process(true);
+		cadence->set_process_cadence(counter, 3);
+		counters.push_back(counter);
+	}
+	CHECK(cadence->get_bucket_loads(3) == PackedInt32Array({ 2, 2, 2 }));
+	CHECK(cadence->get_process_cadence(counters[0]) == 3);
+
+	// Two nodes per frame; each gets the time since its previous process.
+	for (int frame = 0; frame < 6; frame++) {
+		tree->process(0.1);
+	}
+	for (ProcessCounter *counter : counters) {
+		REQUIRE(counter->deltas.size() == 2);
+		CHECK(counter->deltas[1] == doctest::Approx(0.3));
+	}
+
+	// Paused frames are not accumulated.
+	tree->set_pause(true);
+	tree->process(1.0);
+	tree->set_pause(false);
+	for (int frame = 0; frame < 3; frame++) {
+		tree->process(0.1);
+	}
+	for (ProcessCounter *counter : counters) {
+		REQUIRE(counter->deltas.size() == 3);
+		double total = 0.0;
+		for (const double delta : counter->deltas) {
+			total += delta;
+		}
+		CHECK(total <= 0.9 + CMP_EPSILON);
+	}
+
+	// Back to every frame.
+	cadence->clear_process_cadence(counters[0]);
+	tree->process(0.1);
+	CHECK(counters[0]->deltas.size() == 4);
+	CHECK(counters[0]->deltas[3] == doctest::Approx(0.1));
+	CHECK(cadence->get_bucket_loads(3).size() == 3);
+	CHECK(cadence->get_busiest_bucket_load() == 2);
+
+	// Rates are converted to frames (60 FPS until measured).
+	cadence->set_process_rate(counters[1], 20.0);
+	CHECK(cadence->get_process_rate(counters[1]) == 20.0);
+	CHECK(cadence->get_process_cadence(counters[1]) == 3);
+
+	for (ProcessCounter *counter : counters) {
+		cadence->clear_process_cadence(counter);
+	}
+	CHECK(cadence->get_busiest_bucket_load() == 0);
+	memdelete(parent);
+}
+
+TEST_CASE("[SceneTree][Goblin] Processing follows inherited process modes") {
+	SceneTree *tree = SceneTree::get_singleton();
+
+	// pausable -> { inherit, always -> { inherit }, disabled -> { inherit }, when paused }
+	Node *parent = memnew(Node);
+	ProcessCounter *inherit = memnew(ProcessCounter);
+	Node *always = memnew(Node);
+	ProcessCounter *always_child = memnew(ProcessCounter);
+	Node *disabled = memnew(Node);
+	ProcessCounter *disabled_child = memnew(ProcessCounter);
+	ProcessCounter *when_paused = memnew(ProcessCounter);
+	tree->get_root()->add_child(parent);
+	parent->add_child(inherit);
+	parent->add_child(always);
+	always->add_child(always_child);
+	parent->add_child(disabled);
+	disabled->add_child(disabled_child);
+	parent->add_child(when_paused);
+
+	parent->set_process_mode(Node::PROCESS_MODE_PAUSABLE);
+	always->set_process_mode(Node::PROCESS_MODE_ALWAYS);
+	disabled->set_process_mode(Node::PROCESS_MODE_DISABLED);
+	when_paused->set_process_mode(Node::PROCESS_MODE_WHEN_PAUSED);
+	for (ProcessCounter *counter : { inherit, always_child, disabled_child, when_paused }) {
+		counter->set_process(true);
+	}
+
+	tree->process(0.1);
+	CHECK(inherit->deltas.size() == 1);
+	CHECK(always_child->deltas.size() == 1);
+	CHECK(disabled_child->deltas.is_empty());
+	CHECK(when_paused->deltas.is_empty());
+
+	tree->set_pause(true);
+	tree->process(0.1);
+	tree->set_pause(false);
+	CHECK(inherit->deltas.size() == 1);
+	CHECK(always_child->deltas.size() == 2);
+	CHECK(when_paused->deltas.size() == 1);
+
+	// Mode changes on a subtree root apply to the nodes inheriting from it.
+	disabled->set_process_mode(Node::PROCESS_MODE_INHERIT);
+	always->set_process_mode(Node::PROCESS_MODE_DISABLED);
+	tree->process(0.1);
+	CHECK(disabled_child->deltas.size() == 1);
+	CHECK(always_child->deltas.size() == 2);
+
+	// Suspended trees process nothing.
+	tree->set_suspend(true);
+	tree->process(0.1);
+	tree->set_suspend(false);
+	CHECK(inherit->deltas.size() == 2);
+	CHECK(disabled_child->deltas.size() == 1);
+
+	memdelete(parent);
+}
+
+TEST_CASE("[SceneTree][Goblin] Split and overlapped thread groups process every node once") {
+	SceneTree *tree = SceneTree::get_singleton();
+	ProcessGroupScheduler *scheduler = ProcessGroupScheduler::get_singleton();
+	REQUIRE(scheduler != nullptr);
+	scheduler->set_overlap_main_thread(true);
+	scheduler->set_split_threshold(16);
+
+	Node *parent = memnew(Node);
+	tree->get_root()->add_child(parent);
+	Vector<ProcessCounter *> counters;
+	for (int g = 0; g < 3; g++) {
+		Node *group = memnew(Node);
+		group->set_process_thread_group(g < 2 ? Node::PROCESS_THREAD_GROUP_SUB_THREAD : Node::PROCESS_THREAD_GROUP_MAIN_THREAD);
+		parent->add_child(group);
+		// One large group (split), one small one, one on the main thread.
+		const int count = g == 0 ? 100 : 10;
+		for (int i = 0; i < count; i++) {
+			ProcessCounter *counter = memnew(ProcessCounter);
+			group->add_child(counter);
+			counter->set_process(true);
+			counters.push_back(counter);
+		}
+	}
+
+	for (int frame = 0; frame < 3; frame++) {
+		tree->process(0.1);
+	}
+	for (ProcessCounter *counter : counters) {
+		CHECK(counter->deltas.size() == 3);
+	}
+
+	const TypedArray<Dictionary> timings = scheduler->get_group_timings();
+	int threaded = 0;
+	for (int i = 0; i < timings.size(); i++) {
+		const Dictionary timing = timings[i];
+		const Node *owner = Object::cast_to<Node>(timing["owner"]);
+		if (owner == parent->get_child(0)) {
+			CHECK(int(timing["nodes"]) == 100);
+			CHECK(int(timing["tasks"]) == 7);
+		}
+		threaded += bool(timing["threaded"]);
+	}
+	CHECK(threaded == 2);
+
+	scheduler->set_overlap_main_thread(false);
+	scheduler->set_split_threshold(0);
+	memdelete(parent);
+}
+
+TEST_CASE("[SceneTree][Goblin] Overlapped main-thread groups don't change sub-thread groups under the workers") {
+	SceneTree *tree = SceneTree::get_singleton();
+	ProcessGroupScheduler *scheduler = ProcessGroupScheduler::get_singleton();
+	ProcessCadence *cadence = ProcessCadence::get_singleton();
+	REQUIRE(scheduler != nullptr);
+	REQUIRE(cadence != nullptr);
+	scheduler->set_overlap_main_thread(true);
+	scheduler->set_split_threshold(16);
+
+	Node *parent = memnew(Node);
+	tree->get_root()->add_child(parent);
+	ProcessToggler *toggler = memnew(ProcessToggler);
+	Vector<ProcessCounter *> stopped;
+	Vector<ProcessCounter *> started;
+	for (int g = 0; g < 2; g++) {
+		Node *group = memnew(Node);
+		group->set_process_thread_group(Node::PROCESS_THREAD_GROUP_SUB_THREAD);
+		parent->add_child(group);
+		// A split group and a whole one.
+		const int count = g == 0 ? 100 : 10;
+		for (int i = 0; i < count; i++) {
+			ProcessCounter *counter = memnew(ProcessCounter);
+			group->add_child(counter);
+			counter->set_process(i > 0);
+		}
+		stopped.push_back(Object::cast_to<ProcessCounter>(group->get_child(1)));
+		started.push_back(Object::cast_to<ProcessCounter>(group->get_child(0)));
+		toggler->stopped.push_back(stopped[g]);
+		toggler->started.push_back(started[g]);
+	}
+	Node *main_group = memnew(Node);
+	main_group->set_process_thread_group(Node::PROCESS_THREAD_GROUP_MAIN_THREAD);
+	parent->add_child(main_group);
+	ProcessCounter *cadenced = memnew(ProcessCounter);
+	main_group->add_child(cadenced);
+	cadenced->set_process(true);
+	cadence->set_process_cadence(cadenced, 3);
+	main_group->add_child(toggler);
+	toggler->set_process(true);
+
+	for (int frame = 0; frame < 3; frame++) {
+		tree->process(0.1);
+	}
+
+	// The toggles on the second frame wait for that frame's workers.
+	for (int g = 0; g < 2; g++) {
+		CHECK(stopped[g]->deltas.size() == 2);
+		CHECK(started[g]->deltas.size() == 1);
+	}
+	// `process_time` is shared with the workers, so cadences are off while they run.
+	CHECK(cadenced->deltas == Vector<double>({ 0.1, 0.1, 0.1 }));
+
+	cadence->clear_process_cadence(cadenced);
+	scheduler->set_overlap_main_thread(false);
+	scheduler->set_split_threshold(0);
+	memdelete(parent);
+}
+
+TEST_CASE("[SceneTree][Goblin][Benchmark] Group churn" * doctest::skip()) {
+	const int MEMBERS = 5000;
+	const int CHURN = 20000;
+	const int NOTIFICATION_PING = 100000; // Not handled by any node.
+
+	SceneTree *tree = SceneTree::get_singleton();
+	Node *parent = make_children(memnew(Node), MEMBERS);
+	tree->get_root()->add_child(parent);
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < MEMBERS; i++) {
+		parent->get_child(i)->add_to_group("goblin_enemies");
+	}
+	const uint64_t join_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	// Spawn/despawn pattern: members leave and rejoin at scattered positions, with a
+	// group call every 100 changes.
+	uint32_t seed = 1;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < CHURN; i++) {
+		seed = seed * 1664525u + 1013904223u;
+		Node *node = parent->get_child((seed >> 8) % MEMBERS);
+		if (node->is_in_group("goblin_enemies")) {
+			node->remove_from_group("goblin_enemies");
+		} else {
+			node->add_to_group("goblin_enemies");
+		}
+		if (i % 100 == 0) {
+			tree->notify_group("goblin_enemies", NOTIFICATION_PING);
+		}
+	}
+	const uint64_t churn_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	MESSAGE(vformat("%d members joined in %.3f ms; %d joins/leaves with a group call every 100 in %.3f ms.", MEMBERS, join_usec / 1000.0, CHURN, churn_usec / 1000.0));
+	CHECK(is_in_tree_order(tree->get_nodes_in_group("goblin_enemies")));
+
+	memdelete(parent);
+}
+
+} // namespace TestGoblinSceneTree
@@ -0,0 +1,192 @@
+/**************************************************************************/
+/*  test_spatial_group_index.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                            GOBLIN ENGINE                               */
+/**************************************************************************/
+
+#pragma once
+
+#include "modules/goblin/spatial_group_index.h"
+
+#include "core/math/random_pcg.h"
+#include "scene/3d/node_3d.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/window.h"
+
+#include "tests/test_macros.h"
+
+// Spatially indexed groups (M-25): queries checked against a filter over
+// `get_nodes_in_group()`. Headless, no server involved.
+namespace TestGoblinSpatialGroupIndex {
+
+static Node3D *make_members(Node *p_parent, const StringName &p_group, int p_count, RandomPCG &r_rng) {
+	Node3D *parent = memnew(Node3D);
+	p_parent->add_child(parent);
+	for (int i = 0; i < p_count; i++) {
+		Node3D *member = memnew(Node3D);
+		member->set_position(Vector3(r_rng.randf_range(-50, 50), r_rng.randf_range(-50, 50), r_rng.randf_range(-50, 50)));
+		parent->add_child(member);
+		member->add_to_group(p_group);
+	}
+	return parent;
+}
+
+static Vector<Node3D *> filter_radius(const StringName &p_group, const Vector3 &p_center, real_t p_radius) {
+	Vector<Node3D *> nodes;
+	for (Node *node : SceneTree::get_singleton()->get_nodes_in_group(p_group)) {
+		Node3D *node_3d = Object::cast_to<Node3D>(node);
+		if (node_3d != nullptr && node_3d->get_global_position().distance_to(p_center) <= p_radius) {
+			nodes.push_back(node_3d);
+		}
+	}
+	nodes.sort();
+	return nodes;
+}
+
+static Vector<Node3D *> sorted(const LocalVector<Node3D *> &p_nodes) {
+	Vector<Node3D *> nodes;
+	for (Node3D *node : p_nodes) {
+		nodes.push_back(node);
+	}
+	nodes.sort();
+	return nodes;
+}
+
+TEST_CASE("[SceneTree][Goblin] Spatial group queries match a filter over the group") {
+	SceneTree *tree = SceneTree::get_singleton();
+	SpatialGroupIndex *index = SpatialGroupIndex::get_singleton();
+	REQUIRE(index != nullptr);
+
+	RandomPCG rng(7);
+	Node3D *early = make_members(tree->get_root(), "goblin_spatial", 200, rng);
+	index->enable_group("goblin_spatial", 10.0);
+	Node3D *late = make_members(tree->get_root(), "goblin_spatial", 200, rng);
+	Node *plain = memnew(Node);
+	late->add_child(plain);
+	plain->add_to_group("goblin_spatial");
+	CHECK(index->get_indexed_count("goblin_spatial") == 400);
+	CHECK(Object::cast_to<Node3D>(late->get_child(0))->is_transform_notification_enabled());
+
+	// Radius and AABB, including queries wider than the grid.
+	LocalVector<Node3D *> nodes;
+	for (const real_t radius : { 0.0, 5.0, 12.0, 40.0, 500.0 }) {
+		const Vector3 center(rng.randf_range(-40, 40), rng.randf_range(-40, 40), rng.randf_range(-40, 40));
+		nodes.clear();
+		index->query_radius("goblin_spatial", center, radius, nodes);
+		CHECK(sorted(nodes) == filter_radius("goblin_spatial", center, radius));
+	}
+	const AABB aabb(Vector3(-20, -10, -30), Vector3(25, 30, 20));
+	nodes.clear();
+	index->query_aabb("goblin_spatial", aabb, nodes);
+	LocalVector<Node3D *> expected;
+	for (Node *node : tree->get_nodes_in_group("goblin_spatial")) {
+		Node3D *node_3d = Object::cast_to<Node3D>(node);
+		if (node_3d != nullptr && aabb.has_point(node_3d->get_global_position())) {
+			expected.push_back(node_3d);
+		}
+	}
+	CHECK(sorted(nodes) == sorted(expected));
+
+	// Nearest members, closest first.
+	const Vector3 point(3, -7, 11);
+	nodes.clear();
+	index->query_nearest("goblin_spatial", point, 8, Math::INF, nodes);
+	REQUIRE(nodes.size() == 8);
+	const Vector<Node3D *> within = filter_radius("goblin_spatial", point, nodes[7]->get_global_position().distance_to(point));
+	CHECK(within.size() == 8);
+	for (uint32_t i = 1; i < nodes.size(); i++) {
+		CHECK(nodes[i - 1]->get_global_position().distance_to(point) <= nodes[i]->get_global_position().distance_to(point));
+	}
+	nodes.clear();
+	index->query_nearest("goblin_spatial", point, 8, 0.5, nodes);
+	CHECK(sorted(nodes) == filter_radius("goblin_spatial", point, 0.5));
+
+	// Moves (of a member, and of a parent) are picked up after the transform flush.
+	Node3D *moved = Object::cast_to<Node3D>(early->get_child(0));
+	moved->set_position(Vector3(500, 500, 500));
+	late->set_position(Vector3(0, 200, 0));
+	tree->flush_transform_notifications();
+	nodes.clear();
+	index->query_nearest("goblin_spatial", Vector3(499, 499, 499), 1, Math::INF, nodes);
+	REQUIRE(nodes.size() == 1);
+	CHECK(nodes[0] == moved);
+	nodes.clear();
+	index->query_radius("goblin_spatial", Vector3(0, 200, 0), 90.0, nodes);
+	CHECK(sorted(nodes) == filter_radius("goblin_spatial", Vector3(0, 200, 0), 90.0));
+	CHECK(nodes.size() == 200);
+
+	// Leaving the group, or the tree.
+	moved->remove_from_group("goblin_spatial");
+	CHECK_FALSE(moved->is_transform_notification_enabled());
+	memdelete(late);
+	CHECK(index->get_indexed_count("goblin_spatial") == 199);
+	nodes.clear();
+	index->query_radius("goblin_spatial", Vector3(), 1000.0, nodes);
+	CHECK(nodes.size() == 199);
+
+	index->disable_group("goblin_spatial");
+	CHECK_FALSE(index->is_group_enabled("goblin_spatial"));
+	CHECK_FALSE(Object::cast_to<Node3D>(early->get_child(1))->is_transform_notification_enabled());
+	memdelete(early);
+}
+
+TEST_CASE("[SceneTree][Goblin] Members of two indexed groups keep their transform notifications") {
+	SceneTree *tree = SceneTree::get_singleton();
+	SpatialGroupIndex *index = SpatialGroupIndex::get_singleton();
+	index->enable_group("goblin_spatial_a", 10.0);
+	index->enable_group("goblin_spatial_b", 10.0);
+
+	Node3D *shared = memnew(Node3D);
+	tree->get_root()->add_child(shared);
+	shared->add_to_group("goblin_spatial_a");
+	shared->add_to_group("goblin_spatial_b");
+	CHECK(shared->is_transform_notification_enabled());
+
+	// Leaving one group leaves the other index following the node.
+	shared->remove_from_group("goblin_spatial_a");
+	CHECK(shared->is_transform_notification_enabled());
+	shared->set_position(Vector3(40, 0, 0));
+	tree->flush_transform_notifications();
+	LocalVector<Node3D *> nodes;
+	index->query_radius("goblin_spatial_b", Vector3(40, 0, 0), 1.0, nodes);
+	CHECK(nodes.size() == 1);
+	shared->remove_from_group("goblin_spatial_b");
+	CHECK_FALSE(shared->is_transform_notification_enabled());
+
+	// Also when the group is disabled rather than left.
+	shared->add_to_group("goblin_spatial_a");
+	shared->add_to_group("goblin_spatial_b");
+	index->disable_group("goblin_spatial_a");
+	CHECK(shared->is_transform_notification_enabled());
+	index->disable_group("goblin_spatial_b");
+	CHECK_FALSE(shared->is_transform_notification_enabled());
+
+	// Notifications turned on before indexing aren't the index's to turn off.
+	Node3D *notified = memnew(Node3D);
+	notified->set_notify_transform(true);
+	tree->get_root()->add_child(notified);
+	index->enable_group("goblin_spatial_a", 10.0);
+	notified->add_to_group("goblin_spatial_a");
+	notified->remove_from_group("goblin_spatial_a");
+	CHECK(notified->is_transform_notification_enabled());
+
+	// Infinite and huge ranges cover everything.
+	notified->add_to_group("goblin_spatial_a");
+	shared->add_to_group("goblin_spatial_a");
+	nodes.clear();
+	index->query_radius("goblin_spatial_a", Vector3(), Math::INF, nodes);
+	CHECK(nodes.size() == 2);
+	nodes.clear();
+	index->query_radius("goblin_spatial_a", Vector3(1e30, 0, 0), 1e31, nodes);
+	CHECK(nodes.size() == 2);
+	nodes.clear();
+	index->query_aabb("goblin_spatial_a", AABB(Vector3(-1e30, -1e30, -1e30), Vector3(2e30, 2e30, 2e30)), nodes);
+	CHECK(nodes.size() == 2);
+
+	index->disable_group("goblin_spatial_a");
+	memdelete(notified);
+	memdelete(shared);
+}
+
+} // namespace TestGoblinSpatialGroupIndex
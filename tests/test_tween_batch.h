@@ -0,0 +1,161 @@
+/**************************************************************************/
+/*  test_tween_batch.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                            GOBLIN ENGINE                               */
+/**************************************************************************/
+
+#pragma once
+
+#include "modules/goblin/tween_batch.h"
+
+#include "scene/2d/node_2d.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/window.h"
+
+#include "tests/test_macros.h"
+
+// Batched tweens (M-19), stepped through `SceneTree::process()`.
+namespace TestGoblinTweenBatch {
+
+class FinishRecorder : public Object {
+public:
+	Vector<int> finished;
+
+	void record(int p_id) { finished.push_back(p_id); }
+};
+
+// Its `speed` getter starts more batched tweens once `spawn` is set, as a script getter could.
+class SpawningGetter : public Object {
+	GDCLASS(SpawningGetter, Object);
+
+	double speed = 0.0;
+	double other = 0.0;
+
+protected:
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("set_speed", "speed"), &SpawningGetter::set_speed);
+		ClassDB::bind_method(D_METHOD("get_speed"), &SpawningGetter::get_speed);
+		ClassDB::bind_method(D_METHOD("set_other", "other"), &SpawningGetter::set_other);
+		ClassDB::bind_method(D_METHOD("get_other"), &SpawningGetter::get_other);
+		ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "speed"), "set_speed", "get_speed");
+		ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "other"), "set_other", "get_other");
+	}
+
+public:
+	int spawn = 0;
+
+	void set_speed(double p_speed) { speed = p_speed; }
+	double get_speed() {
+		for (; spawn > 0; spawn--) {
+			TweenBatch::get_singleton()->tween_property(this, "other", 1.0, 1.0);
+		}
+		return speed;
+	}
+	void set_other(double p_other) { other = p_other; }
+	double get_other() const { return other; }
+};
+
+TEST_CASE("[SceneTree][Goblin] Batched tweens reach their final values") {
+	SceneTree *tree = SceneTree::get_singleton();
+	TweenBatch *batch = TweenBatch::get_singleton();
+	REQUIRE(batch != nullptr);
+
+	Node2D *node = memnew(Node2D);
+	tree->get_root()->add_child(node);
+	FinishRecorder recorder;
+	batch->connect("finished", callable_mp(&recorder, &FinishRecorder::record));
+
+	const int move = batch->tween_property(node, "position", Vector2(100, 50), 1.0);
+	const int fade = batch->tween_property(node, "modulate:a", 0.0, 0.5, Tween::TRANS_SINE, Tween::EASE_OUT, 0.25);
+	REQUIRE(move != 0);
+	REQUIRE(fade != 0);
+	CHECK(batch->get_running_count() == 2);
+
+	tree->process(0.5);
+	CHECK(node->get_position().is_equal_approx(Vector2(50, 25)));
+	CHECK(node->get_modulate().a < 1.0);
+	CHECK(node->get_modulate().a > 0.0);
+
+	tree->process(0.25);
+	CHECK(node->get_modulate().a == doctest::Approx(0.0));
+	CHECK(recorder.finished == Vector<int>({ fade }));
+
+	tree->process(0.5);
+	CHECK(node->get_position().is_equal_approx(Vector2(100, 50)));
+	CHECK(recorder.finished == Vector<int>({ fade, move }));
+	CHECK_FALSE(batch->is_running(move));
+	CHECK(batch->get_running_count() == 0);
+
+	batch->disconnect("finished", callable_mp(&recorder, &FinishRecorder::record));
+	memdelete(node);
+}
+
+TEST_CASE("[SceneTree][Goblin] Batched tweens stop when killed or when the object is freed") {
+	SceneTree *tree = SceneTree::get_singleton();
+	TweenBatch *batch = TweenBatch::get_singleton();
+	REQUIRE(batch != nullptr);
+
+	Node2D *kept = memnew(Node2D);
+	Node2D *freed = memnew(Node2D);
+	tree->get_root()->add_child(kept);
+	tree->get_root()->add_child(freed);
+	FinishRecorder recorder;
+	batch->connect("finished", callable_mp(&recorder, &FinishRecorder::record));
+
+	const int killed = batch->tween_property(kept, "rotation", 1.0, 1.0);
+	const int scale = batch->tween_property(kept, "scale", Vector2(2, 2), 1.0);
+	batch->tween_property(freed, "position", Vector2(10, 10), 1.0);
+	tree->process(0.5);
+	batch->kill(killed);
+	memdelete(freed);
+
+	const real_t rotation = kept->get_rotation();
+	tree->process(1.0);
+	CHECK(kept->get_rotation() == rotation);
+	CHECK(kept->get_scale().is_equal_approx(Vector2(2, 2)));
+	CHECK(recorder.finished == Vector<int>({ scale }));
+	CHECK(batch->get_running_count() == 0);
+
+	// Paused trees hold tweens bound to pausable nodes.
+	batch->tween_property(kept, "rotation", 0.0, 1.0);
+	tree->set_pause(true);
+	tree->process(1.0);
+	tree->set_pause(false);
+	CHECK(kept->get_rotation() == rotation);
+	batch->kill_object(kept);
+	CHECK(batch->get_running_count() == 0);
+
+	// Only the supported value types are batched.
+	ERR_PRINT_OFF;
+	CHECK(batch->tween_property(kept, "name", "Renamed", 1.0) == 0);
+	ERR_PRINT_ON;
+
+	batch->disconnect("finished", callable_mp(&recorder, &FinishRecorder::record));
+	memdelete(kept);
+}
+
+TEST_CASE("[SceneTree][Goblin] Batched tweens started from a getter wait for the next frame") {
+	GDREGISTER_CLASS(SpawningGetter);
+	SceneTree *tree = SceneTree::get_singleton();
+	TweenBatch *batch = TweenBatch::get_singleton();
+	REQUIRE(batch != nullptr);
+
+	// The getter runs when the first tween starts, and grows the lanes under it.
+	SpawningGetter *object = memnew(SpawningGetter);
+	batch->tween_property(object, "speed", 10.0, 1.0);
+	object->spawn = 64;
+	tree->process(0.5);
+	CHECK(object->get_speed() == doctest::Approx(5.0));
+	CHECK(object->get_other() == 0.0);
+	CHECK(batch->get_running_count() == 65);
+
+	tree->process(1.0);
+	CHECK(object->get_speed() == doctest::Approx(10.0));
+	CHECK(object->get_other() == doctest::Approx(1.0));
+	CHECK(batch->get_running_count() == 0);
+
+	memdelete(object);
+}
+
+} // namespace TestGoblinTweenBatch
@@ -0,0 +1,389 @@
+/**************************************************************************/
+/*  tween_batch.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                            GOBLIN ENGINE                               */
+/**************************************************************************/
+
+#include "tween_batch.h"
+
+#include "core/object/class_db.h"
+#include "core/object/method_bind.h"
+#include "core/object/script_language.h"
+#include "scene/main/node.h"
+
+bool TweenBatch::_is_batchable_type(Variant::Type p_type) {
+	return p_type == Variant::FLOAT || p_type == Variant::VECTOR2 || p_type == Variant::VECTOR3 || p_type == Variant::COLOR;
+}
+
+void TweenBatch::_split(const Variant &p_value, double r_components[COMPONENTS]) {
+	r_components[0] = r_components[1] = r_components[2] = r_components[3] = 0.0;
+	switch (p_value.get_type()) {
+		case Variant::FLOAT: {
+			r_components[0] = p_value;
+		} break;
+		case Variant::VECTOR2: {
+			const Vector2 v = p_value;
+			r_components[0] = v.x;
+			r_components[1] = v.y;
+		} break;
+		case Variant::VECTOR3: {
+			const Vector3 v = p_value;
+			r_components[0] = v.x;
+			r_components[1] = v.y;
+			r_components[2] = v.z;
+		} break;
+		case Variant::COLOR: {
+			const Color c = p_value;
+			r_components[0] = c.r;
+			r_components[1] = c.g;
+			r_components[2] = c.b;
+			r_components[3] = c.a;
+		} break;
+		default:
+			break;
+	}
+}
+
+Variant TweenBatch::_join(Variant::Type p_type, const double p_components[COMPONENTS]) {
+	switch (p_type) {
+		case Variant::FLOAT:
+			return p_components[0];
+		case Variant::VECTOR2:
+			return Vector2(p_components[0], p_components[1]);
+		case Variant::VECTOR3:
+			return Vector3(p_components[0], p_components[1], p_components[2]);
+		case Variant::COLOR:
+			return Color(p_components[0], p_components[1], p_components[2], p_components[3]);
+		default:
+			return Variant();
+	}
+}
+
+// The setter `Object::set()` would reach through `ClassDB::set_property()`. Null when the
+// script, an indexed property or `_set()` has to handle the name.
+MethodBind *TweenBatch::_find_setter(Object *p_object, const StringName &p_property) {
+	ScriptInstance *script_instance = p_object->get_script_instance();
+	if (script_instance != nullptr) {
+		bool script_property = false;
+		script_instance->get_property_type(p_property, &script_property);
+		if (script_property) {
+			return nullptr;
+		}
+	}
+
+	const StringName class_name = p_object->get_class_name();
+	bool valid = false;
+	if (ClassDB::get_property_index(class_name, p_property, &valid) != -1 || !valid) {
+		return nullptr;
+	}
+	const StringName setter = ClassDB::get_property_setter(class_name, p_property);
+	return setter == StringName() ? nullptr : ClassDB::get_method(class_name, setter);
+}
+
+int TweenBatch::tween_property(Object *p_object, const NodePath &p_property, const Variant &p_final_value, double p_duration, Tween::TransitionType p_trans, Tween::EaseType p_ease, double p_delay) {
+	ERR_FAIL_NULL_V(p_object, 0);
+	ERR_FAIL_COND_V_MSG(!_is_batchable_type(p_final_value.get_type()), 0, "TweenBatch only animates float, Vector2, Vector3 and Color values; use a Tween for " + Variant::get_type_name(p_final_value.get_type()) + ".");
+	ERR_FAIL_COND_V_MSG(p_duration < 0 || p_delay < 0, 0, "Tween duration and delay can't be negative.");
+
+	const NodePath property = p_property.get_as_property_path();
+	bool valid = false;
+	const Variant current = p_object->get_indexed(property.get_subnames(), &valid);
+	ERR_FAIL_COND_V_MSG(!valid, 0, vformat("The tweened property \"%s\" does not exist in object \"%s\".", p_property, p_object));
+	ERR_FAIL_COND_V_MSG(current.get_type() != p_final_value.get_type(), 0, vformat("Type mismatch between property \"%s\" (%s) and final value (%s).", p_property, Variant::get_type_name(current.get_type()), Variant::get_type_name(p_final_value.get_type())));
+
+	const uint32_t id = next_id++;
+	const uint32_t lane = ids.size();
+	slots.insert(id, lane);
+
+	Target target;
+	target.object = p_object->get_instance_id();
+	target.property = property;
+	target.setter = property.get_subname_count() == 1 ? _find_setter(p_object, property.get_subname(0)) : nullptr;
+	target.type = p_final_value.get_type();
+
+	double final_components[COMPONENTS];
+	_split(p_final_value, final_components);
+
+	ids.push_back(id);
+	targets.push_back(target);
+	elapsed.push_back(0.0);
+	delays.push_back(p_delay);
+	durations.push_back(p_duration);
+	transitions.push_back(p_trans);
+	eases.push_back(p_ease);
+	active.push_back(0);
+	weights.push_back(0.0);
+	for (int c = 0; c < COMPONENTS; c++) {
+		from[c].push_back(0.0);
+		change[c].push_back(final_components[c]);
+		values[c].push_back(0.0);
+	}
+	return id;
+}
+
+TweenBatch::Target *TweenBatch::_get_target(int p_id) {
+	const uint32_t *lane = slots.getptr(p_id);
+	return lane != nullptr ? &targets[*lane] : nullptr;
+}
+
+void TweenBatch::set_process_mode(int p_id, Tween::TweenProcessMode p_mode) {
+	Target *target = _get_target(p_id);
+	ERR_FAIL_NULL_MSG(target, vformat("No running batched tween with id %d.", p_id));
+	target->process_mode = p_mode;
+}
+
+void TweenBatch::set_pause_mode(int p_id, Tween::TweenPauseMode p_mode) {
+	Target *target = _get_target(p_id);
+	ERR_FAIL_NULL_MSG(target, vformat("No running batched tween with id %d.", p_id));
+	target->pause_mode = p_mode;
+}
+
+void TweenBatch::set_ignore_time_scale(int p_id, bool p_ignore) {
+	Target *target = _get_target(p_id);
+	ERR_FAIL_NULL_MSG(target, vformat("No running batched tween with id %d.", p_id));
+	target->ignore_time_scale = p_ignore;
+}
+
+void TweenBatch::_remove_lane(uint32_t p_lane) {
+	const uint32_t last = ids.size() - 1;
+	slots.erase(ids[p_lane]);
+	if (p_lane != last) {
+		ids[p_lane] = ids[last];
+		targets[p_lane] = targets[last];
+		elapsed[p_lane] = elapsed[last];
+		delays[p_lane] = delays[last];
+		durations[p_lane] = durations[last];
+		transitions[p_lane] = transitions[last];
+		eases[p_lane] = eases[last];
+		active[p_lane] = active[last];
+		weights[p_lane] = weights[last];
+		for (int c = 0; c < COMPONENTS; c++) {
+			from[c][p_lane] = from[c][last];
+			change[c][p_lane] = change[c][last];
+			values[c][p_lane] = values[c][last];
+		}
+		slots[ids[p_lane]] = p_lane;
+	}
+
+	ids.resize(last);
+	targets.resize(last);
+	elapsed.resize(last);
+	delays.resize(last);
+	durations.resize(last);
+	transitions.resize(last);
+	eases.resize(last);
+	active.resize(last);
+	weights.resize(last);
+	for (int c = 0; c < COMPONENTS; c++) {
+		from[c].resize(last);
+		change[c].resize(last);
+		values[c].resize(last);
+	}
+}
+
+void TweenBatch::kill(int p_id) {
+	const uint32_t *lane = slots.getptr(p_id);
+	if (lane == nullptr) {
+		return;
+	}
+	if (processing) {
+		targets[*lane].object = ObjectID(); // Dropped at the end of the pass.
+		return;
+	}
+	_remove_lane(*lane);
+}
+
+void TweenBatch::kill_object(Object *p_object) {
+	ERR_FAIL_NULL(p_object);
+	const ObjectID object = p_object->get_instance_id();
+	for (uint32_t lane = 0; lane < ids.size();) {
+		if (targets[lane].object != object) {
+			lane++;
+		} else if (processing) {
+			targets[lane++].object = ObjectID();
+		} else {
+			_remove_lane(lane);
+		}
+	}
+}
+
+bool TweenBatch::is_running(int p_id) const {
+	const uint32_t *lane = slots.getptr(p_id);
+	return lane != nullptr && targets[*lane].object.is_valid();
+}
+
+int TweenBatch::get_running_count() const {
+	return ids.size();
+}
+
+// Like `PropertyTweener`, the tween starts from the value the property has once the
+// delay is over. The getter may run script that adds tweens, which moves `targets`.
+bool TweenBatch::_start_lane(uint32_t p_lane, Object *p_object) {
+	const NodePath property = targets[p_lane].property;
+	bool valid = false;
+	const Variant current = p_object->get_indexed(property.get_subnames(), &valid);
+	ERR_FAIL_COND_V_MSG(!valid || current.get_type() != targets[p_lane].type, false, vformat("The tweened property \"%s\" is gone or changed type.", property));
+
+	double components[COMPONENTS];
+	_split(current, components);
+	for (int c = 0; c < COMPONENTS; c++) {
+		from[c][p_lane] = components[c];
+		change[c][p_lane] -= components[c];
+	}
+	targets[p_lane].started = true;
+	return true;
+}
+
+// Nothing of `targets` is used once the setter runs, since it may add tweens.
+void TweenBatch::_write_lane(uint32_t p_lane, Object *p_object) {
+	const Target &target = targets[p_lane];
+	double components[COMPONENTS];
+	for (int c = 0; c < COMPONENTS; c++) {
+		components[c] = values[c][p_lane];
+	}
+	const Variant value = _join(target.type, components);
+
+	if (target.setter != nullptr) {
+		MethodBind *setter = target.setter;
+		const Variant *args[1] = { &value };
+		Callable::CallError ce;
+		setter->call(p_object, args, 1, ce);
+	} else {
+		const Vector<StringName> subnames = target.property.get_subnames();
+		p_object->set_indexed(subnames, value);
+	}
+}
+
+void TweenBatch::process(double p_delta, double p_unscaled_delta, bool p_physics, bool p_tree_paused) {
+	const uint32_t count = ids.size();
+	if (count == 0) {
+		return;
+	}
+
+	// Setters and `finished` handlers may kill tweens or add new ones. Kills only
+	// invalidate the lane until the pass is over; new lanes wait for the next frame.
+	processing = true;
+
+	// Clocks. Tweens of freed objects, or whose property went away, are dropped.
+	uint32_t active_count = 0;
+	for (uint32_t lane = 0; lane < count; lane++) {
+		Target &target = targets[lane];
+		active[lane] = 0;
+		if ((target.process_mode == Tween::TWEEN_PROCESS_PHYSICS) != p_physics) {
+			continue;
+		}
+		Object *object = ObjectDB::get_instance(target.object);
+		if (object == nullptr) {
+			target.object = ObjectID();
+			continue;
+		}
+		bool can_process = !p_tree_paused || target.pause_mode == Tween::TWEEN_PAUSE_PROCESS;
+		if (target.pause_mode == Tween::TWEEN_PAUSE_BOUND) {
+			const Node *node = Object::cast_to<Node>(object);
+			if (node != nullptr) {
+				can_process = node->is_inside_tree() && node->can_process();
+			}
+		}
+		if (!can_process) {
+			continue;
+		}
+
+		elapsed[lane] += target.ignore_time_scale ? p_unscaled_delta : p_delta;
+		if (elapsed[lane] < delays[lane]) {
+			continue;
+		}
+		if (!target.started && !_start_lane(lane, object)) {
+			targets[lane].object = ObjectID(); // `target` may have moved.
+			continue;
+		}
+		active[lane] = 1;
+		active_count++;
+	}
+
+	if (active_count > 0) {
+		// Eased progress, then every component of every active lane in flat passes.
+		for (uint32_t lane = 0; lane < count; lane++) {
+			if (!active[lane]) {
+				continue;
+			}
+			const double time = elapsed[lane] - delays[lane];
+			if (time >= durations[lane]) {
+				weights[lane] = 1.0;
+			} else {
+				weights[lane] = Tween::run_equation((Tween::TransitionType)transitions[lane], (Tween::EaseType)eases[lane], time, 0.0, 1.0, durations[lane]);
+			}
+		}
+		for (int c = 0; c < COMPONENTS; c++) {
+			const double *lane_from = from[c].ptr();
+			const double *lane_change = change[c].ptr();
+			const double *lane_weight = weights.ptr();
+			double *lane_value = values[c].ptr();
+			for (uint32_t lane = 0; lane < count; lane++) {
+				lane_value[lane] = lane_from[lane] + lane_change[lane] * lane_weight[lane];
+			}
+		}
+	}
+
+	LocalVector<uint32_t> finished;
+	for (uint32_t lane = 0; lane < count; lane++) {
+		if (!active[lane]) {
+			continue;
+		}
+		Object *object = ObjectDB::get_instance(targets[lane].object);
+		if (object == nullptr) {
+			targets[lane].object = ObjectID(); // Killed or freed by an earlier setter.
+			continue;
+		}
+		_write_lane(lane, object);
+		if (elapsed[lane] - delays[lane] >= durations[lane]) {
+			finished.push_back(ids[lane]);
+		}
+	}
+
+	processing = false;
+	for (uint32_t lane = 0; lane < ids.size();) {
+		if (targets[lane].object.is_valid()) {
+			lane++;
+		} else {
+			_remove_lane(lane);
+		}
+	}
+
+	// Tweens killed after they were written don't report finishing.
+	LocalVector<uint32_t> completed;
+	for (const uint32_t id : finished) {
+		if (is_running(id)) {
+			completed.push_back(id);
+			kill(id);
+		}
+	}
+	for (const uint32_t id : completed) {
+		emit_signal(SNAME("finished"), id);
+	}
+}
+
+void TweenBatch::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("tween_property", "object", "property", "final_val", "duration", "trans", "ease", "delay"), &TweenBatch::tween_property, DEFVAL(Tween::TRANS_LINEAR), DEFVAL(Tween::EASE_IN_OUT), DEFVAL(0.0));
+	ClassDB::bind_method(D_METHOD("set_process_mode", "id", "mode"), &TweenBatch::set_process_mode);
+	ClassDB::bind_method(D_METHOD("set_pause_mode", "id", "mode"), &TweenBatch::set_pause_mode);
+	ClassDB::bind_method(D_METHOD("set_ignore_time_scale", "id", "ignore"), &TweenBatch::set_ignore_time_scale);
+	ClassDB::bind_method(D_METHOD("kill", "id"), &TweenBatch::kill);
+	ClassDB::bind_method(D_METHOD("kill_object", "object"), &TweenBatch::kill_object);
+	ClassDB::bind_method(D_METHOD("is_running", "id"), &TweenBatch::is_running);
+	ClassDB::bind_method(D_METHOD("get_running_count"), &TweenBatch::get_running_count);
+
+	ADD_SIGNAL(MethodInfo("finished", PropertyInfo(Variant::INT, "id")));
+}
+
+TweenBatch::TweenBatch() {
+	if (singleton == nullptr) {
+		singleton = this;
+	}
+}
+
+TweenBatch::~TweenBatch() {
+	if (singleton == this) {
+		singleton = nullptr;
+	}
+}
@@ -0,0 +1,96 @@
+/**************************************************************************/
+/*  tween_batch.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                            GOBLIN ENGINE                               */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/object.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "scene/animation/tween.h"
+
+class MethodBind;
+
+// Batched property tweens (`TweenBatch` singleton), stepped by `SceneTree::process_tweens()`.
+//
+// Meant for the many small fire-and-forget tweens of UI and juice effects: one property
+// of one object, going from its current value to a final `float`, `Vector2`, `Vector3` or
+// `Color` with a standard transition and easing. Running tweens are stored as a
+// struct-of-arrays, so a frame advances all clocks, evaluates the easings and
+// interpolates every component in flat passes, then writes each value back through the
+// property setter resolved when the tween was created (no `Object::set()` lookup).
+// Anything more (sequences, callbacks, loops, other types) stays with `Tween`.
+class TweenBatch : public Object {
+	GDCLASS(TweenBatch, Object);
+
+	static inline TweenBatch *singleton = nullptr;
+
+	enum {
+		COMPONENTS = 4,
+	};
+
+	// Per tween, read when writing back or changing settings.
+	struct Target {
+		ObjectID object;
+		NodePath property; // Property path, with subnames for `set_indexed()`.
+		MethodBind *setter = nullptr; // Cached ClassDB setter, or null to use `set_indexed()`.
+		Variant::Type type = Variant::NIL;
+		Tween::TweenProcessMode process_mode = Tween::TWEEN_PROCESS_IDLE;
+		Tween::TweenPauseMode pause_mode = Tween::TWEEN_PAUSE_BOUND;
+		bool ignore_time_scale = false;
+		bool started = false;
+	};
+
+	uint32_t next_id = 1;
+	bool processing = false;
+	HashMap<uint32_t, uint32_t> slots; // Id -> lane.
+
+	// Lanes, one per running tween.
+	LocalVector<uint32_t> ids;
+	LocalVector<Target> targets;
+	LocalVector<double> elapsed;
+	LocalVector<double> delays;
+	LocalVector<double> durations;
+	LocalVector<uint8_t> transitions;
+	LocalVector<uint8_t> eases;
+	LocalVector<uint8_t> active; // Scratch: advanced this frame.
+	LocalVector<double> weights; // Scratch: eased progress.
+	LocalVector<double> from[COMPONENTS];
+	LocalVector<double> change[COMPONENTS]; // Final value until the tween starts.
+	LocalVector<double> values[COMPONENTS]; // Scratch: interpolated components.
+
+	static bool _is_batchable_type(Variant::Type p_type);
+	static void _split(const Variant &p_value, double r_components[COMPONENTS]);
+	static Variant _join(Variant::Type p_type, const double p_components[COMPONENTS]);
+	static MethodBind *_find_setter(Object *p_object, const StringName &p_property);
+
+	void _remove_lane(uint32_t p_lane);
+	bool _start_lane(uint32_t p_lane, Object *p_object);
+	void _write_lane(uint32_t p_lane, Object *p_object);
+	Target *_get_target(int p_id);
+
+protected:
+	static void _bind_methods();
+
+public:
+	static TweenBatch *get_singleton() { return singleton; }
+
+	int tween_property(Object *p_object, const NodePath &p_property, const Variant &p_final_value, double p_duration, Tween::TransitionType p_trans = Tween::TRANS_LINEAR, Tween::EaseType p_ease = Tween::EASE_IN_OUT, double p_delay = 0.0);
+	void set_process_mode(int p_id, Tween::TweenProcessMode p_mode);
+	void set_pause_mode(int p_id, Tween::TweenPauseMode p_mode);
+	void set_ignore_time_scale(int p_id, bool p_ignore);
+
+	void kill(int p_id);
+	void kill_object(Object *p_object);
+	bool is_running(int p_id) const;
+	int get_running_count() const;
+
+	// Steps the tweens matching the frame type. Called by `SceneTree::process_tweens()`.
+	void process(double p_delta, double p_unscaled_delta, bool p_physics, bool p_tree_paused);
+
+	TweenBatch();
+	~TweenBatch();
+};